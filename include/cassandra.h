@@ -316,6 +316,40 @@ typedef struct CassSchemaMetaField_ CassSchemaMetaField;
  */
 typedef struct CassUuidGen_ CassUuidGen;
 
+/**
+ * @struct CassBulkLoader
+ *
+ * Groups statements into unlogged batches by the replicas that own
+ * their partition and executes those batches with a bounded concurrency.
+ */
+typedef struct CassBulkLoader_ CassBulkLoader;
+
+/**
+ * @struct CassIOThreadGroup
+ *
+ * A group of IO threads that's shared by sessions.
+ */
+typedef struct CassIOThreadGroup_ CassIOThreadGroup;
+
+/**
+ * The stages of a request's lifecycle that are timestamped for sampled
+ * requests.
+ *
+ * @see cass_cluster_set_request_timeline_sample_rate()
+ */
+typedef enum CassRequestStage_ {
+  CASS_REQUEST_STAGE_CREATED, /**< Queued for the session by the application thread */
+  CASS_REQUEST_STAGE_SESSION, /**< Dequeued by the session and queued for an IO worker */
+  CASS_REQUEST_STAGE_IO_WORKER, /**< Dequeued by the IO worker */
+  CASS_REQUEST_STAGE_CONNECTION, /**< Written to a connection (after waiting in the pool) */
+  CASS_REQUEST_STAGE_WRITTEN, /**< Written to the socket */
+  CASS_REQUEST_STAGE_RESPONSE, /**< Response received */
+  CASS_REQUEST_STAGE_COMPLETED, /**< Future set or error callback called */
+  /* @cond IGNORE */
+  CASS_REQUEST_STAGE_LAST_ENTRY
+  /* @endcond */
+} CassRequestStage;
+
 /**
  * @struct CassMetrics
  *
@@ -354,6 +388,95 @@ typedef struct CassMetrics_ {
 
 } CassMetrics;
 
+/**
+ * @struct CassExtendedMetrics
+ *
+ * A snapshot of the session's metrics that aren't part of CassMetrics.
+ *
+ * <b>Note:</b> CassMetrics is allocated by the application so its layout
+ * can't change. New metrics are only ever appended to this struct and
+ * its size is passed to cass_session_get_extended_metrics() so that
+ * applications built using an older version of this header are only given
+ * the fields that they know about.
+ */
+typedef struct CassExtendedMetrics_ {
+  struct {
+    cass_uint64_t expired_before_send; /**< Requests that timed out before they were sent */
+  } errors;
+
+  struct {
+    cass_uint64_t results; /**< Successful requests executed without a future */
+    cass_uint64_t errors; /**< Failed requests executed without a future */
+  } discarded;
+
+  struct {
+    cass_uint64_t min; /**< Minimum in microseconds */
+    cass_uint64_t max; /**< Maximum in microseconds */
+    cass_uint64_t mean; /**< Mean in microseconds */
+    cass_uint64_t stddev; /**< Standard deviation in microseconds */
+    cass_uint64_t median; /**< Median in microseconds */
+    cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+    cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+    cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+    cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+    cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+  } priority_requests[2]; /**< Request latencies indexed by CassRequestPriority */
+
+  struct {
+    cass_uint64_t min; /**< Minimum in microseconds */
+    cass_uint64_t max; /**< Maximum in microseconds */
+    cass_uint64_t mean; /**< Mean in microseconds */
+    cass_uint64_t stddev; /**< Standard deviation in microseconds */
+    cass_uint64_t median; /**< Median in microseconds */
+    cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+    cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+    cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+    cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+    cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+  } request_stages[CASS_REQUEST_STAGE_LAST_ENTRY]; /**< Time taken to reach each stage from the previous stage of sampled requests, indexed by CassRequestStage */
+
+  struct {
+    cass_uint64_t sampled; /**< Requests with a timeline */
+    cass_uint64_t dropped; /**< Timelines dropped because they weren't drained in time */
+  } request_timelines;
+
+  struct {
+    cass_uint64_t total; /**< Requests that took longer than the slow request threshold */
+    cass_uint64_t suppressed; /**< Slow requests that weren't reported because of sampling or the rate limit */
+  } slow_requests;
+
+} CassExtendedMetrics;
+
+/**
+ * @struct CassHostMetrics
+ *
+ * A snapshot of the performance/diagnostic metrics of a single host.
+ */
+typedef struct CassHostMetrics_ {
+  CassInet address; /**< The host's address */
+  int port; /**< The host's port */
+
+  struct {
+    cass_uint64_t min; /**< Minimum in microseconds */
+    cass_uint64_t max; /**< Maximum in microseconds */
+    cass_uint64_t mean; /**< Mean in microseconds */
+    cass_uint64_t stddev; /**< Standard deviation in microseconds */
+    cass_uint64_t median; /**< Median in microseconds */
+    cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+    cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+    cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+    cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+    cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+  } requests; /**< Request latencies, 0 unless enabled using cass_cluster_set_host_latency_histograms() */
+
+  cass_int64_t in_flight_requests; /**< Requests written to the host's connections that are waiting for a response (streams in use) */
+  cass_int64_t pending_requests; /**< Requests waiting in the host's pools for a connection */
+  cass_uint64_t request_timeouts; /**< Occurrences of requests that timed out waiting for the host */
+  cass_uint64_t errors; /**< Error responses and write errors */
+  cass_uint64_t bytes_written; /**< Bytes of requests written to the host */
+  cass_uint64_t bytes_read; /**< Bytes read from the host */
+} CassHostMetrics;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_ANY          = 0x0000,
   CASS_CONSISTENCY_ONE          = 0x0001,
@@ -404,13 +527,24 @@ typedef enum CassBatchType_ {
   CASS_BATCH_TYPE_COUNTER  = 2
 } CassBatchType;
 
+typedef enum CassRequestPriority_ {
+  CASS_REQUEST_PRIORITY_NORMAL = 0,
+  CASS_REQUEST_PRIORITY_HIGH   = 1
+} CassRequestPriority;
+
+typedef enum CassMetricsFormat_ {
+  CASS_METRICS_FORMAT_PROMETHEUS,
+  CASS_METRICS_FORMAT_JSON
+} CassMetricsFormat;
+
 typedef enum CassIteratorType_ {
   CASS_ITERATOR_TYPE_RESULT,
   CASS_ITERATOR_TYPE_ROW,
   CASS_ITERATOR_TYPE_COLLECTION,
   CASS_ITERATOR_TYPE_MAP,
   CASS_ITERATOR_TYPE_SCHEMA_META,
-  CASS_ITERATOR_TYPE_SCHEMA_META_FIELD
+  CASS_ITERATOR_TYPE_SCHEMA_META_FIELD,
+  CASS_ITERATOR_TYPE_HOST_METRICS
 } CassIteratorType;
 
 typedef enum CassSchemaMetaType_ {
@@ -475,6 +609,8 @@ typedef enum  CassErrorSource_ {
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NOT_IMPLEMENTED, 21, "Not implemented") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_UNABLE_TO_CONNECT, 22, "Unable to connect") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_UNABLE_TO_CLOSE, 23, "Unable to close") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_REQUEST_CANCELLED, 24, "Request cancelled") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_BUFFER_TOO_SMALL, 25, "Buffer too small") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_SERVER_ERROR, 0x0000, "Server error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_PROTOCOL_ERROR, 0x000A, "Protocol error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_BAD_CREDENTIALS, 0x0100, "Bad credentials") \
@@ -508,6 +644,44 @@ typedef enum CassError_ {
   /* @endcond*/
 } CassError;
 
+/**
+ * @struct CassRequestTimeline
+ *
+ * The timestamps of a sampled request's lifecycle.
+ *
+ * @see cass_session_drain_request_timelines()
+ */
+typedef struct CassRequestTimeline_ {
+  cass_uint64_t timestamps[CASS_REQUEST_STAGE_LAST_ENTRY]; /**< Monotonic timestamps in nanoseconds indexed by CassRequestStage, 0 for stages that weren't reached */
+  CassRequestPriority priority; /**< The request's priority */
+  CassError error; /**< CASS_OK or the request's error */
+} CassRequestTimeline;
+
+/**
+ * @struct CassSlowRequest
+ *
+ * The context of a request that took longer than the slow request threshold.
+ * The strings and bytes are only valid for the duration of the callback.
+ *
+ * @see cass_cluster_set_slow_request_callback()
+ */
+typedef struct CassSlowRequest_ {
+  cass_uint64_t latency; /**< Microseconds from when the request was executed until it finished */
+  const char* query; /**< The query, the prepared statement's query or the queries of a batch separated by "; " */
+  size_t query_length; /**< The length of the query */
+  const cass_byte_t* routing_key; /**< The routing key or NULL if the request doesn't have one */
+  size_t routing_key_size; /**< The size of the routing key */
+  cass_int64_t token; /**< The token of the routing key, only valid if has_token is cass_true */
+  cass_bool_t has_token; /**< cass_true if the request has a routing key and the cluster uses the Murmur3Partitioner. The tokens of other partitioners don't fit in 64 bits. */
+  const char* hosts; /**< The addresses of the hosts that the request was sent to in order, separated by "," */
+  size_t hosts_length; /**< The length of the hosts */
+  unsigned retries; /**< The number of times the request was retried */
+  cass_uint64_t stage_latencies[CASS_REQUEST_STAGE_LAST_ENTRY]; /**< Microseconds taken to reach each stage from the previous stage, indexed by CassRequestStage. Only set for requests with a sampled timeline. */
+  size_t response_size; /**< The size in bytes of the response body, 0 if there is no response */
+  CassRequestPriority priority; /**< The request's priority */
+  CassError error; /**< CASS_OK or the request's error */
+} CassSlowRequest;
+
 /**
  * A callback that's notified when the future is set.
  *
@@ -520,6 +694,70 @@ typedef enum CassError_ {
 typedef void (*CassFutureCallback)(CassFuture* future,
                                    void* data);
 
+/**
+ * A callback that's notified when a request executed without a future
+ * fails. It's called on one of the session's I/O threads and must not block.
+ *
+ * @param[in] code
+ * @param[in] message
+ * @param[in] message_length
+ * @param[in] data user defined data provided when the request
+ * was executed.
+ *
+ * @see cass_session_execute_discard()
+ * @see cass_session_execute_batch_discard()
+ */
+typedef void (*CassRequestErrorCallback)(CassError code,
+                                         const char* message,
+                                         size_t message_length,
+                                         void* data);
+
+/**
+ * A callback that's notified of requests that took longer than the slow
+ * request threshold. It's called on one of the session's I/O threads and must
+ * not block.
+ *
+ * @param[in] request the slow request, it's only valid for the duration
+ * of the callback.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_cluster_set_slow_request_callback()
+ */
+typedef void (*CassSlowRequestCallback)(const CassSlowRequest* request,
+                                        void* data);
+
+/**
+ * A callback that's notified when the memory of a value that was bound
+ * without being copied is no longer used by the driver.
+ *
+ * @param[in] data user defined data provided when the value was bound.
+ *
+ * @see cass_statement_bind_bytes_no_copy()
+ * @see cass_statement_bind_string_no_copy()
+ */
+typedef void (*CassValueReleaseCallback)(void* data);
+
+/**
+ * A callback that's notified for each statement of a bulk loader's batch
+ * that failed. It's called on one of the driver's threads and must not block.
+ *
+ * @param[in] statement the failed statement, it's only valid for the duration
+ * of the callback.
+ * @param[in] code
+ * @param[in] message
+ * @param[in] message_length
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_bulk_loader_set_error_callback()
+ */
+typedef void (*CassBulkLoaderErrorCallback)(const CassStatement* statement,
+                                            CassError code,
+                                            const char* message,
+                                            size_t message_length,
+                                            void* data);
+
 /**
  * Maximum size of a log message
  */
@@ -540,6 +778,18 @@ typedef struct CassLogMessage_ {
   char message[CASS_LOG_MAX_MESSAGE_SIZE]; /**< The message */
 } CassLogMessage;
 
+/**
+ * @struct CassLogStats
+ *
+ * The number of log messages that weren't delivered to the log callback.
+ *
+ * @see cass_log_get_stats()
+ */
+typedef struct CassLogStats_ {
+  cass_uint64_t dropped; /**< Messages dropped because the asynchronous log queue was full */
+  cass_uint64_t rate_limited; /**< Messages dropped because of the rate limit */
+} CassLogStats;
+
 /**
  * A callback that's used to handle logging.
  *
@@ -648,6 +898,26 @@ CASS_EXPORT void
 cass_cluster_set_ssl(CassCluster* cluster,
                      CassSsl* ssl);
 
+/**
+ * Sets an IO thread group that's shared with other sessions. The sessions
+ * connected using this cluster run their requests on the group's threads
+ * instead of creating their own IO threads and the number of IO threads
+ * set by cass_cluster_set_num_threads_io() is ignored. Each session still
+ * has its own connections.
+ *
+ * Default: NULL (each session creates its own IO threads)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] group
+ *
+ * @see cass_io_thread_group_new()
+ */
+CASS_EXPORT void
+cass_cluster_set_io_thread_group(CassCluster* cluster,
+                                 CassIOThreadGroup* group);
+
 /**
  * Sets the protocol version. This will automatically downgrade if to
  * protocol version 1.
@@ -1125,6 +1395,263 @@ cass_cluster_set_tcp_keepalive(CassCluster* cluster,
                                cass_bool_t enabled,
                                unsigned delay_secs);
 
+/**
+ * Enable/Disable deferred decoding of result rows. When enabled the IO threads
+ * only frame the response and the result's metadata and rows are decoded
+ * by the thread that retrieves the result using cass_future_get_result().
+ * This keeps large result pages from delaying other requests on the
+ * same IO thread.
+ *
+ * Default: cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ */
+CASS_EXPORT void
+cass_cluster_set_deferred_result_decoding(CassCluster* cluster,
+                                          cass_bool_t enabled);
+
+/**
+ * Enable/Disable preparing the session's previously prepared statements on
+ * hosts when they're added or come back up. This avoids an extra round trip
+ * to prepare the statement the first time it's executed on a restarted host.
+ * Only statements prepared using the session's current keyspace
+ * are prepared.
+ *
+ * Default: cass_true (enabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ */
+CASS_EXPORT void
+cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
+                                           cass_bool_t enabled);
+
+/**
+ * Sets the maximum number of prepared statements that are cached by the
+ * session. The least recently used statements are removed once the cache is
+ * full. The cached statements are prepared on hosts that are added or come
+ * back up and used by automatic preparation.
+ *
+ * Default: 1000
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] size The number of statements, or 0 to disable the cache (and
+ * automatic preparation).
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ * @see cass_cluster_set_auto_prepare_threshold()
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_cache_size(CassCluster* cluster,
+                                     unsigned size);
+
+/**
+ * Sets the number of times a simple statement's query is executed before it's
+ * prepared automatically. The query is prepared in the background and later
+ * executions of statements with the same query are sent as prepared statements
+ * without result metadata. Statements that are paging (with a paging state)
+ * or batched are always sent as queries.
+ *
+ * Default: 0 (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] threshold The number of executions, or 0 to disable.
+ */
+CASS_EXPORT void
+cass_cluster_set_auto_prepare_threshold(CassCluster* cluster,
+                                        unsigned threshold);
+
+/**
+ * Sets the number of high priority requests that are started by an
+ * IO thread for each normal priority request when both are queued.
+ *
+ * Default: 4
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] weight
+ *
+ * @see cass_statement_set_priority()
+ */
+CASS_EXPORT void
+cass_cluster_set_high_priority_weight(CassCluster* cluster,
+                                      unsigned weight);
+
+/**
+ * Sets the number of streams on each connection that are reserved for
+ * high priority requests. Normal priority requests wait for a connection
+ * instead of using the connection's last streams.
+ *
+ * Default: 0 (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] num_streams Must be less than the number of streams of
+ * a connection (128).
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_priority()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_reserved_high_priority_streams(CassCluster* cluster,
+                                                unsigned num_streams);
+
+/**
+ * Sets the rate at which requests are sampled to record the timestamps of
+ * their lifecycle's stages. One in every "sample_rate" requests is sampled.
+ * Sampled timelines are kept by the IO workers until they're drained and the
+ * time taken by each stage is recorded in the session's metrics.
+ *
+ * Default: 0 (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] sample_rate
+ *
+ * @see cass_session_drain_request_timelines()
+ */
+CASS_EXPORT void
+cass_cluster_set_request_timeline_sample_rate(CassCluster* cluster,
+                                              unsigned sample_rate);
+
+/**
+ * Sets the number of sampled request timelines that each IO worker keeps
+ * until they're drained. Timelines are dropped when it's full.
+ *
+ * Default: 1024
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] num_timelines
+ *
+ * @see cass_cluster_set_request_timeline_sample_rate()
+ */
+CASS_EXPORT void
+cass_cluster_set_request_timeline_buffer_size(CassCluster* cluster,
+                                              unsigned num_timelines);
+
+/**
+ * Sets the threshold for slow requests. Requests that take longer than the
+ * threshold from when they're executed until they're finished are reported
+ * with their query, routing key, the hosts that were tried, their number of
+ * retries, the time taken by each stage (for requests with a sampled
+ * timeline) and their response size.
+ *
+ * Default: 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] threshold_ms
+ *
+ * @see cass_cluster_set_slow_request_sampling()
+ * @see cass_cluster_set_slow_request_callback()
+ */
+CASS_EXPORT void
+cass_cluster_set_slow_request_threshold(CassCluster* cluster,
+                                        unsigned threshold_ms);
+
+/**
+ * Sets how often slow requests are reported. One in every "sample_rate"
+ * slow requests is reported and no more than "max_per_second" are reported
+ * each second. The others are only counted in the session's metrics.
+ *
+ * Default: 1 (every slow request) and 10 per second. A "max_per_second"
+ * of 0 disables the rate limit.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] sample_rate
+ * @param[in] max_per_second
+ *
+ * @see cass_cluster_set_slow_request_threshold()
+ */
+CASS_EXPORT void
+cass_cluster_set_slow_request_sampling(CassCluster* cluster,
+                                       unsigned sample_rate,
+                                       unsigned max_per_second);
+
+/**
+ * Sets a callback that's notified of slow requests. Slow requests are logged
+ * as warnings if there is no callback.
+ *
+ * Default: NULL
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] callback
+ * @param[in] data
+ *
+ * @see cass_cluster_set_slow_request_threshold()
+ */
+CASS_EXPORT void
+cass_cluster_set_slow_request_callback(CassCluster* cluster,
+                                       CassSlowRequestCallback callback,
+                                       void* data);
+
+/**
+ * Sets the range and precision of the latency histograms in the session's
+ * metrics. Latencies above the highest trackable latency are recorded as the
+ * highest trackable latency. Each additional significant figure increases the
+ * memory used by each histogram roughly tenfold.
+ *
+ * Default: 3600000000 microseconds (one hour) and 3 significant figures
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] highest_latency_us The highest trackable latency in microseconds
+ * @param[in] significant_figures The number of significant figures (1 to 5)
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_metrics()
+ * @see cass_session_get_interval_metrics()
+ * @see cass_session_get_extended_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_latency_histogram_range(CassCluster* cluster,
+                                         cass_uint64_t highest_latency_us,
+                                         unsigned significant_figures);
+
+/**
+ * Enable/Disable the request latency histogram of each host's metrics.
+ *
+ * <b>Note:</b> Each host's histogram keeps a cumulative and an interval
+ * copy, and two copies for each thread that records latencies (the IO
+ * threads and one more). Using the default histogram range a copy is about
+ * 190 KB, which is about 1.1 MB for each host with one IO thread and
+ * 2.2 MB with four. Use cass_cluster_set_latency_histogram_range() to
+ * reduce the size of the histograms.
+ *
+ * Default: cass_false (disabled). The other per-host metrics are always
+ * recorded.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_session_get_host_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_host_latency_histograms(CassCluster* cluster,
+                                         cass_bool_t enabled);
+
 /***********************************************************************************
  *
  * Session
@@ -1223,7 +1750,11 @@ CASS_EXPORT CassFuture*
 cass_session_close(CassSession* session);
 
 /**
- * Create a prepared statement.
+ * Create a prepared statement. Statements that were already prepared using
+ * the session's current keyspace are returned from the session's prepared
+ * cache without a request. Cached statements are removed when their table
+ * is altered or dropped so that preparing the query again returns the
+ * current result metadata.
  *
  * @public @memberof CassSession
  *
@@ -1233,6 +1764,7 @@ cass_session_close(CassSession* session);
  * @return A future that must be freed.
  *
  * @see cass_future_get_prepared()
+ * @see cass_cluster_set_prepared_cache_size()
  */
 CASS_EXPORT CassFuture*
 cass_session_prepare(CassSession* session,
@@ -1286,6 +1818,55 @@ CASS_EXPORT CassFuture*
 cass_session_execute_batch(CassSession* session,
                            const CassBatch* batch);
 
+/**
+ * Execute a query or bound statement without a future. The rows
+ * of a successful request are discarded without being decoded and
+ * errors are only reported using the optional callback. The number
+ * of discarded results and errors are available in CassExtendedMetrics.
+ *
+ * <b>Note:</b> This is intended for statements that don't return
+ * results (e.g. INSERT, UPDATE and DELETE). The results of
+ * "USE <keyspace>" and schema change statements are still decoded
+ * so that the keyspace change is applied to all connections and the
+ * driver waits for schema agreement.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @param[in] callback Called when the request fails. Can be NULL.
+ * @param[in] data
+ * @return CASS_OK if the request was queued, otherwise
+ * CASS_ERROR_LIB_REQUEST_QUEUE_FULL (the callback is not called).
+ *
+ * @see cass_session_get_extended_metrics()
+ */
+CASS_EXPORT CassError
+cass_session_execute_discard(CassSession* session,
+                             const CassStatement* statement,
+                             CassRequestErrorCallback callback,
+                             void* data);
+
+/**
+ * Execute a batch statement without a future.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] batch
+ * @param[in] callback Called when the request fails. Can be NULL.
+ * @param[in] data
+ * @return CASS_OK if the request was queued, otherwise
+ * CASS_ERROR_LIB_REQUEST_QUEUE_FULL (the callback is not called).
+ *
+ * @see cass_session_execute_discard()
+ */
+CASS_EXPORT CassError
+cass_session_execute_batch_discard(CassSession* session,
+                                   const CassBatch* batch,
+                                   CassRequestErrorCallback callback,
+                                   void* data);
+
 /**
  * Gets a copy of this session's schema metadata. The returned
  * copy of the schema metadata is not updated. This function
@@ -1316,6 +1897,130 @@ CASS_EXPORT void
 cass_session_get_metrics(CassSession* session,
                          CassMetrics* output);
 
+/**
+ * Gets a copy of this session's performance/diagnostic metrics where the
+ * request latency histogram only covers the requests that finished since
+ * the previous call to this function. The counters and rates are the same
+ * as the ones returned by cass_session_get_metrics().
+ *
+ * <b>Note:</b> Each call starts a new interval so the intervals should only
+ * be consumed by a single reader.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_session_get_metrics()
+ * @see cass_cluster_set_latency_histogram_range()
+ */
+CASS_EXPORT void
+cass_session_get_interval_metrics(CassSession* session,
+                                  CassMetrics* output);
+
+/**
+ * Gets a copy of this session's metrics that aren't part of CassMetrics.
+ *
+ * Only the first output_size bytes of the struct are written.
+ *
+ * Example:
+ * @code{.c}
+ * CassExtendedMetrics metrics;
+ * cass_session_get_extended_metrics(session, &metrics, sizeof(metrics));
+ * @endcode
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ * @param[in] output_size The size of the output, sizeof(CassExtendedMetrics)
+ *
+ * @see cass_session_get_metrics()
+ */
+CASS_EXPORT void
+cass_session_get_extended_metrics(CassSession* session,
+                                  CassExtendedMetrics* output,
+                                  size_t output_size);
+
+/**
+ * Same as cass_session_get_extended_metrics(), but the latency histograms
+ * (priority_requests and request_stages) only cover the requests that
+ * finished since the previous call to this function. Their intervals are
+ * separate from the interval of cass_session_get_interval_metrics().
+ *
+ * <b>Note:</b> Each call starts a new interval so the intervals should only
+ * be consumed by a single reader.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ * @param[in] output_size The size of the output, sizeof(CassExtendedMetrics)
+ *
+ * @see cass_session_get_extended_metrics()
+ * @see cass_session_get_interval_metrics()
+ */
+CASS_EXPORT void
+cass_session_get_interval_extended_metrics(CassSession* session,
+                                           CassExtendedMetrics* output,
+                                           size_t output_size);
+
+/**
+ * Gets an iterator over a copy of the performance/diagnostic metrics
+ * of each of this session's hosts.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A new iterator that must be freed.
+ *
+ * @see cass_iterator_get_host_metrics()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_session_get_host_metrics(CassSession* session);
+
+/**
+ * Serializes this session's performance/diagnostic metrics, including the
+ * metrics of each host and IO worker, into a buffer as Prometheus exposition
+ * text or as JSON. Histograms include their percentiles and cumulative
+ * buckets. All latencies are in microseconds.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] format
+ * @param[out] output The NULL terminated output. Can be NULL to determine
+ * the required size.
+ * @param[in,out] output_size The size of the output buffer. It's set to the
+ * size of the output including the NULL terminator.
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BUFFER_TOO_SMALL
+ * if the output doesn't fit and nothing was written.
+ */
+CASS_EXPORT CassError
+cass_session_export_metrics(CassSession* session,
+                            CassMetricsFormat format,
+                            char* output,
+                            size_t* output_size);
+
+/**
+ * Copies and removes the timelines of the sampled requests that have
+ * completed.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ * @param[in] count The maximum number of timelines to copy.
+ * @return The number of timelines copied.
+ *
+ * @see cass_cluster_set_request_timeline_sample_rate()
+ */
+CASS_EXPORT size_t
+cass_session_drain_request_timelines(CassSession* session,
+                                     CassRequestTimeline* output,
+                                     size_t count);
+
 /***********************************************************************************
  *
  * Schema metadata
@@ -1617,14 +2322,47 @@ cass_ssl_set_private_key(CassSsl* ssl,
  * @param[in] password_length
  * @return same as cass_ssl_set_private_key()
  *
- * @see cass_ssl_set_private_key()
+ * @see cass_ssl_set_private_key()
+ */
+CASS_EXPORT CassError
+cass_ssl_set_private_key_n(CassSsl* ssl,
+                           const char* key,
+                           size_t key_length,
+                           const char* password,
+                           size_t password_length);
+
+/***********************************************************************************
+ *
+ * IO thread group
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new group of IO threads that can be shared by several sessions
+ * using cass_cluster_set_io_thread_group(). The threads are started when the
+ * first session using the group connects. Sessions must not be connected
+ * from one of the group's threads (e.g. in a request error callback).
+ *
+ * @public @memberof CassIOThreadGroup
+ *
+ * @param[in] thread_count The number of IO threads
+ * @return Returns an IO thread group that must be freed. The threads are
+ * stopped once the group and all the sessions using it are freed.
+ *
+ * @see cass_io_thread_group_free()
+ */
+CASS_EXPORT CassIOThreadGroup*
+cass_io_thread_group_new(unsigned thread_count);
+
+/**
+ * Frees an IO thread group instance.
+ *
+ * @public @memberof CassIOThreadGroup
+ *
+ * @param[in] group
  */
-CASS_EXPORT CassError
-cass_ssl_set_private_key_n(CassSsl* ssl,
-                           const char* key,
-                           size_t key_length,
-                           const char* password,
-                           size_t password_length);
+CASS_EXPORT void
+cass_io_thread_group_free(CassIOThreadGroup* group);
 
 /***********************************************************************************
  *
@@ -1692,6 +2430,25 @@ CASS_EXPORT cass_bool_t
 cass_future_wait_timed(CassFuture* future,
                        cass_duration_t timeout_us);
 
+/**
+ * Cancels the request of a future returned by cass_session_execute(),
+ * cass_session_execute_batch() or cass_session_prepare(). The future is
+ * set with the error CASS_ERROR_LIB_REQUEST_CANCELLED and its callback
+ * is run on the calling thread. A request that's still queued is dropped
+ * without being sent. A request that's already been sent can't be
+ * recalled, but its rows are discarded without being decoded. The
+ * results of "USE <keyspace>" and schema change statements are still
+ * applied.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @return true if the request was cancelled; false if the future was
+ * already set or it's not a request future.
+ */
+CASS_EXPORT cass_bool_t
+cass_future_cancel(CassFuture* future);
+
 /**
  * Gets the result of a successful future. If the future is not ready this method will
  * wait for the future to be set. The first successful call consumes the future, all
@@ -1805,6 +2562,23 @@ cass_statement_new_n(const char* query,
 CASS_EXPORT void
 cass_statement_free(CassStatement* statement);
 
+/**
+ * Unbinds all the values of a statement so that it can be reused for
+ * another execution without being freed. The memory used for the values
+ * is kept for the following binds.
+ *
+ * <b>Note:</b> A statement must not be reset until the future of its
+ * previous execution is set or while it's part of a batch that's still
+ * being used.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_reset(CassStatement* statement);
+
 /**
  * Adds a key index specifier to this a statement.
  * When using token-aware routing, this can be used to tell the driver which
@@ -1891,6 +2665,46 @@ CASS_EXPORT CassError
 cass_statement_set_serial_consistency(CassStatement* statement,
                                       CassConsistency serial_consistency);
 
+/**
+ * Sets the statement's timeout. Unlike the cluster's request timeout it
+ * starts when the statement is executed, so it includes the time spent
+ * waiting to be sent. Statements that time out before they're sent are
+ * never sent and retries only use what's left of the timeout.
+ *
+ * Default: 0 (Use the cluster's request timeout once the statement is sent)
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] timeout_ms
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_request_timeout()
+ */
+CASS_EXPORT CassError
+cass_statement_set_request_timeout(CassStatement* statement,
+                                   cass_uint64_t timeout_ms);
+
+/**
+ * Sets the statement's priority. High priority requests are started ahead
+ * of queued normal priority requests and can use the streams reserved
+ * for them.
+ *
+ * Default: CASS_REQUEST_PRIORITY_NORMAL
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_high_priority_weight()
+ * @see cass_cluster_set_reserved_high_priority_streams()
+ */
+CASS_EXPORT CassError
+cass_statement_set_priority(CassStatement* statement,
+                            CassRequestPriority priority);
+
 /**
  * Sets the statement's page size.
  *
@@ -2063,6 +2877,64 @@ cass_statement_bind_bytes(CassStatement* statement,
                           const cass_byte_t* value,
                           size_t value_size);
 
+/**
+ * Binds a "blob" or "varint" to a query or bound statement at the specified
+ * index without copying it. The value is written to the socket straight from
+ * the memory pointed to by the value parameter.
+ *
+ * The memory must not be modified or freed until the callback is called.
+ * That happens once the statement no longer references the value (it's
+ * freed, reset or the value is bound again) and all the writes of requests
+ * that used it have completed or failed. The callback can be called on
+ * the application's thread or on one of the session's I/O threads. If an
+ * error is returned the callback is never called.
+ *
+ * <b>Note:</b> For SSL connections the value is still copied when it's
+ * encrypted.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] callback Called when the memory is no longer used. Can be NULL.
+ * @param[in] data
+ * @return CASS_OK if successful, CASS_ERROR_LIB_BAD_PARAMS if the value is
+ * larger than 2^31 - 1 bytes, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_no_copy(CassStatement* statement,
+                                  size_t index,
+                                  const cass_byte_t* value,
+                                  size_t value_size,
+                                  CassValueReleaseCallback callback,
+                                  void* data);
+
+/**
+ * Same as cass_statement_bind_bytes_no_copy(), but for "ascii", "text" and
+ * "varchar" values.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value
+ * @param[in] value_length
+ * @param[in] callback Called when the memory is no longer used. Can be NULL.
+ * @param[in] data
+ * @return same as cass_statement_bind_bytes_no_copy()
+ *
+ * @see cass_statement_bind_bytes_no_copy()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_string_no_copy(CassStatement* statement,
+                                   size_t index,
+                                   const char* value,
+                                   size_t value_length,
+                                   CassValueReleaseCallback callback,
+                                   void* data);
+
 /**
  * Binds a "uuid" or "timeuuid" to a query or bound statement at the specified index.
  *
@@ -2740,6 +3612,40 @@ CASS_EXPORT CassError
 cass_batch_set_consistency(CassBatch* batch,
                            CassConsistency consistency);
 
+/**
+ * Sets the batch's timeout.
+ *
+ * Default: 0 (Use the cluster's request timeout once the batch is sent)
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] timeout_ms
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_request_timeout()
+ */
+CASS_EXPORT CassError
+cass_batch_set_request_timeout(CassBatch* batch,
+                               cass_uint64_t timeout_ms);
+
+/**
+ * Sets the batch's priority.
+ *
+ * Default: CASS_REQUEST_PRIORITY_NORMAL
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] priority
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_priority()
+ */
+CASS_EXPORT CassError
+cass_batch_set_priority(CassBatch* batch,
+                        CassRequestPriority priority);
+
 /**
  * Adds a statement to a batch.
  *
@@ -2754,6 +3660,161 @@ cass_batch_add_statement(CassBatch* batch,
                          CassStatement* statement);
 
 
+/***********************************************************************************
+ *
+ * Bulk loader
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new bulk loader for a session. Statements added to the loader
+ * are grouped by the replicas of their routing key (and keyspace) into
+ * unlogged batches. A batch is executed once it reaches the maximum number of
+ * statements or the maximum size. Batches are routed using the routing key of
+ * their first statement so token aware routing should be enabled
+ * (the default) to send them directly to one of their replicas.
+ *
+ * Statements without a routing key are batched together.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] session a connected session that must outlive the loader.
+ * @return Returns a bulk loader that must be freed.
+ *
+ * @see cass_bulk_loader_free()
+ */
+CASS_EXPORT CassBulkLoader*
+cass_bulk_loader_new(CassSession* session);
+
+/**
+ * Frees a bulk loader instance. Any remaining statements are executed and
+ * this waits for all of the loader's batches to finish.
+ *
+ * Important: Do not free a loader in a future callback. Freeing a loader in
+ * a future callback will cause a deadlock.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ */
+CASS_EXPORT void
+cass_bulk_loader_free(CassBulkLoader* loader);
+
+/**
+ * Sets the maximum number of statements in a batch.
+ *
+ * <b>Default:</b> 100
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] max_statements
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_max_batch_statements(CassBulkLoader* loader,
+                                          unsigned max_statements);
+
+/**
+ * Sets the maximum size of a batch's statements and values in bytes.
+ * A batch is executed before a statement that would make it larger than
+ * this is added. A statement that's larger than this is executed in a batch
+ * of its own.
+ *
+ * <b>Default:</b> 5120 (5 KB, Cassandra's default batch size warning threshold)
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] max_size
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_max_batch_size(CassBulkLoader* loader,
+                                    size_t max_size);
+
+/**
+ * Sets the maximum number of batches that are executing at the same time.
+ * Adding a statement blocks while this many batches are executing.
+ *
+ * <b>Default:</b> 64
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] max_concurrent_batches
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_max_concurrent_batches(CassBulkLoader* loader,
+                                            unsigned max_concurrent_batches);
+
+/**
+ * Sets the consistency of the loader's batches.
+ *
+ * <b>Default:</b> CASS_CONSISTENCY_ONE
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] consistency
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_consistency(CassBulkLoader* loader,
+                                 CassConsistency consistency);
+
+/**
+ * Sets a callback that's called for each statement of a failed batch.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] callback
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_error_callback(CassBulkLoader* loader,
+                                    CassBulkLoaderErrorCallback callback,
+                                    void* data);
+
+/**
+ * Adds a statement to the loader. The statement can be freed after this
+ * call but it must not be modified. This blocks while the maximum number of concurrent batches
+ * are executing.
+ *
+ * Important: Do not add statements in a future callback. Adding a statement
+ * in a future callback can cause a deadlock.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] statement
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_bulk_loader_set_max_concurrent_batches()
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_add(CassBulkLoader* loader,
+                     CassStatement* statement);
+
+/**
+ * Executes the remaining statements and waits for all of the loader's
+ * batches to finish.
+ *
+ * Important: Do not flush a loader in a future callback. Flushing a loader
+ * in a future callback will cause a deadlock.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @return CASS_OK if all batches since the previous flush succeeded,
+ * otherwise the error code of the last failed batch.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_flush(CassBulkLoader* loader);
+
 /***********************************************************************************
  *
  * Collection
@@ -3292,6 +4353,22 @@ cass_iterator_get_schema_meta(CassIterator* iterator);
 CASS_EXPORT const CassSchemaMetaField*
 cass_iterator_get_schema_meta_field(CassIterator* iterator);
 
+/**
+ * Gets the metrics of the host at the iterator's current
+ * position.
+ *
+ * @public @memberof CassIterator
+ *
+ * @param[in] iterator
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_host_metrics()
+ */
+CASS_EXPORT CassError
+cass_iterator_get_host_metrics(CassIterator* iterator,
+                               CassHostMetrics* output);
+
 
 
 
@@ -3494,6 +4571,82 @@ cass_value_get_decimal(const CassValue* value,
                        size_t* varint_size,
                        cass_int32_t* scale);
 
+/**
+ * Gets all the items of a list or set of ints. This is faster than
+ * iterating over the collection for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * items.
+ * @param[in] output_count The number of items the output array can hold.
+ * @return CASS_OK if successful, otherwise error occurred
+ *
+ * @see cass_value_item_count()
+ */
+CASS_EXPORT CassError
+cass_value_get_collection_int32(const CassValue* collection,
+                                cass_int32_t* output,
+                                size_t output_count);
+
+/**
+ * Gets all the items of a list or set of bigints, counters or timestamps.
+ * This is faster than iterating over the collection for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * items.
+ * @param[in] output_count The number of items the output array can hold.
+ * @return CASS_OK if successful, otherwise error occurred
+ *
+ * @see cass_value_item_count()
+ */
+CASS_EXPORT CassError
+cass_value_get_collection_int64(const CassValue* collection,
+                                cass_int64_t* output,
+                                size_t output_count);
+
+/**
+ * Gets all the items of a list or set of floats. This is faster than
+ * iterating over the collection for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * items.
+ * @param[in] output_count The number of items the output array can hold.
+ * @return CASS_OK if successful, otherwise error occurred
+ *
+ * @see cass_value_item_count()
+ */
+CASS_EXPORT CassError
+cass_value_get_collection_float(const CassValue* collection,
+                                cass_float_t* output,
+                                size_t output_count);
+
+/**
+ * Gets all the items of a list or set of doubles. This is faster than
+ * iterating over the collection for large collections.
+ *
+ * @public @memberof CassValue
+ *
+ * @param[in] collection
+ * @param[out] output An array with room for at least cass_value_item_count()
+ * items.
+ * @param[in] output_count The number of items the output array can hold.
+ * @return CASS_OK if successful, otherwise error occurred
+ *
+ * @see cass_value_item_count()
+ */
+CASS_EXPORT CassError
+cass_value_get_collection_double(const CassValue* collection,
+                                 cass_double_t* output,
+                                 size_t output_count);
+
 /**
  * Gets the type of the specified value.
  *
@@ -3829,6 +4982,56 @@ cass_log_set_callback(CassLogCallback callback,
 CASS_EXPORT void
 CASS_DEPRECATED(cass_log_set_queue_size(size_t queue_size));
 
+/**
+ * Starts delivering log messages to the log callback on a background
+ * thread. Messages are formatted by the logging thread and queued, so a slow
+ * callback doesn't block the driver's threads. Messages are dropped when the
+ * queue is full.
+ *
+ * <b>Note:</b>: This needs to be done before any call that might log, such as
+ * any of the cass_cluster_*() or cass_ssl_*() functions.
+ *
+ * @param[in] queue_size The maximum number of queued messages.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_log_stop_async()
+ * @see cass_log_get_stats()
+ */
+CASS_EXPORT CassError
+cass_log_start_async(size_t queue_size);
+
+/**
+ * Delivers the queued log messages and stops the background thread started
+ * by cass_log_start_async(). Log messages are delivered on the logging thread
+ * afterwards.
+ *
+ * <b>Note:</b>: This must not be called while sessions are running.
+ */
+CASS_EXPORT void
+cass_log_stop_async();
+
+/**
+ * Limits the number of log messages that are logged each second from the
+ * same place in the driver. Messages over the limit are dropped before
+ * they're formatted.
+ *
+ * Default: 0 (disabled)
+ *
+ * @param[in] max_per_second
+ *
+ * @see cass_log_get_stats()
+ */
+CASS_EXPORT void
+cass_log_set_rate_limit(unsigned max_per_second);
+
+/**
+ * Gets the number of log messages that were dropped.
+ *
+ * @param[out] stats
+ */
+CASS_EXPORT void
+cass_log_get_stats(CassLogStats* stats);
+
 /**
  * Gets the string for a log level.
  *
@@ -56,6 +56,8 @@ public:
 
   bool dequeue(typename Q::EntryType& data) { return queue_.dequeue(data); }
 
+  size_t size() const { return queue_.size(); }
+
   // Testing only
   bool is_empty() const { return queue_.is_empty(); }
 
@@ -40,6 +40,22 @@ CassError cass_batch_set_consistency(CassBatch* batch,
   return CASS_OK;
 }
 
+CassError cass_batch_set_request_timeout(CassBatch* batch,
+                                         cass_uint64_t timeout_ms) {
+  batch->set_request_timeout_ms(timeout_ms);
+  return CASS_OK;
+}
+
+CassError cass_batch_set_priority(CassBatch* batch,
+                                  CassRequestPriority priority) {
+  if (priority != CASS_REQUEST_PRIORITY_NORMAL &&
+      priority != CASS_REQUEST_PRIORITY_HIGH) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  batch->set_priority(priority);
+  return CASS_OK;
+}
+
 CassError cass_batch_add_statement(CassBatch* batch, CassStatement* statement) {
   batch->add_statement(statement);
   return CASS_OK;
@@ -31,6 +31,8 @@ Buffer::~Buffer() {
     data_.ref.buffer->dec_ref();
   } else if (size_ == IS_COLLECTION) {
     data_.ref.collection->dec_ref();
+  } else if (size_ == IS_EXTERNAL) {
+    data_.ref.external->dec_ref();
   }
 }
 
@@ -48,6 +50,9 @@ void Buffer::copy(const Buffer& buffer) {
   } else if (buffer.size_ == IS_COLLECTION) {
     buffer.data_.ref.collection->inc_ref();
     data_.ref.collection = buffer.data_.ref.collection;
+  } else if (buffer.size_ == IS_EXTERNAL) {
+    buffer.data_.ref.external->inc_ref();
+    data_.ref.external = buffer.data_.ref.external;
   } else if (buffer.size_ > 0) {
     memcpy(data_.fixed, buffer.data_.fixed, buffer.size_);
   }
@@ -56,6 +61,8 @@ void Buffer::copy(const Buffer& buffer) {
     temp.buffer->dec_ref();
   } else if (size_ == IS_COLLECTION) {
     temp.collection->dec_ref();
+  } else if (size_ == IS_EXTERNAL) {
+    temp.external->dec_ref();
   }
 
   size_ = buffer.size_;
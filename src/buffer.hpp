@@ -17,6 +17,7 @@
 #ifndef __CASS_BUFFER_HPP_INCLUDED__
 #define __CASS_BUFFER_HPP_INCLUDED__
 
+#include "cassandra.h"
 #include "ref_counted.hpp"
 #include "serialization.hpp"
 
@@ -28,6 +29,36 @@ namespace cass {
 
 class BufferCollection;
 
+// Memory owned by the application that's referenced instead of copied. The
+// release callback is called once the last reference is removed.
+class ExternalBuffer : public RefCounted<ExternalBuffer> {
+public:
+  ExternalBuffer(const char* data, size_t size,
+                 CassValueReleaseCallback callback, void* callback_data)
+    : data_(data)
+    , size_(size)
+    , callback_(callback)
+    , callback_data_(callback_data) {}
+
+  ~ExternalBuffer() {
+    if (callback_ != NULL) {
+      callback_(callback_data_);
+    }
+  }
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const char* data_;
+  size_t size_;
+  CassValueReleaseCallback callback_;
+  void* callback_data_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ExternalBuffer);
+};
+
 class Buffer {
 public:
   Buffer()
@@ -57,6 +88,12 @@ public:
 
   Buffer(const BufferCollection* collection);
 
+  Buffer(const ExternalBuffer* external)
+    : size_(IS_EXTERNAL) {
+    external->inc_ref();
+    data_.ref.external = external;
+  }
+
   Buffer(const Buffer& buf)
     : size_(IS_EMPTY) {
     copy(buf);
@@ -168,11 +205,14 @@ public:
   }
 
   const char* data() const {
-    assert(is_buffer());
+    assert(is_buffer() || is_external());
+    if (size_ == IS_EXTERNAL) return data_.ref.external->data();
     return size_ > FIXED_BUFFER_SIZE ? static_cast<RefBuffer*>(data_.ref.buffer)->data() : data_.fixed;
   }
 
-  int size() const { return size_; }
+  int size() const {
+    return size_ == IS_EXTERNAL ? static_cast<int>(data_.ref.external->size()) : size_;
+  }
 
   bool is_buffer() const { return size_ >= 0; }
 
@@ -180,12 +220,16 @@ public:
 
   bool is_collection() const { return size_ == IS_COLLECTION; }
 
+  // External buffers are read-only
+  bool is_external() const { return size_ == IS_EXTERNAL; }
+
   const BufferCollection* collection() const;
 
 private:
   enum {
     IS_EMPTY = -1,
-    IS_COLLECTION = -2
+    IS_COLLECTION = -2,
+    IS_EXTERNAL = -3
   };
 
   char* buffer() {
@@ -204,6 +248,7 @@ private:
   union BufferRef {
     RefBuffer* buffer;
     const BufferCollection* collection;
+    const ExternalBuffer* external;
   };
 
   union {
@@ -108,14 +108,14 @@ namespace cass {
 int BufferCollection::encode(int version, BufferVec* bufs) const {
   if (version != 1 && version != 2) return -1;
 
-  int value_size = sizeof(uint16_t) + calculate_size(version);
+  int value_size = sizeof(uint16_t) + data_.size();
   int buf_size = sizeof(int32_t) + value_size;
 
   Buffer buf(buf_size);
 
   int pos = 0;
   pos = buf.encode_int32(pos, value_size);
-  pos = buf.encode_uint16(pos, is_map_ ? bufs_.size() / 2 : bufs_.size());
+  pos = buf.encode_uint16(pos, is_map_ ? item_count_ / 2 : item_count_);
 
   encode(version, buf.data() + pos);
 
@@ -126,25 +126,13 @@ int BufferCollection::encode(int version, BufferVec* bufs) const {
 
 int BufferCollection::calculate_size(int version) const {
   if (version != 1 && version != 2) return -1;
-  int value_size = 0;
-  for (BufferVec::const_iterator it = bufs_.begin(),
-      end = bufs_.end(); it != end; ++it) {
-    value_size += sizeof(uint16_t);
-    value_size += it->size();
-  }
-  return value_size;
+  return data_.size();
 }
 
 void BufferCollection::encode(int version, char* buf) const {
   assert(version == 1 || version == 2);
-  char* pos = buf;
-  for (BufferVec::const_iterator it = bufs_.begin(),
-      end = bufs_.end(); it != end; ++it) {
-    encode_uint16(pos, it->size());
-    pos += sizeof(uint16_t);
-
-    memcpy(pos, it->data(), it->size());
-    pos += it->size();
+  if (!data_.empty()) {
+    memcpy(buf, &data_[0], data_.size());
   }
 }
 
@@ -19,22 +19,29 @@
 
 #include "buffer.hpp"
 #include "ref_counted.hpp"
+#include "serialization.hpp"
+
+#include <string.h>
+#include <vector>
 
 namespace cass {
 
+// Items are encoded into a single wire format buffer ([short] size followed
+// by the value) as they're appended so encoding the collection is a single
+// copy and its size is known without iterating over the items.
 class BufferCollection : public RefCounted<BufferCollection> {
 public:
   explicit
   BufferCollection(bool is_map, size_t item_count)
-      : is_map_(is_map) {
-    bufs_.reserve(item_count);
+      : is_map_(is_map)
+      , item_count_(0) {
+    // Room for the sizes and the smallest values (e.g. "int")
+    data_.reserve(item_count * (sizeof(uint16_t) + sizeof(int32_t)));
   }
 
-#define APPEND_FIXED_TYPE(DeclType, EncodeType)     \
-  void append_##EncodeType(const DeclType& value) { \
-    Buffer buf(sizeof(DeclType));                   \
-    buf.encode_##EncodeType(0, value);              \
-    bufs_.push_back(buf);                           \
+#define APPEND_FIXED_TYPE(DeclType, EncodeType)                \
+  void append_##EncodeType(const DeclType& value) {            \
+    cass::encode_##EncodeType(allocate(sizeof(DeclType)), value); \
   }
 
   APPEND_FIXED_TYPE(int32_t, int32)
@@ -42,12 +49,14 @@ public:
   APPEND_FIXED_TYPE(float, float)
   APPEND_FIXED_TYPE(double, double)
   APPEND_FIXED_TYPE(uint8_t, byte)
-#undef BIND_FIXED_TYPE
+#undef APPEND_FIXED_TYPE
 
   void append(const char* value, size_t value_length) {
-    Buffer buf(value_length);
-    buf.copy(0, value, value_length);
-    bufs_.push_back(buf);
+    if (value_length > 0) {
+      memcpy(allocate(value_length), value, value_length);
+    } else {
+      allocate(0);
+    }
   }
 
   void append(const uint8_t* value, size_t value_length) {
@@ -55,30 +64,40 @@ public:
   }
 
   void append(CassUuid value) {
-    Buffer buf(sizeof(CassUuid));
-    buf.encode_uuid(0, value);
-    bufs_.push_back(buf);
+    cass::encode_uuid(allocate(sizeof(CassUuid)), value);
   }
 
   void append(const uint8_t* varint, size_t varint_len, int32_t scale) {
-    Buffer buf(sizeof(int32_t) + varint_len);
-    size_t pos = buf.encode_int32(0, scale);
-    buf.copy(pos, varint, varint_len);
-    bufs_.push_back(buf);
+    char* pos = allocate(sizeof(int32_t) + varint_len);
+    cass::encode_int32(pos, scale);
+    if (varint_len > 0) {
+      memcpy(pos + sizeof(int32_t), varint, varint_len);
+    }
   }
 
   bool is_map() const { return is_map_; }
 
-  size_t item_count() const { return bufs_.size(); }
+  size_t item_count() const { return item_count_; }
 
   int encode(int version, BufferVec* bufs) const;
   int calculate_size(int version) const;
   void encode(int version, char* buf) const;
 
 private:
+  // Appends an item's size and returns where its value is written
+  char* allocate(size_t size) {
+    size_t pos = data_.size();
+    data_.resize(pos + sizeof(uint16_t) + size);
+    cass::encode_uint16(&data_[pos], size);
+    item_count_++;
+    // Pointer arithmetic from the start because an empty value ends at the
+    // end of the vector and indexing one past the end is undefined.
+    return &data_[0] + pos + sizeof(uint16_t);
+  }
 
-  BufferVec bufs_;
+  std::vector<char> data_;
   bool is_map_;
+  size_t item_count_;
 };
 
 } // namespace cass
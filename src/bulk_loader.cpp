@@ -0,0 +1,272 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "bulk_loader.hpp"
+
+#include "future.hpp"
+#include "scoped_lock.hpp"
+#include "session.hpp"
+#include "statement.hpp"
+#include "types.hpp"
+
+extern "C" {
+
+CassBulkLoader* cass_bulk_loader_new(CassSession* session) {
+  return CassBulkLoader::to(new cass::BulkLoader(session->from()));
+}
+
+void cass_bulk_loader_free(CassBulkLoader* loader) {
+  delete loader->from();
+}
+
+CassError cass_bulk_loader_set_max_batch_statements(CassBulkLoader* loader,
+                                                    unsigned max_statements) {
+  if (max_statements == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  loader->set_max_batch_statements(max_statements);
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_set_max_batch_size(CassBulkLoader* loader,
+                                              size_t max_size) {
+  loader->set_max_batch_size(max_size);
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_set_max_concurrent_batches(CassBulkLoader* loader,
+                                                      unsigned max_concurrent_batches) {
+  if (max_concurrent_batches == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  loader->set_max_concurrent_batches(max_concurrent_batches);
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_set_consistency(CassBulkLoader* loader,
+                                           CassConsistency consistency) {
+  loader->set_consistency(consistency);
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_set_error_callback(CassBulkLoader* loader,
+                                              CassBulkLoaderErrorCallback callback,
+                                              void* data) {
+  loader->set_error_callback(callback, data);
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_add(CassBulkLoader* loader,
+                               CassStatement* statement) {
+  loader->add(statement->from());
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_flush(CassBulkLoader* loader) {
+  return loader->flush();
+}
+
+} // extern "C"
+
+namespace cass {
+
+void BatchGrouper::add(const HostVec& replicas, Statement* statement,
+                       BatchVec* batches) {
+  GroupKey key;
+  key.first = statement->keyspace();
+  key.second.reserve(replicas.size());
+  for (HostVec::const_iterator it = replicas.begin(),
+       end = replicas.end(); it != end; ++it) {
+    key.second.push_back((*it)->address());
+  }
+
+  // <kind><string_or_id><n><value_1>...<value_n>
+  size_t statement_size = sizeof(uint8_t) + sizeof(int32_t) + statement->query().size() +
+                          sizeof(uint16_t) + statement->values_size();
+
+  Group& group = groups_[key];
+  if (group.batch && group.size + statement_size > max_size_) {
+    batches->push_back(group.batch);
+    group = Group();
+  }
+
+  if (!group.batch) {
+    group.batch.reset(new BatchRequest(CASS_BATCH_TYPE_UNLOGGED));
+    group.batch->set_keyspace(statement->keyspace());
+  }
+
+  group.batch->add_statement(statement);
+  group.count++;
+  group.size += statement_size;
+
+  if (group.count >= max_statements_ || group.size >= max_size_) {
+    batches->push_back(group.batch);
+    groups_.erase(key);
+  }
+}
+
+void BatchGrouper::take_all(BatchVec* batches) {
+  for (GroupMap::iterator it = groups_.begin(),
+       end = groups_.end(); it != end; ++it) {
+    batches->push_back(it->second.batch);
+  }
+  groups_.clear();
+}
+
+BulkLoader::BulkLoader(Session* session)
+  : session_(session)
+  , grouper_(DEFAULT_MAX_BATCH_STATEMENTS, DEFAULT_MAX_BATCH_SIZE)
+  , max_concurrent_batches_(DEFAULT_MAX_CONCURRENT_BATCHES)
+  , consistency_(CASS_CONSISTENCY_ONE)
+  , error_callback_(NULL)
+  , error_callback_data_(NULL)
+  , pending_count_(0)
+  , last_error_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+BulkLoader::~BulkLoader() {
+  flush();
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+void BulkLoader::set_max_batch_statements(size_t max_statements) {
+  ScopedMutex l(&mutex_);
+  grouper_.set_max_statements(max_statements);
+}
+
+void BulkLoader::set_max_batch_size(size_t max_size) {
+  ScopedMutex l(&mutex_);
+  grouper_.set_max_size(max_size);
+}
+
+void BulkLoader::set_max_concurrent_batches(size_t max_concurrent_batches) {
+  ScopedMutex l(&mutex_);
+  max_concurrent_batches_ = max_concurrent_batches;
+}
+
+void BulkLoader::set_consistency(CassConsistency consistency) {
+  ScopedMutex l(&mutex_);
+  consistency_ = consistency;
+}
+
+void BulkLoader::set_error_callback(CassBulkLoaderErrorCallback callback, void* data) {
+  ScopedMutex l(&mutex_);
+  error_callback_ = callback;
+  error_callback_data_ = data;
+}
+
+void BulkLoader::add(Statement* statement) {
+  std::string routing_key;
+  BatchGrouper::BatchVec batches;
+
+  if (statement->get_routing_key(&routing_key)) {
+    CopyOnWriteHostVec replicas = session_->get_replicas(statement->keyspace(), routing_key);
+    ScopedMutex l(&mutex_);
+    grouper_.add(*replicas, statement, &batches);
+  } else {
+    HostVec no_replicas;
+    ScopedMutex l(&mutex_);
+    grouper_.add(no_replicas, statement, &batches);
+  }
+
+  execute_all(batches);
+}
+
+CassError BulkLoader::flush() {
+  BatchGrouper::BatchVec batches;
+  {
+    ScopedMutex l(&mutex_);
+    grouper_.take_all(&batches);
+  }
+
+  execute_all(batches);
+
+  ScopedMutex l(&mutex_);
+  while (pending_count_ > 0) {
+    uv_cond_wait(&cond_, &mutex_);
+  }
+  CassError last_error = last_error_;
+  last_error_ = CASS_OK;
+  return last_error;
+}
+
+void BulkLoader::wait_for_capacity() {
+  while (pending_count_ >= max_concurrent_batches_) {
+    uv_cond_wait(&cond_, &mutex_);
+  }
+  pending_count_++;
+}
+
+void BulkLoader::execute_all(const BatchGrouper::BatchVec& batches) {
+  for (BatchGrouper::BatchVec::const_iterator it = batches.begin(),
+       end = batches.end(); it != end; ++it) {
+    {
+      ScopedMutex l(&mutex_);
+      wait_for_capacity();
+    }
+    execute(*it);
+  }
+}
+
+void BulkLoader::execute(const SharedRefPtr<BatchRequest>& batch) {
+  batch->set_consistency(consistency_);
+  Future* future = session_->execute(batch.get());
+  future->set_callback(on_batch_done, new PendingBatch(this, batch));
+  future->dec_ref();
+}
+
+void BulkLoader::on_batch_done(CassFuture* future, void* data) {
+  PendingBatch* pending = static_cast<PendingBatch*>(data);
+  BulkLoader* loader = pending->loader;
+
+  CassBulkLoaderErrorCallback error_callback;
+  void* error_callback_data;
+  {
+    ScopedMutex l(&loader->mutex_);
+    error_callback = loader->error_callback_;
+    error_callback_data = loader->error_callback_data_;
+  }
+
+  Future::Error* error = future->from()->get_error();
+  CassError code = CASS_OK;
+  if (error != NULL) {
+    code = error->code;
+    if (error_callback != NULL) {
+      const BatchRequest::StatementList& statements = pending->batch->statements();
+      for (BatchRequest::StatementList::const_iterator it = statements.begin(),
+           end = statements.end(); it != end; ++it) {
+        error_callback(CassStatement::to(it->get()),
+                       code,
+                       error->message.data(), error->message.size(),
+                       error_callback_data);
+      }
+    }
+  }
+  delete pending;
+
+  // The loader can be freed as soon as the mutex is released
+  ScopedMutex l(&loader->mutex_);
+  if (code != CASS_OK) {
+    loader->last_error_ = code;
+  }
+  loader->pending_count_--;
+  uv_cond_broadcast(&loader->cond_);
+}
+
+} // namespace cass
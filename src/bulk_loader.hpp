@@ -0,0 +1,147 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_BULK_LOADER_HPP_INCLUDED__
+#define __CASS_BULK_LOADER_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "batch_request.hpp"
+#include "cassandra.h"
+#include "host.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <map>
+#include <string>
+#include <uv.h>
+#include <utility>
+#include <vector>
+
+namespace cass {
+
+class Session;
+class Statement;
+
+// Groups statements that have the same keyspace and replicas into unlogged
+// batches that are limited by their number of statements and their size.
+class BatchGrouper {
+public:
+  typedef std::vector<SharedRefPtr<BatchRequest> > BatchVec;
+
+  BatchGrouper(size_t max_statements, size_t max_size)
+    : max_statements_(max_statements)
+    , max_size_(max_size) {}
+
+  size_t max_statements() const { return max_statements_; }
+  void set_max_statements(size_t max_statements) { max_statements_ = max_statements; }
+
+  size_t max_size() const { return max_size_; }
+  void set_max_size(size_t max_size) { max_size_ = max_size; }
+
+  // Adds the batches that are ready to be executed: the statement's group
+  // is taken first if the statement would make it larger than the maximum
+  // size, and the statement's batch once it's full. A statement that's larger
+  // than the maximum size is in a batch of its own. The replicas are empty
+  // for statements without a routing key.
+  void add(const HostVec& replicas, Statement* statement, BatchVec* batches);
+
+  // Removes all the batches that are not full
+  void take_all(BatchVec* batches);
+
+private:
+  typedef std::pair<std::string, std::vector<Address> > GroupKey;
+
+  struct Group {
+    Group()
+      : count(0)
+      , size(0) {}
+
+    SharedRefPtr<BatchRequest> batch;
+    size_t count;
+    size_t size;
+  };
+
+  typedef std::map<GroupKey, Group> GroupMap;
+
+  size_t max_statements_;
+  size_t max_size_;
+  GroupMap groups_;
+};
+
+// Sends the batches of a BatchGrouper with a bound on the number of batches
+// that are executing at the same time. The batches are routed using their
+// first statement's routing key so they're sent to one of the replicas when
+// token aware routing is enabled.
+class BulkLoader {
+public:
+  static const size_t DEFAULT_MAX_BATCH_STATEMENTS = 100;
+  static const size_t DEFAULT_MAX_BATCH_SIZE = 5 * 1024; // Server's warning threshold
+  static const size_t DEFAULT_MAX_CONCURRENT_BATCHES = 64;
+
+  BulkLoader(Session* session);
+  ~BulkLoader();
+
+  void set_max_batch_statements(size_t max_statements);
+  void set_max_batch_size(size_t max_size);
+  void set_max_concurrent_batches(size_t max_concurrent_batches);
+  void set_consistency(CassConsistency consistency);
+  void set_error_callback(CassBulkLoaderErrorCallback callback, void* data);
+
+  // Blocks when the maximum number of batches are executing so it must not
+  // be called from a future callback (an IO thread)
+  void add(Statement* statement);
+
+  // Sends the remaining batches and waits for all of them to finish. Returns
+  // the error code of the last failure since the previous flush.
+  CassError flush();
+
+private:
+  struct PendingBatch {
+    PendingBatch(BulkLoader* loader, const SharedRefPtr<BatchRequest>& batch)
+      : loader(loader)
+      , batch(batch) {}
+
+    BulkLoader* loader;
+    SharedRefPtr<BatchRequest> batch;
+  };
+
+  // Must be called with the mutex held
+  void wait_for_capacity();
+  void execute(const SharedRefPtr<BatchRequest>& batch);
+  void execute_all(const BatchGrouper::BatchVec& batches);
+
+  static void on_batch_done(CassFuture* future, void* data);
+
+private:
+  Session* session_;
+  BatchGrouper grouper_;
+  size_t max_concurrent_batches_;
+  CassConsistency consistency_;
+  CassBulkLoaderErrorCallback error_callback_;
+  void* error_callback_data_;
+
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  size_t pending_count_;
+  CassError last_error_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BulkLoader);
+};
+
+} // namespace cass
+
+#endif
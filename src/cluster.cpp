@@ -20,8 +20,10 @@
 #include "dc_aware_policy.hpp"
 #include "logger.hpp"
 #include "round_robin_policy.hpp"
+#include "stream_manager.hpp"
 #include "types.hpp"
 
+#include <limits>
 #include <sstream>
 
 extern "C" {
@@ -295,6 +297,91 @@ void cass_cluster_set_tcp_keepalive(CassCluster* cluster,
   cluster->config().set_tcp_keepalive(enabled == cass_true, delay_secs);
 }
 
+void cass_cluster_set_deferred_result_decoding(CassCluster* cluster,
+                                               cass_bool_t enabled) {
+  cluster->config().set_deferred_result_decoding(enabled == cass_true);
+}
+
+void cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
+                                                cass_bool_t enabled) {
+  cluster->config().set_prepare_on_up_or_add_host(enabled == cass_true);
+}
+
+void cass_cluster_set_prepared_cache_size(CassCluster* cluster,
+                                          unsigned size) {
+  cluster->config().set_prepared_cache_size(size);
+}
+
+void cass_cluster_set_auto_prepare_threshold(CassCluster* cluster,
+                                             unsigned threshold) {
+  cluster->config().set_auto_prepare_threshold(threshold);
+}
+
+void cass_cluster_set_high_priority_weight(CassCluster* cluster,
+                                           unsigned weight) {
+  cluster->config().set_high_priority_weight(weight);
+}
+
+CassError cass_cluster_set_reserved_high_priority_streams(CassCluster* cluster,
+                                                          unsigned num_streams) {
+  // At least one stream is left for normal priority requests
+  if (num_streams >= static_cast<unsigned>(cass::StreamManager<void*>::MAX_STREAMS)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_reserved_high_priority_streams(num_streams);
+  return CASS_OK;
+}
+
+void cass_cluster_set_request_timeline_sample_rate(CassCluster* cluster,
+                                                   unsigned sample_rate) {
+  cluster->config().set_request_timeline_sample_rate(sample_rate);
+}
+
+void cass_cluster_set_request_timeline_buffer_size(CassCluster* cluster,
+                                                   unsigned num_timelines) {
+  cluster->config().set_request_timeline_buffer_size(num_timelines);
+}
+
+void cass_cluster_set_slow_request_threshold(CassCluster* cluster,
+                                             unsigned threshold_ms) {
+  cluster->config().set_slow_request_threshold_ms(threshold_ms);
+}
+
+void cass_cluster_set_slow_request_sampling(CassCluster* cluster,
+                                            unsigned sample_rate,
+                                            unsigned max_per_second) {
+  cluster->config().set_slow_request_sampling(sample_rate, max_per_second);
+}
+
+void cass_cluster_set_slow_request_callback(CassCluster* cluster,
+                                            CassSlowRequestCallback callback,
+                                            void* data) {
+  cluster->config().set_slow_request_callback(callback, data);
+}
+
+CassError cass_cluster_set_latency_histogram_range(CassCluster* cluster,
+                                                   cass_uint64_t highest_latency_us,
+                                                   unsigned significant_figures) {
+  if (highest_latency_us < 2 ||
+      highest_latency_us > static_cast<cass_uint64_t>(std::numeric_limits<int64_t>::max() / 2) ||
+      significant_figures < 1 || significant_figures > 5) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_latency_histogram_range(static_cast<int64_t>(highest_latency_us),
+                                                static_cast<int>(significant_figures));
+  return CASS_OK;
+}
+
+void cass_cluster_set_host_latency_histograms(CassCluster* cluster,
+                                              cass_bool_t enabled) {
+  cluster->config().set_host_latency_histograms(enabled == cass_true);
+}
+
+void cass_cluster_set_io_thread_group(CassCluster* cluster,
+                                      CassIOThreadGroup* group) {
+  cluster->config().set_io_thread_group(group->from());
+}
+
 void cass_cluster_free(CassCluster* cluster) {
   delete cluster->from();
 }
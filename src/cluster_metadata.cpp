@@ -20,23 +20,47 @@ namespace cass {
 
 ClusterMetadata::ClusterMetadata() {
   uv_mutex_init(&schema_mutex_);
+  uv_mutex_init(&token_map_mutex_);
 }
 
 ClusterMetadata::~ClusterMetadata() {
   uv_mutex_destroy(&schema_mutex_);
+  uv_mutex_destroy(&token_map_mutex_);
 }
 
 void ClusterMetadata::clear() {
   schema_.clear();
+  ScopedMutex l(&token_map_mutex_);
   token_map_.clear();
 }
 
+void ClusterMetadata::set_partitioner(const std::string& partitioner_class) {
+  ScopedMutex l(&token_map_mutex_);
+  token_map_.set_partitioner(partitioner_class);
+}
+
+void ClusterMetadata::update_host(SharedRefPtr<Host>& host, const TokenStringList& tokens) {
+  ScopedMutex l(&token_map_mutex_);
+  token_map_.update_host(host, tokens);
+}
+
+void ClusterMetadata::build() {
+  ScopedMutex l(&token_map_mutex_);
+  token_map_.build();
+}
+
+void ClusterMetadata::remove_host(SharedRefPtr<Host>& host) {
+  ScopedMutex l(&token_map_mutex_);
+  token_map_.remove_host(host);
+}
+
 void ClusterMetadata::update_keyspaces(ResultResponse* result) {
   Schema::KeyspacePointerMap keyspaces;
   {
     ScopedMutex l(&schema_mutex_);
     keyspaces = schema_.update_keyspaces(result);
   }
+  ScopedMutex l(&token_map_mutex_);
   for (Schema::KeyspacePointerMap::const_iterator i = keyspaces.begin(); i != keyspaces.end(); ++i) {
     token_map_.update_keyspace(i->first, *i->second);
   }
@@ -49,6 +73,7 @@ void ClusterMetadata::update_tables(ResultResponse* table_result, ResultResponse
 
 void ClusterMetadata::drop_keyspace(const std::string& keyspace_name) {
   schema_.drop_keyspace(keyspace_name);
+  ScopedMutex l(&token_map_mutex_);
   token_map_.drop_keyspace(keyspace_name);
 }
 
@@ -57,4 +82,23 @@ Schema* ClusterMetadata::copy_schema() const {
   return new Schema(schema_);
 }
 
+void ClusterMetadata::get_table_key_columns(const std::string& keyspace_name,
+                                            const std::string& table_name,
+                                            std::vector<std::string>* output) const {
+  ScopedMutex l(&schema_mutex_);
+  schema_.get_table_key_columns(keyspace_name, table_name, output);
+}
+
+CopyOnWriteHostVec ClusterMetadata::get_replicas(const std::string& keyspace_name,
+                                                 const std::string& routing_key) const {
+  ScopedMutex l(&token_map_mutex_);
+  return token_map_.get_replicas(keyspace_name, routing_key);
+}
+
+bool ClusterMetadata::get_int64_token(const std::string& routing_key,
+                                      int64_t* token) const {
+  ScopedMutex l(&token_map_mutex_);
+  return token_map_.get_int64_token(routing_key, token);
+}
+
 } // namespace cass
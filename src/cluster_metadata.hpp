@@ -30,19 +30,25 @@ public:
   void clear();
   void update_keyspaces(ResultResponse* result);
   void update_tables(ResultResponse* table_result, ResultResponse* col_result);
-  void set_partitioner(const std::string& partitioner_class) { token_map_.set_partitioner(partitioner_class); }
-  void update_host(SharedRefPtr<Host>& host, const TokenStringList& tokens) { token_map_.update_host(host, tokens); }
-  void build() { token_map_.build(); }
+  void set_partitioner(const std::string& partitioner_class);
+  void update_host(SharedRefPtr<Host>& host, const TokenStringList& tokens);
+  void build();
   void drop_keyspace(const std::string& keyspace_name);
   void drop_table(const std::string& keyspace_name, const std::string& table_name) { schema_.drop_table(keyspace_name, table_name); }
-  void remove_host(SharedRefPtr<Host>& host) { token_map_.remove_host(host); }
+  void remove_host(SharedRefPtr<Host>& host);
 
   const Schema& schema() const { return schema_; }
   Schema* copy_schema() const;// synchronized copy for API
+  void get_table_key_columns(const std::string& keyspace_name,
+                             const std::string& table_name,
+                             std::vector<std::string>* output) const; // synchronized for API
 
   void set_protocol_version(int version) { schema_.set_protocol_version(version); }
 
   const TokenMap& token_map() const { return token_map_; }
+  CopyOnWriteHostVec get_replicas(const std::string& keyspace_name,
+                                  const std::string& routing_key) const; // synchronized copy for API
+  bool get_int64_token(const std::string& routing_key, int64_t* token) const; // synchronized for API
 
 private:
   Schema schema_;
@@ -50,6 +56,9 @@ private:
 
   // Used to synch schema updates and copies
   mutable uv_mutex_t schema_mutex_;
+
+  // Used to synch token map updates and replica lookups from other threads
+  mutable uv_mutex_t token_map_mutex_;
 };
 
 } // namespace cass
@@ -21,6 +21,7 @@
 #include "cassandra.h"
 #include "dc_aware_policy.hpp"
 #include "latency_aware_policy.hpp"
+#include "io_thread_group.hpp"
 #include "ssl.hpp"
 #include "token_aware_policy.hpp"
 
@@ -63,7 +64,23 @@ public:
       , latency_aware_routing_(false)
       , tcp_nodelay_enable_(false)
       , tcp_keepalive_enable_(false)
-      , tcp_keepalive_delay_secs_(0) {}
+      , tcp_keepalive_delay_secs_(0)
+      , deferred_result_decoding_(false)
+      , prepare_on_up_or_add_host_(true)
+      , prepared_cache_size_(1000)
+      , auto_prepare_threshold_(0)
+      , high_priority_weight_(4)
+      , reserved_high_priority_streams_(0)
+      , request_timeline_sample_rate_(0)
+      , request_timeline_buffer_size_(1024)
+      , slow_request_threshold_ms_(0)
+      , slow_request_sample_rate_(1)
+      , slow_request_max_per_second_(10)
+      , slow_request_callback_(NULL)
+      , slow_request_callback_data_(NULL)
+      , histogram_highest_latency_us_(3600LL * 1000LL * 1000LL)
+      , histogram_significant_figures_(3)
+      , host_latency_histograms_(false) {}
 
   unsigned thread_count_io() const { return thread_count_io_; }
 
@@ -270,6 +287,99 @@ public:
     tcp_keepalive_delay_secs_ = delay_secs;
   }
 
+  bool deferred_result_decoding() const { return deferred_result_decoding_; }
+
+  void set_deferred_result_decoding(bool is_deferred) {
+    deferred_result_decoding_ = is_deferred;
+  }
+
+  bool prepare_on_up_or_add_host() const { return prepare_on_up_or_add_host_; }
+
+  void set_prepare_on_up_or_add_host(bool enabled) {
+    prepare_on_up_or_add_host_ = enabled;
+  }
+
+  unsigned prepared_cache_size() const { return prepared_cache_size_; }
+
+  void set_prepared_cache_size(unsigned size) {
+    prepared_cache_size_ = size;
+  }
+
+  unsigned auto_prepare_threshold() const { return auto_prepare_threshold_; }
+
+  void set_auto_prepare_threshold(unsigned threshold) {
+    auto_prepare_threshold_ = threshold;
+  }
+
+  unsigned high_priority_weight() const { return high_priority_weight_; }
+
+  void set_high_priority_weight(unsigned weight) {
+    high_priority_weight_ = weight;
+  }
+
+  unsigned reserved_high_priority_streams() const { return reserved_high_priority_streams_; }
+
+  void set_reserved_high_priority_streams(unsigned num_streams) {
+    reserved_high_priority_streams_ = num_streams;
+  }
+
+  unsigned request_timeline_sample_rate() const { return request_timeline_sample_rate_; }
+
+  void set_request_timeline_sample_rate(unsigned sample_rate) {
+    request_timeline_sample_rate_ = sample_rate;
+  }
+
+  unsigned request_timeline_buffer_size() const { return request_timeline_buffer_size_; }
+
+  void set_request_timeline_buffer_size(unsigned num_timelines) {
+    request_timeline_buffer_size_ = num_timelines;
+  }
+
+  unsigned slow_request_threshold_ms() const { return slow_request_threshold_ms_; }
+
+  void set_slow_request_threshold_ms(unsigned threshold_ms) {
+    slow_request_threshold_ms_ = threshold_ms;
+  }
+
+  unsigned slow_request_sample_rate() const { return slow_request_sample_rate_; }
+
+  unsigned slow_request_max_per_second() const { return slow_request_max_per_second_; }
+
+  void set_slow_request_sampling(unsigned sample_rate, unsigned max_per_second) {
+    slow_request_sample_rate_ = sample_rate;
+    slow_request_max_per_second_ = max_per_second;
+  }
+
+  CassSlowRequestCallback slow_request_callback() const { return slow_request_callback_; }
+
+  void* slow_request_callback_data() const { return slow_request_callback_data_; }
+
+  void set_slow_request_callback(CassSlowRequestCallback callback, void* data) {
+    slow_request_callback_ = callback;
+    slow_request_callback_data_ = data;
+  }
+
+  int64_t histogram_highest_latency_us() const { return histogram_highest_latency_us_; }
+
+  int histogram_significant_figures() const { return histogram_significant_figures_; }
+
+  void set_latency_histogram_range(int64_t highest_latency_us, int significant_figures) {
+    histogram_highest_latency_us_ = highest_latency_us;
+    histogram_significant_figures_ = significant_figures;
+  }
+
+  bool host_latency_histograms() const { return host_latency_histograms_; }
+
+  void set_host_latency_histograms(bool enabled) {
+    host_latency_histograms_ = enabled;
+  }
+
+  IOThreadGroup* io_thread_group() const { return io_thread_group_.get(); }
+
+  void set_io_thread_group(IOThreadGroup* io_thread_group) {
+    io_thread_group_.reset(io_thread_group);
+  }
+
 private:
   int port_;
   int protocol_version_;
@@ -302,6 +412,23 @@ private:
   bool tcp_nodelay_enable_;
   bool tcp_keepalive_enable_;
   unsigned tcp_keepalive_delay_secs_;
+  bool deferred_result_decoding_;
+  bool prepare_on_up_or_add_host_;
+  unsigned prepared_cache_size_;
+  unsigned auto_prepare_threshold_;
+  unsigned high_priority_weight_;
+  unsigned reserved_high_priority_streams_;
+  unsigned request_timeline_sample_rate_;
+  unsigned request_timeline_buffer_size_;
+  unsigned slow_request_threshold_ms_;
+  unsigned slow_request_sample_rate_;
+  unsigned slow_request_max_per_second_;
+  CassSlowRequestCallback slow_request_callback_;
+  void* slow_request_callback_data_;
+  int64_t histogram_highest_latency_us_;
+  int histogram_significant_figures_;
+  bool host_latency_histograms_;
+  SharedRefPtr<IOThreadGroup> io_thread_group_;
 };
 
 } // namespace cass
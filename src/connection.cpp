@@ -152,17 +152,20 @@ Connection::Connection(uv_loop_t* loop,
     , is_invalid_protocol_(false)
     , is_registered_for_events_(false)
     , is_available_(false)
+    , is_result_decoding_deferred_(false)
     , ssl_error_code_(CASS_OK)
     , pending_writes_size_(0)
     , loop_(loop)
     , config_(config)
     , metrics_(metrics)
+    , host_metrics_(NULL)
+    , callback_count_(NULL)
     , address_(address)
     , addr_string_(address.to_string())
     , keyspace_(keyspace)
     , protocol_version_(protocol_version)
     , listener_(listener)
-    , response_(new ResponseMessage())
+    , response_(new_response_message())
     , version_("3.0.0")
     , connect_timer_(NULL)
     , ssl_session_(NULL) {
@@ -195,12 +198,34 @@ void Connection::connect() {
   }
 }
 
+void Connection::set_is_result_decoding_deferred(bool is_deferred) {
+  assert(state_ == CONNECTION_STATE_NEW);
+  is_result_decoding_deferred_ = is_deferred;
+  response_.reset(new_response_message());
+}
+
+void Connection::set_host_metrics(Metrics::HostMetrics* host_metrics) {
+  assert(state_ == CONNECTION_STATE_NEW);
+  host_metrics_ = host_metrics;
+}
+
+void Connection::set_callback_count(uint64_t* callback_count) {
+  assert(state_ == CONNECTION_STATE_NEW);
+  callback_count_ = callback_count;
+}
+
 bool Connection::write(Handler* handler, bool flush_immediately) {
   int8_t stream = stream_manager_.acquire_stream(handler);
   if (stream < 0) {
     return false;
   }
 
+  if (host_metrics_ != NULL) {
+    host_metrics_->in_flight_requests.inc();
+  }
+
+  handler->record_stage(CASS_REQUEST_STAGE_CONNECTION);
+
   handler->inc_ref(); // Connection reference
   handler->set_connection(this);
   handler->set_stream(stream);
@@ -217,7 +242,7 @@ bool Connection::write(Handler* handler, bool flush_immediately) {
 
   int32_t request_size = pending_write->write(handler);
   if (request_size < 0) {
-    stream_manager_.release_stream(stream);
+    release_stream(stream);
     handler->on_error(CASS_ERROR_LIB_MESSAGE_ENCODE,
                       "Operation unsupported by this protocol version");
     handler->dec_ref();
@@ -225,6 +250,9 @@ bool Connection::write(Handler* handler, bool flush_immediately) {
   }
 
   pending_writes_size_ += request_size;
+  if (host_metrics_ != NULL) {
+    host_metrics_->bytes_written.add(request_size);
+  }
   if (pending_writes_size_ > config_.write_bytes_high_water_mark()) {
     LOG_WARN("Exceeded write bytes water mark (current: %u water mark: %u) on connection to host %s",
              static_cast<unsigned int>(pending_writes_size_),
@@ -239,7 +267,7 @@ bool Connection::write(Handler* handler, bool flush_immediately) {
 
   handler->set_state(Handler::REQUEST_STATE_WRITING);
   handler->start_timer(loop_,
-                       config_.request_timeout_ms(),
+                       handler->request_timeout_ms(config_.request_timeout_ms()),
                        handler,
                        Connection::on_timeout);
 
@@ -250,10 +278,14 @@ bool Connection::write(Handler* handler, bool flush_immediately) {
   return true;
 }
 
-void Connection::flush() {
-  if (pending_writes_.is_empty()) return;
+size_t Connection::flush() {
+  if (pending_writes_.is_empty()) return 0;
+
+  PendingWriteBase* pending_write = pending_writes_.back();
+  if (pending_write->is_flushed()) return 0;
 
-  pending_writes_.back()->flush();
+  pending_write->flush();
+  return pending_write->size();
 }
 
 void Connection::schedule_schema_agreement(const SharedRefPtr<SchemaChangeHandler>& handler, uint64_t wait) {
@@ -299,6 +331,10 @@ void Connection::consume(char* input, size_t size) {
   char* buffer = input;
   size_t remaining = size;
 
+  if (host_metrics_ != NULL) {
+    host_metrics_->bytes_read.add(size);
+  }
+
   while (remaining != 0) {
     int consumed = response_->decode(protocol_version_, buffer, remaining);
     if (consumed <= 0) {
@@ -309,7 +345,7 @@ void Connection::consume(char* input, size_t size) {
 
     if (response_->is_body_ready()) {
       ScopedPtr<ResponseMessage> response(response_.release());
-      response_.reset(new ResponseMessage());
+      response_.reset(new_response_message());
 
       LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
                 opcode_to_string(response->opcode()).c_str(),
@@ -328,6 +364,14 @@ void Connection::consume(char* input, size_t size) {
       } else {
         Handler* handler = NULL;
         if (stream_manager_.get_item(response->stream(), handler)) {
+          handler->record_stage(CASS_REQUEST_STAGE_RESPONSE);
+          if (host_metrics_ != NULL) {
+            host_metrics_->in_flight_requests.dec();
+            if (response->opcode() == CQL_OPCODE_ERROR) {
+              host_metrics_->errors.inc();
+            }
+          }
+
           switch (handler->state()) {
             case Handler::REQUEST_STATE_READING:
               maybe_set_keyspace(response.get());
@@ -372,8 +416,30 @@ void Connection::consume(char* input, size_t size) {
   }
 }
 
+void Connection::release_stream(int8_t stream) {
+  stream_manager_.release_stream(stream);
+  if (host_metrics_ != NULL) {
+    host_metrics_->in_flight_requests.dec();
+  }
+}
+
+ResponseMessage* Connection::new_response_message() {
+  return new ResponseMessage(is_result_decoding_deferred_,
+                             is_result_discarded, this);
+}
+
+bool Connection::is_result_discarded(void* data, int8_t stream, uint8_t opcode) {
+  if (opcode != CQL_OPCODE_RESULT || stream < 0) {
+    return false;
+  }
+  Connection* connection = static_cast<Connection*>(data);
+  Handler* handler = NULL;
+  return connection->stream_manager_.get_item(stream, handler, false) &&
+         handler->is_result_discarded();
+}
+
 void Connection::maybe_set_keyspace(ResponseMessage* response) {
-  if (response->opcode() == CQL_OPCODE_RESULT) {
+  if (response->opcode() == CQL_OPCODE_RESULT && !response->is_body_discarded()) {
     ResultResponse* result =
         static_cast<ResultResponse*>(response->response_body().get());
     if (result->kind() == CASS_RESULT_KIND_SET_KEYSPACE) {
@@ -384,6 +450,7 @@ void Connection::maybe_set_keyspace(ResponseMessage* response) {
 
 void Connection::on_connect(Connector* connector) {
   Connection* connection = static_cast<Connection*>(connector->data());
+  connection->inc_callback_count();
 
   if (connection->connect_timer_ == NULL) {
     return; // Timed out
@@ -417,6 +484,7 @@ void Connection::on_connect(Connector* connector) {
 
 void Connection::on_connect_timeout(Timer* timer) {
   Connection* connection = static_cast<Connection*>(timer->data());
+  connection->inc_callback_count();
   connection->connect_timer_ = NULL;
   connection->notify_error("Connection timeout");
 
@@ -425,10 +493,17 @@ void Connection::on_connect_timeout(Timer* timer) {
 
 void Connection::on_close(uv_handle_t* handle) {
   Connection* connection = static_cast<Connection*>(handle->data);
+  connection->inc_callback_count();
 
   LOG_DEBUG("Connection to host %s closed",
             connection->addr_string_.c_str());
 
+  // The streams of the requests that never got a response
+  if (connection->host_metrics_ != NULL) {
+    connection->host_metrics_->in_flight_requests.add(
+          -static_cast<int64_t>(connection->stream_manager_.pending_streams()));
+  }
+
   cleanup_pending_handlers(&connection->pending_reads_);
 
   while (!connection->pending_writes_.is_empty()) {
@@ -469,6 +544,7 @@ void Connection::on_read(uv_stream_t* client, ssize_t nread, uv_buf_t buf) {
 void Connection::on_read(uv_stream_t* client, ssize_t nread, const uv_buf_t* buf) {
 #endif
   Connection* connection = static_cast<Connection*>(client->data);
+  connection->inc_callback_count();
 
   if (nread < 0) {
 #if UV_VERSION_MAJOR == 0
@@ -518,6 +594,7 @@ void Connection::on_read_ssl(uv_stream_t* client, ssize_t nread, uv_buf_t buf) {
 void Connection::on_read_ssl(uv_stream_t* client, ssize_t nread, const uv_buf_t* buf) {
 #endif
   Connection* connection = static_cast<Connection*>(client->data);
+  connection->inc_callback_count();
 
   SslSession* ssl_session = connection->ssl_session_.get();
   assert(ssl_session != NULL);
@@ -555,6 +632,7 @@ void Connection::on_read_ssl(uv_stream_t* client, ssize_t nread, const uv_buf_t*
 void Connection::on_timeout(RequestTimer* timer) {
   Handler* handler = static_cast<Handler*>(timer->data());
   Connection* connection = handler->connection();
+  connection->inc_callback_count();
   LOG_INFO("Request timed out to host %s", connection->addr_string_.c_str());
   // TODO (mpenick): We need to handle the case where we have too many
   // timeout requests and we run out of stream ids. The java-driver
@@ -563,6 +641,9 @@ void Connection::on_timeout(RequestTimer* timer) {
   handler->on_timeout();
 
   connection->metrics_->request_timeouts.inc();
+  if (connection->host_metrics_ != NULL) {
+    connection->host_metrics_->timeouts.inc();
+  }
 }
 
 void Connection::on_connected() {
@@ -623,6 +704,7 @@ void Connection::on_pending_schema_agreement(Timer* timer) {
   PendingSchemaAgreement* pending_schema_agreement
       = static_cast<PendingSchemaAgreement*>(timer->data());
   Connection* connection = pending_schema_agreement->handler->connection();
+  connection->inc_callback_count();
   connection->pending_schema_agreements_.remove(pending_schema_agreement);
   pending_schema_agreement->handler->execute();
   delete pending_schema_agreement;
@@ -739,6 +821,7 @@ void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
   PendingWrite* pending_write = static_cast<PendingWrite*>(req->data);
 
   Connection* connection = static_cast<Connection*>(pending_write->connection_);
+  connection->inc_callback_count();
 
   while (!pending_write->handlers_.is_empty()) {
     Handler* handler = pending_write->handlers_.front();
@@ -748,6 +831,7 @@ void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
     switch (handler->state()) {
       case Handler::REQUEST_STATE_WRITING:
         if (status == 0) {
+          handler->record_stage(CASS_REQUEST_STAGE_WRITTEN);
           handler->set_state(Handler::REQUEST_STATE_READING);
           connection->pending_reads_.add_to_back(handler);
         } else {
@@ -758,7 +842,10 @@ void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
             connection->defunct();
           }
 
-          connection->stream_manager_.release_stream(handler->stream());
+          connection->release_stream(handler->stream());
+          if (connection->host_metrics_ != NULL) {
+            connection->host_metrics_->errors.inc();
+          }
           handler->stop_timer();
           handler->set_state(Handler::REQUEST_STATE_DONE);
           handler->on_error(CASS_ERROR_LIB_WRITE_ERROR,
@@ -925,6 +1012,7 @@ Connection::SslHandshakeWriter::SslHandshakeWriter(Connection* connection, char*
 
 void Connection::SslHandshakeWriter::on_write(uv_write_t* req, int status) {
   SslHandshakeWriter* writer = static_cast<SslHandshakeWriter*>(req->data);
+  writer->connection_->inc_callback_count();
   if (status != 0) {
     writer->connection_->notify_error("Failed to write during SSL handshake");
   }
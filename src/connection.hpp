@@ -85,7 +85,8 @@ public:
   void connect();
 
   bool write(Handler* request, bool flush_immediately = true);
-  void flush();
+  // Returns the number of bytes flushed
+  size_t flush();
 
   void schedule_schema_agreement(const SharedRefPtr<SchemaChangeHandler>& handler, uint64_t wait);
 
@@ -113,6 +114,22 @@ public:
 
   int protocol_version() const { return protocol_version_; }
 
+  bool is_result_decoding_deferred() const { return is_result_decoding_deferred_; }
+
+  // Must be called before connect()
+  void set_is_result_decoding_deferred(bool is_deferred);
+
+  // NULL for connections that aren't part of a pool
+  Metrics::HostMetrics* host_metrics() { return host_metrics_; }
+
+  // Must be called before connect()
+  void set_host_metrics(Metrics::HostMetrics* host_metrics);
+
+  // Incremented by each of the connection's socket and timer callbacks. NULL
+  // (the default) for connections that aren't part of a pool.
+  // Must be called before connect()
+  void set_callback_count(uint64_t* callback_count);
+
   size_t available_streams() const { return stream_manager_.available_streams(); }
   size_t pending_request_count() const { return stream_manager_.pending_streams(); }
 
@@ -230,7 +247,11 @@ private:
   void set_is_available(bool is_available);
   void actually_close();
   void consume(char* input, size_t size);
+  void release_stream(int8_t stream);
   void maybe_set_keyspace(ResponseMessage* response);
+  ResponseMessage* new_response_message();
+
+  static bool is_result_discarded(void* data, int8_t stream, uint8_t opcode);
 
   static void on_connect(Connector* connecter);
   static void on_connect_timeout(Timer* timer);
@@ -267,12 +288,17 @@ private:
   void send_credentials();
   void send_initial_auth_response();
 
+  void inc_callback_count() {
+    if (callback_count_ != NULL) ++*callback_count_;
+  }
+
 private:
   ConnectionState state_;
   bool is_defunct_;
   bool is_invalid_protocol_;
   bool is_registered_for_events_;
   bool is_available_;
+  bool is_result_decoding_deferred_;
 
   std::string auth_error_;
   std::string ssl_error_;
@@ -286,6 +312,8 @@ private:
   uv_loop_t* loop_;
   const Config& config_;
   Metrics* metrics_;
+  Metrics::HostMetrics* host_metrics_;
+  uint64_t* callback_count_;
   Address address_;
   std::string addr_string_;
   std::string keyspace_;
@@ -300,6 +300,11 @@ void ControlConnection::on_event(EventResponse* response) {
         case EventResponse::UPDATED:
           if (response->table().size() > 0) {
             refresh_table(response->keyspace(), response->table());
+            if (response->schema_change() == EventResponse::UPDATED) {
+              // Prepared statements have the table's old columns
+              session_->prepared_cache().remove_table(response->keyspace().to_string(),
+                                                      response->table().to_string());
+            }
           } else {
             refresh_keyspace(response->keyspace());
           }
@@ -309,8 +314,12 @@ void ControlConnection::on_event(EventResponse* response) {
           if (response->table().size() > 0) {
             session_->cluster_meta().drop_table(response->keyspace().to_string(),
                                                 response->table().to_string());
+            session_->prepared_cache().remove_table(response->keyspace().to_string(),
+                                                    response->table().to_string());
           } else {
             session_->cluster_meta().drop_keyspace(response->keyspace().to_string());
+            session_->prepared_cache().remove_table(response->keyspace().to_string(),
+                                                    std::string());
           }
           break;
       }
@@ -38,6 +38,7 @@ public:
       // If the prepared statement has result metadata then there is no
       // need to get the metadata with this request too.
       if (prepared->result()->result_metadata()) {
+        set_result_metadata(prepared->result()->result_metadata().get());
         set_skip_metadata(true);
       }
   }
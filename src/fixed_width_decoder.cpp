@@ -0,0 +1,225 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "fixed_width_decoder.hpp"
+
+#include "serialization.hpp"
+
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// Each item is a [short] size followed by the value so the values are
+// "width + 2" bytes apart. The vector kernels shuffle the values of several
+// items out of a single unaligned load, reversing their byte order, and check
+// the sizes that are between those values at the same time.
+//
+// All kernels rely on the input size being checked upfront so that they never
+// read past the last item. They also keep the invariant that the size of the
+// item at "item" has been validated before the start of each iteration.
+
+namespace cass {
+
+static inline bool is_valid_size(const char* item, size_t width) {
+  uint16_t size = 0;
+  decode_uint16(const_cast<char*>(item), size);
+  return size == width;
+}
+
+static bool decode_scalar(const char* item, int32_t count, size_t width,
+                          char* output) {
+  for (int32_t i = 0; i < count; ++i) {
+    if (!is_valid_size(item, width)) return false;
+    char* value = const_cast<char*>(item) + sizeof(uint16_t);
+    if (width == sizeof(int32_t)) {
+      int32_t v = 0;
+      decode_int32(value, v);
+      memcpy(output, &v, sizeof(int32_t));
+    } else {
+      cass_int64_t v = 0;
+      decode_int64(value, v);
+      memcpy(output, &v, sizeof(cass_int64_t));
+    }
+    item += sizeof(uint16_t) + width;
+    output += width;
+  }
+  return true;
+}
+
+static bool decode_fixed_width_4(const char* item, int32_t count, char* output) {
+  int32_t i = 0;
+
+  if (count > 0 && !is_valid_size(item, sizeof(int32_t))) return false;
+
+#if defined(__AVX2__)
+  {
+    const size_t stride = sizeof(uint16_t) + sizeof(int32_t);
+    // Two 16 byte loads of three items each. The values end up in dwords 0-2
+    // and the raw sizes of the second and third items end up in dword 3 of
+    // each lane.
+    const __m256i shuffle = _mm256_setr_epi8(3, 2, 1, 0, 9, 8, 7, 6, 15, 14, 13, 12, 4, 5, 10, 11,
+                                             3, 2, 1, 0, 9, 8, 7, 6, 15, 14, 13, 12, 4, 5, 10, 11);
+    const __m256i sizes = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 4,
+                                           0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 4);
+    const __m256i pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+    // The 32 byte store writes 8 values
+    while (i + 8 <= count) {
+      if (!is_valid_size(item + 3 * stride, sizeof(int32_t))) return false;
+
+      __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(item + sizeof(uint16_t)));
+      __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(item + 3 * stride + sizeof(uint16_t)));
+      __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1),
+                                      shuffle);
+
+      if ((static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, sizes))) & 0xF000F000) != 0xF000F000) {
+        return false;
+      }
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permutevar8x32_epi32(v, pack));
+
+      item += 6 * stride;
+      output += 6 * sizeof(int32_t);
+      i += 6;
+
+      if (!is_valid_size(item, sizeof(int32_t))) return false;
+    }
+  }
+#endif
+
+#if defined(__SSSE3__)
+  {
+    const size_t stride = sizeof(uint16_t) + sizeof(int32_t);
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 9, 8, 7, 6, 15, 14, 13, 12, 4, 5, 10, 11);
+    const __m128i sizes = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 4);
+
+    // The 16 byte store writes 4 values
+    while (i + 4 <= count) {
+      __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(item + sizeof(uint16_t))),
+                                   shuffle);
+
+      if ((_mm_movemask_epi8(_mm_cmpeq_epi8(v, sizes)) & 0xF000) != 0xF000) {
+        return false;
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output), v);
+
+      item += 3 * stride;
+      output += 3 * sizeof(int32_t);
+      i += 3;
+
+      if (!is_valid_size(item, sizeof(int32_t))) return false;
+    }
+  }
+#endif
+
+  return decode_scalar(item, count - i, sizeof(int32_t), output);
+}
+
+static bool decode_fixed_width_8(const char* item, int32_t count, char* output) {
+  int32_t i = 0;
+
+  if (count > 0 && !is_valid_size(item, sizeof(cass_int64_t))) return false;
+
+#if defined(__AVX2__)
+  {
+    const size_t stride = sizeof(uint16_t) + sizeof(cass_int64_t);
+    // Four 16 byte loads, one for each value. The first 8 bytes of a load are
+    // the value and the next 2 bytes are the size of the following item.
+    const __m256i shuffle = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                             7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m256i sizes = _mm256_setr_epi8(0, 8, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0,
+                                           0, 8, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0);
+
+    // The last load reads into the item after the last decoded item
+    while (i + 5 <= count) {
+      const char* value = item + sizeof(uint16_t);
+      __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value));
+      __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value + stride));
+      __m128i a2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value + 2 * stride));
+      __m128i a3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value + 3 * stride));
+
+      __m256i s = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpackhi_epi64(a0, a1)),
+                                          _mm_unpackhi_epi64(a2, a3), 1);
+      if ((static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, sizes))) & 0x03030303) != 0x03030303) {
+        return false;
+      }
+
+      __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi64(a0, a1)),
+                                          _mm_unpacklo_epi64(a2, a3), 1);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_shuffle_epi8(v, shuffle));
+
+      item += 4 * stride;
+      output += 4 * sizeof(cass_int64_t);
+      i += 4;
+    }
+  }
+#endif
+
+#if defined(__SSSE3__)
+  {
+    const size_t stride = sizeof(uint16_t) + sizeof(cass_int64_t);
+    const __m128i shuffle = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m128i sizes = _mm_setr_epi8(0, 8, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0, 0);
+
+    // The second load reads into the item after the last decoded item
+    while (i + 3 <= count) {
+      const char* value = item + sizeof(uint16_t);
+      __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value));
+      __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value + stride));
+
+      if ((_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_unpackhi_epi64(a0, a1), sizes)) & 0x0303) != 0x0303) {
+        return false;
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                       _mm_shuffle_epi8(_mm_unpacklo_epi64(a0, a1), shuffle));
+
+      item += 2 * stride;
+      output += 2 * sizeof(cass_int64_t);
+      i += 2;
+    }
+  }
+#endif
+
+  return decode_scalar(item, count - i, sizeof(cass_int64_t), output);
+}
+
+bool decode_fixed_width_collection(const char* input, size_t input_size,
+                                   int32_t count, size_t width,
+                                   char* output) {
+  if (count < 0 ||
+      input_size != static_cast<size_t>(count) * (sizeof(uint16_t) + width)) {
+    return false;
+  }
+
+  switch (width) {
+    case sizeof(int32_t):
+      return decode_fixed_width_4(input, count, output);
+    case sizeof(cass_int64_t):
+      return decode_fixed_width_8(input, count, output);
+    default:
+      return false;
+  }
+}
+
+} // namespace cass
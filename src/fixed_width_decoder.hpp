@@ -0,0 +1,40 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_FIXED_WIDTH_DECODER_HPP_INCLUDED__
+#define __CASS_FIXED_WIDTH_DECODER_HPP_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cass {
+
+// Decodes the items of a collection with fixed width elements (4 or 8 bytes)
+// into a contiguous array of host order values. The input is the collection's
+// items without the item count, each item is a [short] size followed by the
+// big-endian value. Returns false if any of the items don't have the
+// expected size. The output must have room for "count" elements.
+//
+// The AVX2 or SSSE3 (a subset of SSE4) kernels are used when the driver is
+// compiled with support for those instruction sets (e.g. -mavx2 or -msse4),
+// otherwise items are decoded using a scalar loop.
+bool decode_fixed_width_collection(const char* input, size_t input_size,
+                                   int32_t count, size_t width,
+                                   char* output);
+
+} // namespace cass
+
+#endif
@@ -78,19 +78,23 @@ const CassPrepared* cass_future_get_prepared(CassFuture* future) {
   if (response_future->is_error()) {
     return NULL;
   }
-  cass::ScopedPtr<cass::ResultResponse> result(
-      static_cast<cass::ResultResponse*>(response_future->release_result()));
-  if (result && result->kind() == CASS_RESULT_KIND_PREPARED) {
-    std::vector<std::string> key_aliases;
-    response_future->schema.get_table_key_columns(result->keyspace(), result->table(), &key_aliases);
-    cass::Prepared* prepared =
-        new cass::Prepared(result.release(), response_future->statement, key_aliases);
+  cass::SharedRefPtr<const cass::Prepared> prepared(response_future->release_prepared());
+  if (prepared) {
     prepared->inc_ref();
-    return CassPrepared::to(prepared);
+    return CassPrepared::to(prepared.get());
   }
   return NULL;
 }
 
+cass_bool_t cass_future_cancel(CassFuture* future) {
+  if (future->type() != cass::CASS_FUTURE_TYPE_RESPONSE) {
+    return cass_false;
+  }
+  cass::ResponseFuture* response_future =
+      static_cast<cass::ResponseFuture*>(future->from());
+  return static_cast<cass_bool_t>(response_future->cancel());
+}
+
 CassError cass_future_error_code(CassFuture* future) {
   const cass::Future::Error* error = future->get_error();
   if (error != NULL) {
@@ -133,25 +137,26 @@ bool Future::set_callback(Future::Callback callback, void* data) {
   return true;
 }
 
-void Future::internal_set(ScopedMutex& lock) {
+void Future::internal_set(ScopedMutex& lock, uv_loop_t* loop) {
+  if (is_set_) return;
   is_set_ = true;
   uv_cond_broadcast(&cond_);
   if (callback_) {
-    if (loop_.load() == NULL) {
+    if (loop == NULL) {
       Callback callback = callback_;
       void* data = data_;
       lock.unlock();
       callback(CassFuture::to(this), data);
     } else {
-      run_callback_on_work_thread();
+      run_callback_on_work_thread(loop);
     }
   }
 }
 
-void Future::run_callback_on_work_thread() {
+void Future::run_callback_on_work_thread(uv_loop_t* loop) {
   inc_ref(); // Keep the future alive for the callback
   work_.data = this;
-  uv_queue_work(loop_.load(), &work_, on_work, on_after_work);
+  uv_queue_work(loop, &work_, on_work, on_after_work);
 }
 
 void Future::on_work(uv_work_t* work) {
@@ -122,17 +122,31 @@ protected:
     return is_set_;
   }
 
-  void internal_set(ScopedMutex& lock);
+  bool internal_is_set() const { return is_set_; }
+
+  // A future is only set once, later results and errors are ignored
+  void internal_set(ScopedMutex& lock) {
+    internal_set(lock, loop_.load());
+  }
+
+  // The callback is run directly if "loop" is NULL
+  void internal_set(ScopedMutex& lock, uv_loop_t* loop);
 
   void internal_set_error(CassError code, const std::string& message, ScopedMutex& lock) {
+    internal_set_error(code, message, lock, loop_.load());
+  }
+
+  void internal_set_error(CassError code, const std::string& message,
+                          ScopedMutex& lock, uv_loop_t* loop) {
+    if (is_set_) return;
     error_.reset(new Error(code, message));
-    internal_set(lock);
+    internal_set(lock, loop);
   }
 
   uv_mutex_t mutex_;
 
 private:
-  void run_callback_on_work_thread();
+  void run_callback_on_work_thread(uv_loop_t* loop);
   static void on_work(uv_work_t* work);
   static void on_after_work(uv_work_t* work, int status);
 
@@ -162,6 +176,10 @@ public:
 
   void set_result(Address address, T* result) {
     ScopedMutex lock(&mutex_);
+    if (internal_is_set()) {
+      delete result;
+      return;
+    }
     address_ = address;
     result_.reset(result);
     internal_set(lock);
@@ -175,6 +193,7 @@ public:
 
   void set_error_with_host_address(Address address, CassError code, const std::string& message) {
     ScopedMutex lock(&mutex_);
+    if (internal_is_set()) return;
     address_ = address;
     internal_set_error(code, message, lock);
   }
@@ -21,6 +21,7 @@
 #include "cassandra.h"
 #include "common.hpp"
 #include "list.hpp"
+#include "request_timeline.hpp"
 #include "scoped_ptr.hpp"
 
 #include <string>
@@ -112,6 +113,15 @@ public:
 
   virtual void start_request() {}
 
+  // The body of a successful result is skipped for handlers that don't
+  // need it. They get a response without a body in on_set().
+  virtual bool is_result_discarded() const { return false; }
+
+  // The timeout that's started when the request is written
+  virtual uint64_t request_timeout_ms(uint64_t default_timeout_ms) const {
+    return default_timeout_ms;
+  }
+
   virtual void on_set(ResponseMessage* response) = 0;
   virtual void on_error(CassError code, const std::string& message) = 0;
   virtual void on_timeout() = 0;
@@ -141,8 +151,22 @@ public:
     timer_.stop();
   }
 
+  // Only sampled requests have a timeline
+  RequestTimeline* timeline() const { return timeline_.get(); }
+
+  void enable_timeline() {
+    timeline_.reset(new RequestTimeline());
+  }
+
+  void record_stage(CassRequestStage stage) {
+    if (timeline_) {
+      timeline_->record(stage);
+    }
+  }
+
 protected:
   Connection* connection_;
+  ScopedPtr<RequestTimeline> timeline_;
 
 private:
   RequestTimer timer_;
@@ -0,0 +1,93 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "host_metrics_iterator.hpp"
+
+#include "session.hpp"
+#include "types.hpp"
+
+#include <string.h>
+
+extern "C" {
+
+CassIterator* cass_session_get_host_metrics(CassSession* session) {
+  return CassIterator::to(new cass::HostMetricsIterator(session->metrics()));
+}
+
+CassError cass_iterator_get_host_metrics(CassIterator* iterator,
+                                         CassHostMetrics* output) {
+  if (iterator->type() != CASS_ITERATOR_TYPE_HOST_METRICS) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  static_cast<cass::HostMetricsIterator*>(
+        iterator->from())->host_metrics(output);
+  return CASS_OK;
+}
+
+} // extern "C"
+
+namespace cass {
+
+bool HostMetricsIterator::next() {
+  if (is_first_) {
+    is_first_ = false;
+  } else if (current_ != host_metrics_.end()) {
+    ++current_;
+  }
+  return current_ != host_metrics_.end();
+}
+
+void HostMetricsIterator::host_metrics(CassHostMetrics* output) const {
+  assert(!is_first_ && current_ != host_metrics_.end());
+
+  const Address& address = current_->first;
+  if (address.family() == AF_INET) {
+    output->address = cass_inet_init_v4(
+          reinterpret_cast<const cass_uint8_t*>(&address.addr_in()->sin_addr));
+  } else {
+    output->address = cass_inet_init_v6(
+          reinterpret_cast<const cass_uint8_t*>(&address.addr_in6()->sin6_addr));
+  }
+  output->port = address.port();
+
+  const Metrics::HostMetrics* host_metrics = current_->second.get();
+
+  Metrics::Histogram::Snapshot snapshot;
+  memset(&snapshot, 0, sizeof(snapshot));
+  if (host_metrics->latencies) {
+    host_metrics->latencies->get_snapshot(&snapshot);
+  }
+
+  output->requests.min = snapshot.min;
+  output->requests.max = snapshot.max;
+  output->requests.mean = snapshot.mean;
+  output->requests.stddev = snapshot.stddev;
+  output->requests.median = snapshot.median;
+  output->requests.percentile_75th = snapshot.percentile_75th;
+  output->requests.percentile_95th = snapshot.percentile_95th;
+  output->requests.percentile_98th = snapshot.percentile_98th;
+  output->requests.percentile_99th = snapshot.percentile_99th;
+  output->requests.percentile_999th = snapshot.percentile_999th;
+
+  output->in_flight_requests = host_metrics->in_flight_requests.sum();
+  output->pending_requests = host_metrics->pending_requests.sum();
+  output->request_timeouts = host_metrics->timeouts.sum();
+  output->errors = host_metrics->errors.sum();
+  output->bytes_written = host_metrics->bytes_written.sum();
+  output->bytes_read = host_metrics->bytes_read.sum();
+}
+
+} // namespace cass
@@ -0,0 +1,47 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_HOST_METRICS_ITERATOR_HPP_INCLUDED__
+#define __CASS_HOST_METRICS_ITERATOR_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "iterator.hpp"
+#include "metrics.hpp"
+
+namespace cass {
+
+class HostMetricsIterator : public Iterator {
+public:
+  HostMetricsIterator(const Metrics* metrics)
+      : Iterator(CASS_ITERATOR_TYPE_HOST_METRICS)
+      , is_first_(true) {
+    metrics->get_host_metrics(&host_metrics_);
+    current_ = host_metrics_.begin();
+  }
+
+  virtual bool next();
+
+  void host_metrics(CassHostMetrics* output) const;
+
+private:
+  Metrics::HostMetricsMap host_metrics_;
+  Metrics::HostMetricsMap::const_iterator current_;
+  bool is_first_;
+};
+
+} // namespace cass
+
+#endif
@@ -0,0 +1,126 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "io_thread_group.hpp"
+
+#include "future.hpp"
+#include "logger.hpp"
+#include "types.hpp"
+
+#define IO_THREAD_QUEUE_SIZE 64
+
+extern "C" {
+
+CassIOThreadGroup* cass_io_thread_group_new(unsigned thread_count) {
+  cass::IOThreadGroup* group = new cass::IOThreadGroup(thread_count);
+  group->inc_ref();
+  return CassIOThreadGroup::to(group);
+}
+
+void cass_io_thread_group_free(CassIOThreadGroup* group) {
+  group->dec_ref();
+}
+
+} // extern "C"
+
+namespace cass {
+
+int IOThread::run_task(IOThreadEvent::Task task, void* data) {
+  int result = 0;
+  ScopedRefPtr<Future> future(new Future(CASS_FUTURE_TYPE_SESSION));
+
+  IOThreadEvent event;
+  event.task = task;
+  event.data = data;
+  event.result = &result;
+  event.future = future.get();
+  while (!send_event_async(event)) {
+    // Keep trying
+  }
+
+  future->wait();
+  return result;
+}
+
+void IOThread::close_async() {
+  while (!send_event_async(IOThreadEvent())) {
+    // Keep trying
+  }
+}
+
+void IOThread::on_event(const IOThreadEvent& event) {
+  if (event.task == NULL) {
+    close_handles();
+    return;
+  }
+  *event.result = event.task(event.data);
+  event.future->set();
+}
+
+IOThreadGroup::IOThreadGroup(unsigned thread_count)
+    : thread_count_(thread_count > 0 ? thread_count : 1)
+    , is_started_(false) {
+  uv_mutex_init(&mutex_);
+}
+
+IOThreadGroup::~IOThreadGroup() {
+  stop();
+  uv_mutex_destroy(&mutex_);
+}
+
+int IOThreadGroup::start() {
+  ScopedMutex lock(&mutex_);
+  if (is_started_) return 0;
+
+  LOG_INFO("Creating %u shared IO threads", thread_count_);
+
+  for (unsigned i = 0; i < thread_count_; ++i) {
+    ScopedPtr<IOThread> thread(new IOThread());
+    int rc = thread->init(IO_THREAD_QUEUE_SIZE);
+    if (rc != 0) {
+      lock.unlock();
+      stop();
+      return rc;
+    }
+    rc = thread->run();
+    if (rc != 0) {
+      lock.unlock();
+      stop();
+      return rc;
+    }
+    threads_.push_back(thread.release());
+  }
+
+  is_started_ = true;
+  return 0;
+}
+
+void IOThreadGroup::stop() {
+  // The sessions using the group hold a reference so their IO workers are
+  // already closed and the loops only have the threads' own handles.
+  for (IOThreadVec::iterator it = threads_.begin(),
+       end = threads_.end(); it != end; ++it) {
+    (*it)->close_async();
+  }
+  for (IOThreadVec::iterator it = threads_.begin(),
+       end = threads_.end(); it != end; ++it) {
+    (*it)->join();
+    delete *it;
+  }
+  threads_.clear();
+}
+
+} // namespace cass
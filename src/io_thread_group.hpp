@@ -0,0 +1,100 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_IO_THREAD_GROUP_HPP_INCLUDED__
+#define __CASS_IO_THREAD_GROUP_HPP_INCLUDED__
+
+#include "event_thread.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "scoped_lock.hpp"
+#include "scoped_ptr.hpp"
+
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+class Future;
+
+struct IOThreadEvent {
+  typedef int (*Task)(void* data);
+
+  IOThreadEvent()
+    : task(NULL)
+    , data(NULL)
+    , result(NULL)
+    , future(NULL) {}
+
+  Task task; // NULL closes the thread
+  void* data;
+  int* result;
+  Future* future;
+};
+
+// A thread that runs an event loop shared by the IO workers of several
+// sessions. The loop keeps running until the thread is closed.
+class IOThread : public EventThread<IOThreadEvent> {
+public:
+  int init(size_t queue_size) {
+    return EventThread<IOThreadEvent>::init(queue_size);
+  }
+
+  // Runs a task on the thread and waits for its result. Handles on the
+  // thread's loop can only be initialized by tasks. This must not be called
+  // from the thread itself.
+  int run_task(IOThreadEvent::Task task, void* data);
+
+  void close_async();
+
+private:
+  virtual void on_event(const IOThreadEvent& event);
+};
+
+// A group of IO threads that can be shared by several sessions. Each session
+// still has its own IO workers (with their own connection pools, keyspace
+// and prepared statements), but they run on the group's threads instead of
+// the session's own IO threads.
+class IOThreadGroup : public RefCounted<IOThreadGroup> {
+public:
+  IOThreadGroup(unsigned thread_count);
+  ~IOThreadGroup();
+
+  unsigned thread_count() const { return thread_count_; }
+
+  // Starts the threads the first time it's called
+  int start();
+
+  IOThread* thread(size_t index) { return threads_[index]; }
+
+private:
+  void stop();
+
+private:
+  typedef std::vector<IOThread*> IOThreadVec;
+
+  const unsigned thread_count_;
+  IOThreadVec threads_;
+  bool is_started_;
+  uv_mutex_t mutex_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(IOThreadGroup);
+};
+
+} // namespace cass
+
+#endif
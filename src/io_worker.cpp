@@ -17,24 +17,44 @@
 #include "io_worker.hpp"
 
 #include "config.hpp"
+#include "connection.hpp"
+#include "io_thread_group.hpp"
 #include "logger.hpp"
 #include "pool.hpp"
+#include "prepare_handler.hpp"
 #include "request_handler.hpp"
 #include "session.hpp"
 #include "scoped_lock.hpp"
 #include "timer.hpp"
 
+#include <algorithm>
+
 namespace cass {
 
-IOWorker::IOWorker(Session* session)
+// The interval in milliseconds of the timer used to measure loop lag
+static const uint64_t LOOP_LAG_TIMER_INTERVAL = 100;
+
+IOWorker::IOWorker(Session* session, IOThread* thread)
     : session_(session)
+    , thread_(thread)
     , config_(session->config())
     , metrics_(session->metrics())
     , protocol_version_(-1)
     , is_closing_(false)
     , pending_request_count_(0)
-    , request_queue_(config_.queue_size_io()) {
+    , closed_queue_count_(0)
+    , request_queue_(config_.queue_size_io())
+    , high_priority_request_queue_(config_.queue_size_io())
+    , last_prepare_time_(0)
+    , callback_count_(0)
+    , loop_lag_expected_time_(0) {
   prepare_.data = this;
+  loop_lag_timer_.data = this;
+  if (config_.request_timeline_sample_rate() > 0) {
+    // The queue holds one less than its size
+    timelines_.reset(new SPSCQueue<CassRequestTimeline>(
+                       config_.request_timeline_buffer_size() + 1));
+  }
   uv_mutex_init(&keyspace_mutex_);
   uv_mutex_init(&unavailable_addresses_mutex_);
 }
@@ -45,14 +65,33 @@ IOWorker::~IOWorker() {
 }
 
 int IOWorker::init() {
+  if (thread_ != NULL) {
+    set_external_loop(thread_->loop());
+    return thread_->run_task(on_init, this);
+  }
+  return internal_init();
+}
+
+int IOWorker::on_init(void* data) {
+  return static_cast<IOWorker*>(data)->internal_init();
+}
+
+int IOWorker::internal_init() {
   int rc = EventThread<IOWorkerEvent>::init(config_.queue_size_event());
   if (rc != 0) return rc;
   rc = request_queue_.init(loop(), this, &IOWorker::on_execute);
   if (rc != 0) return rc;
+  rc = high_priority_request_queue_.init(loop(), this, &IOWorker::on_execute);
+  if (rc != 0) return rc;
   rc = uv_prepare_init(loop(), &prepare_);
   if (rc != 0) return rc;
   rc = uv_prepare_start(&prepare_, on_prepare);
   if (rc != 0) return rc;
+  rc = uv_timer_init(loop(), &loop_lag_timer_);
+  if (rc != 0) return rc;
+  loop_lag_expected_time_ = uv_hrtime() + LOOP_LAG_TIMER_INTERVAL * 1000 * 1000;
+  rc = uv_timer_start(&loop_lag_timer_, on_loop_lag_timer,
+                      LOOP_LAG_TIMER_INTERVAL, LOOP_LAG_TIMER_INTERVAL);
   return rc;
 }
 
@@ -88,6 +127,25 @@ bool IOWorker::is_host_up(const Address& address) const {
   return it != pools_.end() && it->second->is_ready();
 }
 
+void IOWorker::get_table_key_columns(const std::string& keyspace,
+                                     const std::string& table,
+                                     std::vector<std::string>* output) const {
+  session_->get_table_key_columns(keyspace, table, output);
+}
+
+bool IOWorker::get_int64_token(const std::string& routing_key, int64_t* token) const {
+  return session_->get_int64_token(routing_key, token);
+}
+
+void IOWorker::add_prepared(const std::string& keyspace,
+                            const SharedRefPtr<const Prepared>& prepared) {
+  session_->prepared_cache().add(keyspace, prepared);
+}
+
+void IOWorker::remove_prepared(const std::string& id) {
+  session_->prepared_cache().remove_id(id);
+}
+
 void IOWorker::set_host_is_available(const Address& address, bool is_available) {
   ScopedMutex lock(&unavailable_addresses_mutex_);
   if (is_available) {
@@ -119,6 +177,10 @@ bool IOWorker::remove_pool_async(const Address& address, bool cancel_reconnect)
 }
 
 void IOWorker::close_async() {
+  // Both queues are closed so that the requests already queued are run
+  while (!high_priority_request_queue_.enqueue(NULL)) {
+    // Keep trying
+  }
   while (!request_queue_.enqueue(NULL)) {
     // Keep trying
   }
@@ -138,10 +200,23 @@ void IOWorker::add_pool(const Address& address, bool is_initial_connection) {
 }
 
 bool IOWorker::execute(RequestHandler* request_handler) {
+  if (request_handler->request()->priority() == CASS_REQUEST_PRIORITY_HIGH) {
+    return high_priority_request_queue_.enqueue(request_handler);
+  }
   return request_queue_.enqueue(request_handler);
 }
 
 void IOWorker::retry(RequestHandler* request_handler, RetryType retry_type) {
+  if (request_handler->is_cancelled()) {
+    request_handler->finish_cancelled();
+    return;
+  }
+
+  if (request_handler->is_expired()) {
+    request_handler->expire();
+    return;
+  }
+
   if (retry_type == RETRY_WITH_NEXT_HOST) {
     request_handler->next_host();
   }
@@ -157,7 +232,7 @@ void IOWorker::retry(RequestHandler* request_handler, RetryType retry_type) {
   PoolMap::iterator it = pools_.find(address);
   if (it != pools_.end() && it->second->is_ready()) {
     const SharedRefPtr<Pool>& pool = it->second;
-    Connection* connection = pool->borrow_connection();
+    Connection* connection = pool->borrow_connection(request_handler->request()->priority());
     if (connection != NULL) {
       if (!pool->write(connection, request_handler)) {
         retry(request_handler, RETRY_WITH_NEXT_HOST);
@@ -171,6 +246,14 @@ void IOWorker::retry(RequestHandler* request_handler, RetryType retry_type) {
 }
 
 void IOWorker::request_finished(RequestHandler* request_handler) {
+  RequestTimeline* timeline = request_handler->timeline();
+  if (timeline != NULL && timelines_) {
+    metrics_->sampled_request_timelines.inc();
+    metrics_->record_request_timeline(timeline->timeline);
+    if (!timelines_->enqueue(timeline->timeline)) {
+      metrics_->dropped_request_timelines.inc();
+    }
+  }
   pending_request_count_--;
   maybe_close();
   request_queue_.send();
@@ -180,10 +263,29 @@ void IOWorker::notify_pool_ready(Pool* pool) {
   if (pool->is_initial_connection()) {
     session_->notify_ready_async();
   } else if (!is_closing_ && pool->is_ready()){
+    if (config_.prepare_on_up_or_add_host() &&
+        session_->claim_prepare_on_host(pool->address())) {
+      prepare_all(pool);
+    }
     session_->notify_up_async(pool->address());
   }
 }
 
+void IOWorker::prepare_all(Pool* pool) {
+  Connection* connection = pool->borrow_connection();
+  if (connection == NULL) return;
+
+  PrepareAllHandler::QueryVec queries;
+  session_->prepared_cache().get_queries(connection->keyspace(), &queries);
+  if (queries.empty()) return;
+
+  LOG_DEBUG("Preparing %u statement%s on host %s",
+            static_cast<unsigned int>(queries.size()),
+            queries.size() > 1 ? "s" : "",
+            pool->address().to_string().c_str());
+  PrepareAllHandler::prepare_all(connection, queries);
+}
+
 void IOWorker::notify_pool_closed(Pool* pool) {
   Address address = pool->address(); // Not a reference on purpose
 
@@ -232,7 +334,13 @@ void IOWorker::maybe_close() {
 
 void IOWorker::maybe_notify_closed() {
   if (pools_.empty()) {
-    session_->notify_worker_closed_async();
+    if (thread_ != NULL) {
+      // A shared loop keeps running so the session is only notified once
+      // the handles are closed (see on_prepare_closed()).
+      inc_ref();
+    } else {
+      session_->notify_worker_closed_async();
+    }
     close_handles();
   }
 }
@@ -240,8 +348,12 @@ void IOWorker::maybe_notify_closed() {
 void IOWorker::close_handles() {
   EventThread<IOWorkerEvent>::close_handles();
   request_queue_.close_handles();
+  high_priority_request_queue_.close_handles();
   uv_prepare_stop(&prepare_);
-  uv_close(copy_cast<uv_prepare_t*, uv_handle_t*>(&prepare_), NULL);
+  uv_close(copy_cast<uv_prepare_t*, uv_handle_t*>(&prepare_),
+           thread_ != NULL ? on_prepare_closed : NULL);
+  uv_timer_stop(&loop_lag_timer_);
+  uv_close(copy_cast<uv_timer_t*, uv_handle_t*>(&loop_lag_timer_), NULL);
 
   for (PendingReconnectMap::iterator it = pending_reconnects_.begin(),
        end = pending_reconnects_.end(); it != end; ++it) {
@@ -259,6 +371,7 @@ void IOWorker::on_pending_pool_reconnect(Timer* timer) {
       static_cast<PendingReconnect*>(timer->data());
 
   IOWorker* io_worker = pending_reconnect->io_worker;
+  io_worker->callback_count_++;
 
   LOG_DEBUG("Reconnecting pool reconnect(%p timer(%p)) io_worker(%p)",
             static_cast<void*>(pending_reconnect),
@@ -271,6 +384,7 @@ void IOWorker::on_pending_pool_reconnect(Timer* timer) {
 }
 
 void IOWorker::on_event(const IOWorkerEvent& event) {
+  callback_count_++;
   switch (event.type) {
     case IOWorkerEvent::ADD_POOL: {
       // Stop any attempts to reconnect because add_pool() is going to attempt
@@ -305,29 +419,79 @@ void IOWorker::on_event(const IOWorkerEvent& event) {
   }
 }
 
+void IOWorker::on_prepare_closed(uv_handle_t* handle) {
+  // The other handles are closed in the same pass of the loop. The timer
+  // runs on the loop's next iteration once they're all closed.
+  IOWorker* io_worker = static_cast<IOWorker*>(handle->data);
+  Timer::start(io_worker->loop(), 0, io_worker, on_handles_closed);
+}
+
+void IOWorker::on_handles_closed(Timer* timer) {
+  IOWorker* io_worker = static_cast<IOWorker*>(timer->data());
+  io_worker->session_->notify_worker_closed_async();
+  io_worker->dec_ref();
+}
+
+#if UV_VERSION_MAJOR == 0
+void IOWorker::on_loop_lag_timer(uv_timer_t* timer, int status) {
+#else
+void IOWorker::on_loop_lag_timer(uv_timer_t* timer) {
+#endif
+  IOWorker* io_worker = static_cast<IOWorker*>(timer->data);
+  uint64_t now = uv_hrtime();
+  io_worker->callback_count_++;
+  if (now > io_worker->loop_lag_expected_time_) {
+    // Final measurement is in microseconds
+    io_worker->loop_metrics_.loop_lags.record_value(
+          (now - io_worker->loop_lag_expected_time_) / 1000);
+  } else {
+    io_worker->loop_metrics_.loop_lags.record_value(0);
+  }
+  // The repeating timer is rescheduled relative to when this callback runs
+  io_worker->loop_lag_expected_time_ = now + LOOP_LAG_TIMER_INTERVAL * 1000 * 1000;
+}
+
 #if UV_VERSION_MAJOR == 0
 void IOWorker::on_execute(uv_async_t* async, int status) {
 #else
 void IOWorker::on_execute(uv_async_t* async) {
 #endif
   IOWorker* io_worker = static_cast<IOWorker*>(async->data);
+  uint64_t start = uv_hrtime();
+
+  io_worker->callback_count_++;
+  io_worker->loop_metrics_.request_queue_depths.record_value(
+        io_worker->request_queue_size());
 
+  unsigned weight = std::max(io_worker->config().high_priority_weight(), 1U);
+  unsigned high_count = 0;
   RequestHandler* request_handler = NULL;
   size_t remaining = io_worker->config().max_requests_per_flush();
-  while (remaining != 0 && io_worker->request_queue_.dequeue(request_handler)) {
-    if (request_handler != NULL) {
-      io_worker->pending_request_count_++;
-      request_handler->set_io_worker(io_worker);
-      request_handler->retry(RETRY_WITH_CURRENT_HOST);
-    } else {
-      io_worker->is_closing_ = true;
-    }
+  while (remaining != 0 &&
+         dequeue_by_priority(io_worker->high_priority_request_queue_,
+                             io_worker->request_queue_,
+                             weight, &high_count, request_handler)) {
+    io_worker->start_request(request_handler);
     remaining--;
   }
 
+  // Final measurement is in microseconds
+  io_worker->loop_metrics_.execute_times.record_value((uv_hrtime() - start) / 1000);
+
   io_worker->maybe_close();
 }
 
+void IOWorker::start_request(RequestHandler* request_handler) {
+  if (request_handler != NULL) {
+    request_handler->record_stage(CASS_REQUEST_STAGE_IO_WORKER);
+    pending_request_count_++;
+    request_handler->set_io_worker(this);
+    request_handler->retry(RETRY_WITH_CURRENT_HOST);
+  } else if (++closed_queue_count_ == 2) {
+    is_closing_ = true;
+  }
+}
+
 #if UV_VERSION_MAJOR == 0
 void IOWorker::on_prepare(uv_prepare_t* prepare, int status) {
 #else
@@ -335,6 +499,17 @@ void IOWorker::on_prepare(uv_prepare_t* prepare) {
 #endif
   IOWorker* io_worker = static_cast<IOWorker*>(prepare->data);
 
+  uint64_t now = uv_hrtime();
+  if (io_worker->last_prepare_time_ != 0) {
+    // Final measurement is in microseconds
+    io_worker->loop_metrics_.iteration_times.record_value(
+          (now - io_worker->last_prepare_time_) / 1000);
+    io_worker->loop_metrics_.callbacks_per_iteration.record_value(
+          io_worker->callback_count_);
+  }
+  io_worker->last_prepare_time_ = now;
+  io_worker->callback_count_ = 0;
+
   for (PoolVec::iterator it = io_worker->pools_pending_flush_.begin(),
        end = io_worker->pools_pending_flush_.end(); it != end; ++it) {
     (*it)->flush();
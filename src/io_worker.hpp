@@ -24,6 +24,7 @@
 #include "event_thread.hpp"
 #include "logger.hpp"
 #include "metrics.hpp"
+#include "scoped_ptr.hpp"
 #include "spsc_queue.hpp"
 #include "timer.hpp"
 
@@ -34,7 +35,9 @@
 namespace cass {
 
 class Config;
+class IOThread;
 class Pool;
+class Prepared;
 class RequestHandler;
 class Session;
 class SSLContext;
@@ -56,11 +59,34 @@ struct IOWorkerEvent {
   bool cancel_reconnect;
 };
 
+// Dequeues high priority entries ahead of normal priority entries, but up to
+// "weight" in a row so that normal priority entries aren't starved.
+// "high_count" is the number of high priority entries dequeued since the last
+// normal priority entry and must start at 0.
+template <class Queue, class T>
+bool dequeue_by_priority(Queue& high, Queue& normal, unsigned weight,
+                         unsigned* high_count, T& data) {
+  if (*high_count < weight && high.dequeue(data)) {
+    ++*high_count;
+    return true;
+  }
+  *high_count = 0;
+  if (normal.dequeue(data)) {
+    return true;
+  }
+  if (high.dequeue(data)) {
+    *high_count = 1;
+    return true;
+  }
+  return false;
+}
+
 class IOWorker
     : public EventThread<IOWorkerEvent>
     , public RefCounted<IOWorker> {
 public:
-  IOWorker(Session* session);
+  // The worker runs on its own thread unless a shared IO thread is used
+  IOWorker(Session* session, IOThread* thread = NULL);
   ~IOWorker();
 
   int init();
@@ -86,12 +112,41 @@ public:
 
   bool is_host_up(const Address& address) const;
 
+  // Synchronized access to the session's schema metadata, token map and
+  // prepared cache
+  void get_table_key_columns(const std::string& keyspace,
+                             const std::string& table,
+                             std::vector<std::string>* output) const;
+  bool get_int64_token(const std::string& routing_key, int64_t* token) const;
+  void add_prepared(const std::string& keyspace,
+                    const SharedRefPtr<const Prepared>& prepared);
+  void remove_prepared(const std::string& id);
+
   bool add_pool_async(const Address& address, bool is_initial_connection);
   bool remove_pool_async(const Address& address, bool cancel_reconnect);
   void close_async();
 
   bool execute(RequestHandler* request_handler);
 
+  // Dequeues the timeline of a completed request that was sampled. Only a
+  // single thread can drain the timelines.
+  bool drain_timeline(CassRequestTimeline* output) {
+    return timelines_ && timelines_->dequeue(*output);
+  }
+
+  // Only recorded by the worker's loop thread
+  Metrics::IOWorkerMetrics* loop_metrics() { return &loop_metrics_; }
+  const Metrics::IOWorkerMetrics* loop_metrics() const { return &loop_metrics_; }
+
+  // The callbacks run by the worker's loop since the last prepare callback.
+  // The worker's connections count their socket and timer callbacks here.
+  uint64_t* callback_count() { return &callback_count_; }
+
+  // The approximate number of requests waiting in the request queues
+  size_t request_queue_size() const {
+    return request_queue_.size() + high_priority_request_queue_.size();
+  }
+
   void retry(RequestHandler* request_handler, RetryType retry_type);
   void request_finished(RequestHandler* request_handler);
 
@@ -101,21 +156,30 @@ public:
   void add_pending_flush(Pool* pool);
 
 private:
+  static int on_init(void* data);
+  int internal_init();
+
   void add_pool(const Address& address, bool is_initial_connection);
+  void start_request(RequestHandler* request_handler);
+  void prepare_all(Pool* pool);
   void maybe_close();
   void maybe_notify_closed();
   void close_handles();
 
   static void on_pending_pool_reconnect(Timer* timer);
+  static void on_prepare_closed(uv_handle_t* handle);
+  static void on_handles_closed(Timer* timer);
 
   virtual void on_event(const IOWorkerEvent& event);
 
 #if UV_VERSION_MAJOR == 0
   static void on_execute(uv_async_t* async, int status);
   static void on_prepare(uv_prepare_t *prepare, int status);
+  static void on_loop_lag_timer(uv_timer_t* timer, int status);
 #else
   static void on_execute(uv_async_t* async);
   static void on_prepare(uv_prepare_t *prepare);
+  static void on_loop_lag_timer(uv_timer_t* timer);
 #endif
 
 private:
@@ -138,6 +202,7 @@ private:
 
 private:
   Session* session_;
+  IOThread* thread_;
   const Config& config_;
   Metrics* metrics_;
   Atomic<int> protocol_version_;
@@ -153,9 +218,18 @@ private:
   PoolVec pools_pending_flush_;
   bool is_closing_;
   int pending_request_count_;
+  int closed_queue_count_;
   PendingReconnectMap pending_reconnects_;
 
   AsyncQueue<SPSCQueue<RequestHandler*> > request_queue_;
+  AsyncQueue<SPSCQueue<RequestHandler*> > high_priority_request_queue_;
+  ScopedPtr<SPSCQueue<CassRequestTimeline> > timelines_;
+
+  Metrics::IOWorkerMetrics loop_metrics_;
+  uint64_t last_prepare_time_;
+  uint64_t callback_count_;
+  uint64_t loop_lag_expected_time_;
+  uv_timer_t loop_lag_timer_;
 };
 
 } // namespace cass
@@ -37,6 +37,29 @@ void cass_log_set_queue_size(size_t queue_size) {
   // Deprecated
 }
 
+CassError cass_log_start_async(size_t queue_size) {
+  if (queue_size == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  if (cass::Logger::start_async(queue_size) != 0) {
+    return CASS_ERROR_LIB_UNABLE_TO_INIT;
+  }
+  return CASS_OK;
+}
+
+void cass_log_stop_async() {
+  cass::Logger::stop_async();
+}
+
+void cass_log_set_rate_limit(unsigned max_per_second) {
+  cass::Logger::set_rate_limit(max_per_second);
+}
+
+void cass_log_get_stats(CassLogStats* stats) {
+  stats->dropped = cass::Logger::dropped_count();
+  stats->rate_limited = cass::Logger::rate_limited_count();
+}
+
 } // extern "C"
 
 namespace cass {
@@ -52,22 +75,124 @@ void stderr_log_callback(const CassLogMessage* message, void* data) {
 
 void noop_log_callback(const CassLogMessage* message, void* data) { }
 
+class AsyncLogger : public LoopThread {
+public:
+  AsyncLogger(size_t queue_size)
+    : queue_(queue_size)
+    , is_closing_(false) {}
+
+  int start() {
+    int rc = init();
+    if (rc != 0) return rc;
+    rc = queue_.init(loop(), this, on_message);
+    if (rc != 0) return rc;
+    return run();
+  }
+
+  bool enqueue(const CassLogMessage& message) {
+    return queue_.enqueue(message);
+  }
+
+  // Delivers the messages that are already queued and joins the thread
+  void stop() {
+    is_closing_.store(true);
+    queue_.send();
+    join();
+  }
+
+private:
+#if UV_VERSION_MAJOR == 0
+  static void on_message(uv_async_t* async, int status) {
+#else
+  static void on_message(uv_async_t* async) {
+#endif
+    AsyncLogger* logger = static_cast<AsyncLogger*>(async->data);
+    CassLogMessage message;
+    while (logger->queue_.dequeue(message)) {
+      Logger::cb_(&message, Logger::data_);
+    }
+    if (logger->is_closing_.load()) {
+      logger->queue_.close_handles();
+      logger->close_handles();
+    }
+  }
+
+private:
+  AsyncQueue<MPMCQueue<CassLogMessage> > queue_;
+  Atomic<bool> is_closing_;
+};
+
 CassLogLevel Logger::log_level_ = CASS_LOG_WARN;
 CassLogCallback Logger::cb_ = stderr_log_callback;
 void* Logger::data_ = NULL;
+AsyncLogger* Logger::async_logger_ = NULL;
+unsigned Logger::rate_limit_ = 0;
+Logger::RateLimitSlot Logger::rate_limit_slots_[RATE_LIMIT_SLOT_COUNT];
+Atomic<uint64_t> Logger::dropped_count_(0);
+Atomic<uint64_t> Logger::rate_limited_count_(0);
 
 void Logger::log(CassLogLevel severity,
                  const char* file, int line, const char* function,
                  const char* format, va_list args) {
+  // The limit is checked before formatting so that a message that's logged
+  // too often costs as little as possible
+  if (rate_limit_ > 0 && is_rate_limited(file, line)) {
+    rate_limited_count_.fetch_add(1);
+    return;
+  }
+
   CassLogMessage message = {
     get_time_since_epoch_ms(), severity,
     file, line, function,
     ""
   };
   vsnprintf(message.message, sizeof(message.message), format, args);
+
+  if (async_logger_ != NULL) {
+    if (!async_logger_->enqueue(message)) {
+      dropped_count_.fetch_add(1);
+    }
+    return;
+  }
+
   Logger::cb_(&message, Logger::data_);
 }
 
+bool Logger::is_rate_limited(const char* file, int line) {
+  size_t hash = reinterpret_cast<size_t>(file) ^ (static_cast<size_t>(line) * 2654435761U);
+  RateLimitSlot& slot = rate_limit_slots_[hash % RATE_LIMIT_SLOT_COUNT];
+
+  // The messages are counted in one second windows. The first thread to see
+  // a new window resets the count.
+  uint64_t window = uv_hrtime() / (1000 * 1000 * 1000);
+  uint64_t current = slot.window.load();
+  if (current != window && slot.window.compare_exchange_strong(current, window)) {
+    slot.count.store(0);
+  }
+  return slot.count.fetch_add(1) >= rate_limit_;
+}
+
+int Logger::start_async(size_t queue_size) {
+  if (async_logger_ != NULL) return 0;
+  ScopedPtr<AsyncLogger> async_logger(new AsyncLogger(queue_size));
+  int rc = async_logger->start();
+  if (rc != 0) return rc;
+  async_logger_ = async_logger.release();
+  return 0;
+}
+
+void Logger::stop_async() {
+  if (async_logger_ == NULL) return;
+  AsyncLogger* async_logger = async_logger_;
+  async_logger_ = NULL;
+  async_logger->stop();
+  delete async_logger;
+}
+
+void Logger::set_rate_limit(unsigned max_per_second) {
+  rate_limit_ = max_per_second;
+}
+
 void Logger::set_log_level(CassLogLevel log_level) {
   log_level_ = log_level;
 }
@@ -18,6 +18,7 @@
 #define __CASS_LOGGER_HPP_INCLUDED__
 
 #include "async_queue.hpp"
+#include "atomic.hpp"
 #include "cassandra.h"
 #include "get_time.hpp"
 #include "loop_thread.hpp"
@@ -30,11 +31,26 @@
 
 namespace cass {
 
+class AsyncLogger;
+
 class Logger {
 public:
   static void set_log_level(CassLogLevel level);
   static void set_callback(CassLogCallback cb, void* data);
 
+  // The callback is called by a background thread that delivers the messages
+  // from a bounded queue. Messages are dropped if the queue is full. Neither
+  // can be called while other threads are logging.
+  static int start_async(size_t queue_size);
+  static void stop_async();
+
+  // Limits the messages logged each second from each call site (file and
+  // line). Zero disables the limit.
+  static void set_rate_limit(unsigned max_per_second);
+
+  static uint64_t dropped_count() { return dropped_count_.load(); }
+  static uint64_t rate_limited_count() { return rate_limited_count_.load(); }
+
 #if defined(__GNUC__) || defined(__clang__)
 #define ATTR_FORMAT(string, first) __attribute__((__format__(__printf__, string, first)))
 #else
@@ -60,9 +76,32 @@ private:
                   const char* format, va_list args);
 
 private:
+  friend class AsyncLogger;
+
+  static bool is_rate_limited(const char* file, int line);
+
+private:
+  // Call sites are hashed into a fixed number of slots. Sites that share a
+  // slot also share their rate limit.
+  static const size_t RATE_LIMIT_SLOT_COUNT = 256;
+
+  struct RateLimitSlot {
+    RateLimitSlot()
+      : window(0)
+      , count(0) {}
+
+    Atomic<uint64_t> window;
+    Atomic<unsigned> count;
+  };
+
   static CassLogLevel log_level_;
   static CassLogCallback cb_;
   static void* data_;
+  static AsyncLogger* async_logger_;
+  static unsigned rate_limit_;
+  static RateLimitSlot rate_limit_slots_[RATE_LIMIT_SLOT_COUNT];
+  static Atomic<uint64_t> dropped_count_;
+  static Atomic<uint64_t> rate_limited_count_;
 
   Logger(); // Keep this object from being created
 };
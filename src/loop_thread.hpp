@@ -17,6 +17,7 @@
 #ifndef __CASS_LOOP_THREAD_HPP_INCLUDED__
 #define __CASS_LOOP_THREAD_HPP_INCLUDED__
 
+#include "common.hpp"
 #include "macros.hpp"
 
 #include <assert.h>
@@ -32,6 +33,7 @@ public:
 #else
       : is_loop_initialized_(false)
 #endif
+      , external_loop_(NULL)
       , is_joinable_(false) {}
 
   virtual ~LoopThread() { 
@@ -44,7 +46,18 @@ public:
 #endif
   }
 
+  // Uses a loop that's run by another thread instead of the thread's own loop.
+  // The thread isn't started by run() and handles must be initialized on the
+  // loop's thread. Must be called before init().
+  void set_external_loop(uv_loop_t* loop) {
+    external_loop_ = loop;
+  }
+
+  bool has_external_loop() const { return external_loop_ != NULL; }
+
   int init() {
+    if (external_loop_ != NULL) return 0;
+
     int rc = 0;
 #if UV_VERSION_MAJOR > 0
     rc = uv_loop_init(&loop_);
@@ -61,6 +74,7 @@ public:
   }
 
   void close_handles() {
+    if (external_loop_ != NULL) return;
 #if !defined(_WIN32)
     uv_signal_stop(&sigpipe_);
     uv_close(copy_cast<uv_signal_t*, uv_handle_t*>(&sigpipe_), NULL);
@@ -68,12 +82,13 @@ public:
   }
 
 #if UV_VERSION_MAJOR == 0
-  uv_loop_t* loop() { return loop_; }
+  uv_loop_t* loop() { return external_loop_ != NULL ? external_loop_ : loop_; }
 #else
-  uv_loop_t* loop() { return &loop_; }
+  uv_loop_t* loop() { return external_loop_ != NULL ? external_loop_ : &loop_; }
 #endif
 
   int run() {
+    if (external_loop_ != NULL) return 0;
     int rc = uv_thread_create(&thread_, on_run_internal, this);
     if (rc == 0) is_joinable_ = true;
     return rc;
@@ -112,6 +127,7 @@ private:
   uv_loop_t loop_;
   bool is_loop_initialized_;
 #endif
+  uv_loop_t* external_loop_;
 
   uv_thread_t thread_;
   bool is_joinable_;
@@ -0,0 +1,204 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "metrics.hpp"
+
+#include <vector>
+
+#if UV_VERSION_MAJOR >= 1
+
+#if !defined(WIN32) && !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+namespace cass {
+
+// The slots of a thread state. Slots are shared with the threads that are
+// assigned them so the registry outlives the thread state until those threads
+// exit.
+class ThreadSlotRegistry : public RefCounted<ThreadSlotRegistry> {
+public:
+  ThreadSlotRegistry()
+    : slot_count_(0) {
+    uv_mutex_init(&mutex_);
+  }
+
+  ~ThreadSlotRegistry() {
+    uv_mutex_destroy(&mutex_);
+  }
+
+  size_t acquire() {
+    ScopedMutex l(&mutex_);
+    if (!free_slots_.empty()) {
+      size_t id = free_slots_.back();
+      free_slots_.pop_back();
+      return id;
+    }
+    return slot_count_++;
+  }
+
+  void release(size_t id) {
+    ScopedMutex l(&mutex_);
+    free_slots_.push_back(id);
+  }
+
+  size_t thread_count() const {
+    ScopedMutex l(&mutex_);
+    return slot_count_ - free_slots_.size();
+  }
+
+  size_t slot_count() const {
+    ScopedMutex l(&mutex_);
+    return slot_count_;
+  }
+
+private:
+  mutable uv_mutex_t mutex_;
+  size_t slot_count_;
+  std::vector<size_t> free_slots_;
+};
+
+// A slot assigned to the current thread. Each thread keeps a list of its
+// slots so that they can be released when the thread exits.
+struct ThreadSlotEntry {
+  Metrics::ThreadState::Slot slot;
+  size_t id;
+  ThreadSlotRegistry* registry;
+  ThreadSlotEntry* next;
+};
+
+static void release_thread_slots(ThreadSlotEntry* entries) {
+  while (entries != NULL) {
+    ThreadSlotEntry* next = entries->next;
+    entries->registry->release(entries->id);
+    entries->registry->dec_ref();
+    delete entries;
+    entries = next;
+  }
+}
+
+// libuv's thread-local keys don't have destructors so the platform's keys are
+// used to find out when threads exit
+#if defined(WIN32) || defined(_WIN32)
+static DWORD thread_exit_key = FLS_OUT_OF_INDEXES;
+
+static void WINAPI on_thread_exit(void* entries) {
+  release_thread_slots(static_cast<ThreadSlotEntry*>(entries));
+}
+
+static void init_thread_exit_key() {
+  thread_exit_key = FlsAlloc(on_thread_exit);
+}
+
+static ThreadSlotEntry* get_thread_slots() {
+  return static_cast<ThreadSlotEntry*>(FlsGetValue(thread_exit_key));
+}
+
+static void set_thread_slots(ThreadSlotEntry* entries) {
+  FlsSetValue(thread_exit_key, entries);
+}
+#else
+static pthread_key_t thread_exit_key;
+
+static void on_thread_exit(void* entries) {
+  release_thread_slots(static_cast<ThreadSlotEntry*>(entries));
+}
+
+static void init_thread_exit_key() {
+  pthread_key_create(&thread_exit_key, on_thread_exit);
+}
+
+static ThreadSlotEntry* get_thread_slots() {
+  return static_cast<ThreadSlotEntry*>(pthread_getspecific(thread_exit_key));
+}
+
+static void set_thread_slots(ThreadSlotEntry* entries) {
+  pthread_setspecific(thread_exit_key, entries);
+}
+#endif
+
+static uv_once_t thread_exit_key_guard = UV_ONCE_INIT;
+
+// Removes the slots of thread states that have been destroyed. Only the
+// thread's own entry refers to their registries.
+static ThreadSlotEntry* remove_unused_slots(ThreadSlotEntry* entries) {
+  ThreadSlotEntry** next = &entries;
+  while (*next != NULL) {
+    ThreadSlotEntry* entry = *next;
+    if (entry->registry->ref_count() == 1) {
+      *next = entry->next;
+      entry->registry->dec_ref();
+      delete entry;
+    } else {
+      next = &entry->next;
+    }
+  }
+  return entries;
+}
+
+Metrics::ThreadState::ThreadState(size_t initial_threads)
+  : initial_threads_(std::max(initial_threads, static_cast<size_t>(1)))
+  , chunk_count_(0)
+  , registry_(new ThreadSlotRegistry()) {
+  registry_->inc_ref();
+  uv_key_create(&slot_key_);
+}
+
+Metrics::ThreadState::~ThreadState() {
+  uv_key_delete(&slot_key_);
+  registry_->dec_ref();
+}
+
+size_t Metrics::ThreadState::thread_count() const {
+  return registry_->thread_count();
+}
+
+size_t Metrics::ThreadState::slot_count() const {
+  return registry_->slot_count();
+}
+
+void* Metrics::ThreadState::register_thread() {
+  uv_once(&thread_exit_key_guard, init_thread_exit_key);
+
+  ThreadSlotEntry* entry = new ThreadSlotEntry();
+  entry->id = registry_->acquire();
+  entry->registry = registry_;
+  registry_->inc_ref();
+
+  size_t chunk = 0;
+  size_t offset = entry->id;
+  while (offset >= chunk_size(chunk)) {
+    offset -= chunk_size(chunk);
+    ++chunk;
+  }
+  assert(chunk < MAX_CHUNKS);
+  entry->slot.chunk = chunk;
+  entry->slot.offset = offset;
+
+  size_t count = chunk_count_.load();
+  while (count <= chunk && !chunk_count_.compare_exchange_strong(count, chunk + 1)) {}
+
+  entry->next = remove_unused_slots(get_thread_slots());
+  set_thread_slots(entry);
+  uv_key_set(&slot_key_, &entry->slot);
+
+  return &entry->slot;
+}
+
+} // namespace cass
+
+#endif
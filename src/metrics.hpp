@@ -20,7 +20,10 @@
 #ifndef __CASS_METRICS_HPP_INCLUDED__
 #define __CASS_METRICS_HPP_INCLUDED__
 
+#include "address.hpp"
 #include "atomic.hpp"
+#include "cassandra.h"
+#include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
 #include "scoped_lock.hpp"
 
@@ -28,6 +31,7 @@
 
 #include <uv.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if defined(WIN32) || defined(_WIN32)
 #ifndef _WINSOCKAPI_
@@ -38,85 +42,197 @@
 #include <sched.h>
 #endif
 
+#include <algorithm>
 #include <limits>
+#include <map>
 #include <math.h>
 
 namespace cass {
 
+class ThreadSlotRegistry;
+
 class Metrics {
 public:
+  // Assigns each recording thread a slot in the per-thread storage of the
+  // metrics. Slots are assigned the first time a thread records a value and
+  // are reused by other threads once the thread exits, so any number of
+  // threads (IO threads, application threads and callback threads) can record
+  // values.
   class ThreadState {
   public:
+    // The location of a slot in the chunks of per-thread storage. Chunk "n"
+    // has room for "initial_threads << n" slots.
+    struct Slot {
+      size_t chunk;
+      size_t offset;
+    };
+
+    static const size_t MAX_CHUNKS = 32;
+
 #if UV_VERSION_MAJOR == 0
-    ThreadState()
-      : max_threads_(1) {}
+    ThreadState() {
+      slot_.chunk = 0;
+      slot_.offset = 0;
+    }
+
+    size_t chunk_count() const { return 1; }
+
+    size_t chunk_size(size_t chunk) const { return 1; }
+
+    const Slot& current_slot() { return slot_; }
 #else
-    ThreadState(size_t max_threads)
-      : max_threads_(max_threads)
-      , thread_count_(1) {
-      uv_key_create(&thread_id_key_);
+    // The first chunk has room for "initial_threads" slots
+    ThreadState(size_t initial_threads);
+    ~ThreadState();
+
+    // The number of chunks that have slots assigned to threads
+    size_t chunk_count() const {
+      return chunk_count_.load(MEMORY_ORDER_ACQUIRE);
     }
-#endif
 
-#if UV_VERSION_MAJOR >= 1
-    ~ThreadState() {
-      uv_key_delete(&thread_id_key_);
+    size_t chunk_size(size_t chunk) const {
+      return initial_threads_ << chunk;
     }
-#endif
 
-    size_t max_threads() const {
-      return max_threads_;
+    const Slot& current_slot() {
+      void* entry = uv_key_get(&slot_key_);
+      if (entry == NULL) {
+        entry = register_thread();
+      }
+      return *static_cast<const Slot*>(entry);
     }
 
-    size_t current_thread_id() {
+    // The number of slots that are assigned to threads
+    size_t thread_count() const;
+
+    // The number of slots that have ever been assigned
+    size_t slot_count() const;
+#endif
+
+  private:
 #if UV_VERSION_MAJOR == 0
-      return 0;
+    Slot slot_;
 #else
-      void* id = uv_key_get(&thread_id_key_);
-      if (id == NULL) {
-        size_t thread_id = thread_count_.fetch_add(1);
-        assert(thread_id <= max_threads_);
-        id = reinterpret_cast<void*>(thread_id);
-        uv_key_set(&thread_id_key_, id);
-      }
-      return reinterpret_cast<size_t>(id) - 1;
+    void* register_thread();
+
+    const size_t initial_threads_;
+    Atomic<size_t> chunk_count_;
+    ThreadSlotRegistry* registry_;
+    uv_key_t slot_key_;
 #endif
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ThreadState);
+  };
+
+  struct NoInit {
+    template <class T>
+    void operator()(T* value) const {}
+  };
+
+  // The per-thread storage of a metric. Chunks are allocated as threads are
+  // assigned slots in them so existing slots never move and recording threads
+  // never take a lock. "Init" is called for each element of a new chunk.
+  template <class T, class Init = NoInit>
+  class PerThread {
+  public:
+    PerThread(ThreadState* thread_state, const Init& init = Init())
+      : thread_state_(thread_state)
+      , init_(init) {
+      for (size_t i = 0; i < ThreadState::MAX_CHUNKS; ++i) {
+        chunks_[i].store(NULL, MEMORY_ORDER_RELAXED);
+      }
+    }
+
+    ~PerThread() {
+      for (size_t i = 0; i < ThreadState::MAX_CHUNKS; ++i) {
+        delete[] chunks_[i].load(MEMORY_ORDER_RELAXED);
+      }
+    }
+
+    T& current() {
+      const ThreadState::Slot& slot = thread_state_->current_slot();
+      T* chunk = chunks_[slot.chunk].load(MEMORY_ORDER_ACQUIRE);
+      if (chunk == NULL) {
+        chunk = allocate_chunk(slot.chunk);
+      }
+      return chunk[slot.offset];
+    }
+
+    size_t chunk_count() const {
+      return thread_state_->chunk_count();
+    }
+
+    // NULL if no thread has used the chunk yet
+    T* chunk(size_t index, size_t* size) const {
+      *size = thread_state_->chunk_size(index);
+      return chunks_[index].load(MEMORY_ORDER_ACQUIRE);
     }
 
   private:
-    const size_t max_threads_;
-#if UV_VERSION_MAJOR >= 1
-    Atomic<size_t> thread_count_;
-    uv_key_t thread_id_key_;
-#endif
+    T* allocate_chunk(size_t index) {
+      size_t size = thread_state_->chunk_size(index);
+      T* chunk = new T[size];
+      for (size_t i = 0; i < size; ++i) {
+        init_(&chunk[i]);
+      }
+      T* expected = NULL;
+      if (!chunks_[index].compare_exchange_strong(expected, chunk)) {
+        // Another thread allocated the chunk first
+        delete[] chunk;
+        chunk = expected;
+      }
+      return chunk;
+    }
+
+    ThreadState* thread_state_;
+    const Init init_;
+    Atomic<T*> chunks_[ThreadState::MAX_CHUNKS];
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(PerThread);
   };
 
   class Counter {
   public:
     Counter(ThreadState* thread_state)
-      : thread_state_(thread_state)
-      , counters_(new PerThreadCounter[thread_state->max_threads()]) {}
+      : counters_(thread_state) {}
 
     void inc() {
-      counters_[thread_state_->current_thread_id()].add(1LL);
+      counters_.current().add(1LL);
+    }
+
+    void add(int64_t n) {
+      counters_.current().add(n);
     }
 
     void dec() {
-      counters_[thread_state_->current_thread_id()].sub(1LL);
+      counters_.current().sub(1LL);
     }
 
+    // The values of threads that have exited are kept in their slots
     int64_t sum() const {
       int64_t sum = 0;
-      for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
-        sum += counters_[i].get();
+      for (size_t i = 0; i < counters_.chunk_count(); ++i) {
+        size_t size;
+        const PerThreadCounter* counters = counters_.chunk(i, &size);
+        if (counters == NULL) continue;
+        for (size_t j = 0; j < size; ++j) {
+          sum += counters[j].get();
+        }
       }
       return sum;
     }
 
     int64_t sum_and_reset() {
       int64_t sum = 0;
-      for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
-        sum += counters_[i].get_and_reset();
+      for (size_t i = 0; i < counters_.chunk_count(); ++i) {
+        size_t size;
+        PerThreadCounter* counters = counters_.chunk(i, &size);
+        if (counters == NULL) continue;
+        for (size_t j = 0; j < size; ++j) {
+          sum += counters[j].get_and_reset();
+        }
       }
       return sum;
     }
@@ -152,8 +268,7 @@ public:
     };
 
   private:
-    ThreadState* thread_state_;
-    ScopedPtr<PerThreadCounter[]> counters_;
+    PerThread<PerThreadCounter> counters_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Counter);
@@ -268,7 +383,11 @@ public:
   public:
     static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
 
+    // The number of cumulative buckets used to export histograms
+    static const size_t BUCKET_COUNT = 16;
+
     struct Snapshot {
+      int64_t count;
       int64_t min;
       int64_t max;
       int64_t mean;
@@ -281,15 +400,22 @@ public:
       int64_t percentile_999th;
     };
 
-    Histogram(ThreadState* thread_state)
-      : thread_state_(thread_state)
-      , histograms_(new PerThreadHistogram[thread_state->max_threads()]) {
-      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+    // Values above "highest_trackable_value" are recorded as that value. A
+    // smaller range or fewer significant figures use less memory.
+    Histogram(ThreadState* thread_state,
+              int64_t highest_trackable_value = HIGHEST_TRACKABLE_VALUE,
+              int significant_figures = 3)
+      : highest_trackable_value_(highest_trackable_value)
+      , histograms_(thread_state, InitPerThreadHistogram(highest_trackable_value,
+                                                         significant_figures)) {
+      hdr_init(1LL, highest_trackable_value, significant_figures, &histogram_);
+      hdr_init(1LL, highest_trackable_value, significant_figures, &interval_histogram_);
       uv_mutex_init(&mutex_);
     }
 
     ~Histogram() {
       free(histogram_);
+      free(interval_histogram_);
       uv_mutex_destroy(&mutex_);
     }
 
@@ -298,15 +424,62 @@ public:
 #if UV_VERSION_MAJOR == 0
       ScopedMutex l(&mutex_);
 #endif
-      histograms_[thread_state_->current_thread_id()].record_value(value);
+      histograms_.current().record_value(std::min(value, highest_trackable_value_));
+    }
+
+    // The inclusive upper bound in microseconds of a bucket. The buckets
+    // follow a 1-2-5 series from 100 us to 10 s.
+    static int64_t bucket_bound(size_t index) {
+      static const int64_t steps[] = { 1, 2, 5 };
+      int64_t bound = 100 * steps[index % 3];
+      for (size_t i = 0; i < index / 3; ++i) {
+        bound *= 10;
+      }
+      return bound;
+    }
+
+    // The values recorded since the histogram was created. The bucket counts
+    // are only computed when "buckets" isn't NULL. It must have room for
+    // BUCKET_COUNT cumulative counts.
+    void get_snapshot(Snapshot* snapshot, int64_t* buckets = NULL) const {
+      ScopedMutex l(&mutex_);
+      collect();
+      get_snapshot(histogram_, snapshot, buckets);
     }
 
-    void get_snapshot(Snapshot* snapshot) const {
+    // The values recorded since the previous interval snapshot. The interval
+    // is reset by taking the snapshot so there should only be a single
+    // reader of the intervals.
+    void get_interval_snapshot(Snapshot* snapshot, int64_t* buckets = NULL) const {
       ScopedMutex l(&mutex_);
-      hdr_histogram* h = histogram_;
-      for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
-        histograms_[i].add(h);
+      collect();
+      get_snapshot(interval_histogram_, snapshot, buckets);
+      hdr_reset(interval_histogram_);
+    }
+
+  private:
+    // Moves the values recorded by each thread into the cumulative and
+    // interval histograms. Recording threads aren't blocked.
+    void collect() const {
+      for (size_t i = 0; i < histograms_.chunk_count(); ++i) {
+        size_t size;
+        PerThreadHistogram* histograms = histograms_.chunk(i, &size);
+        if (histograms == NULL) continue;
+        for (size_t j = 0; j < size; ++j) {
+          histograms[j].move_to(histogram_, interval_histogram_);
+        }
+      }
+    }
+
+    static void get_snapshot(hdr_histogram* h, Snapshot* snapshot, int64_t* buckets) {
+      if (buckets != NULL) {
+        get_buckets(h, buckets);
       }
+      if (h->total_count == 0) {
+        memset(snapshot, 0, sizeof(Snapshot));
+        return;
+      }
+      snapshot->count = h->total_count;
       snapshot->min = hdr_min(h);
       snapshot->max = hdr_max(h);
       snapshot->mean = static_cast<int64_t>(hdr_mean(h));
@@ -319,12 +492,31 @@ public:
       snapshot->percentile_999th = hdr_value_at_percentile(h, 99.9);
     }
 
-  private:
+    static void get_buckets(hdr_histogram* h, int64_t* buckets) {
+      size_t index = 0;
+      int64_t count = 0;
+      hdr_iter iter;
+      hdr_iter_init(&iter, h);
+      while (hdr_iter_next(&iter)) {
+        while (index < BUCKET_COUNT && iter.value_from_index > bucket_bound(index)) {
+          buckets[index++] = count;
+        }
+        if (index == BUCKET_COUNT) break;
+        count += iter.count_at_index;
+      }
+      while (index < BUCKET_COUNT) {
+        buckets[index++] = count;
+      }
+    }
+
 #if UV_VERSION_MAJOR == 0
     class PerThreadHistogram {
     public:
-      PerThreadHistogram() {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+      PerThreadHistogram()
+        : histogram_(NULL) {}
+
+      void init(int64_t highest_trackable_value, int significant_figures) {
+        hdr_init(1LL, highest_trackable_value, significant_figures, &histogram_);
       }
 
       ~PerThreadHistogram() {
@@ -336,8 +528,11 @@ public:
 
       }
 
-      void add(hdr_histogram* to) {
+      // Synchronized by the histogram's mutex
+      void move_to(hdr_histogram* to, hdr_histogram* interval) {
         hdr_add(to, histogram_);
+        hdr_add(interval, histogram_);
+        hdr_reset(histogram_);
       }
 
     private:
@@ -406,8 +601,12 @@ public:
     public:
       PerThreadHistogram()
         : active_index_(0) {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[0]);
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[1]);
+        histograms_[0] = histograms_[1] = NULL;
+      }
+
+      void init(int64_t highest_trackable_value, int significant_figures) {
+        hdr_init(1LL, highest_trackable_value, significant_figures, &histograms_[0]);
+        hdr_init(1LL, highest_trackable_value, significant_figures, &histograms_[1]);
       }
 
       ~PerThreadHistogram() {
@@ -422,11 +621,15 @@ public:
         phaser_.writer_critical_section_end(critical_value_enter);
       }
 
-      void add(hdr_histogram* to) {
+      // Recording switches to the other histogram and the values of the
+      // previously active one are moved once its writers are done with it
+      void move_to(hdr_histogram* to, hdr_histogram* interval) {
         int inactive_index = active_index_.exchange(!active_index_.load());
         hdr_histogram* from = histograms_[inactive_index];
         phaser_.flip_phase();
         hdr_add(to, from);
+        hdr_add(interval, from);
+        hdr_reset(from);
       }
 
     private:
@@ -436,16 +639,118 @@ public:
     };
 #endif
 
-    ThreadState* thread_state_;
-    ScopedPtr<PerThreadHistogram[]> histograms_;
+    struct InitPerThreadHistogram {
+      InitPerThreadHistogram(int64_t highest_trackable_value, int significant_figures)
+        : highest_trackable_value(highest_trackable_value)
+        , significant_figures(significant_figures) {}
+
+      void operator()(PerThreadHistogram* histogram) const {
+        histogram->init(highest_trackable_value, significant_figures);
+      }
+
+      int64_t highest_trackable_value;
+      int significant_figures;
+    };
+
+    const int64_t highest_trackable_value_;
+    PerThread<PerThreadHistogram, InitPerThreadHistogram> histograms_;
     hdr_histogram* histogram_;
+    hdr_histogram* interval_histogram_;
     mutable uv_mutex_t mutex_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Histogram);
   };
 
-  Metrics(size_t max_threads)
+  // The metrics of a single host. They're shared by the pools of all the
+  // IO workers and recorded without locks like the session's metrics.
+  class HostMetrics : public RefCounted<HostMetrics> {
+  public:
+    // The latency histogram is only allocated when "has_latencies" is set
+    // because its per-thread copies make it the largest part of a host's
+    // metrics.
+    HostMetrics(ThreadState* thread_state,
+                bool has_latencies = true,
+                int64_t highest_trackable_value = Histogram::HIGHEST_TRACKABLE_VALUE,
+                int significant_figures = 3)
+      : latencies(has_latencies ? new Histogram(thread_state,
+                                                highest_trackable_value,
+                                                significant_figures)
+                                : NULL)
+      , in_flight_requests(thread_state)
+      , pending_requests(thread_state)
+      , timeouts(thread_state)
+      , errors(thread_state)
+      , bytes_written(thread_state)
+      , bytes_read(thread_state) {}
+
+    // NULL unless per-host latencies are enabled
+    ScopedPtr<Histogram> latencies;
+    Counter in_flight_requests;
+    Counter pending_requests;
+    Counter timeouts;
+    Counter errors;
+    Counter bytes_written;
+    Counter bytes_read;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(HostMetrics);
+  };
+
+  typedef std::map<Address, SharedRefPtr<HostMetrics> > HostMetricsMap;
+
+  // The event loop metrics of a single IO worker. They're only recorded on
+  // the worker's loop thread so they use their own thread state, and their
+  // histograms use a smaller range and precision to keep them small.
+  class IOWorkerMetrics {
+  public:
+    static const int64_t HIGHEST_TRACKABLE_TIME = 60LL * 1000LL * 1000LL;
+    static const int64_t HIGHEST_TRACKABLE_COUNT = 1000LL * 1000LL;
+    static const int64_t HIGHEST_TRACKABLE_SIZE = 1024LL * 1024LL * 1024LL;
+    static const int SIGNIFICANT_FIGURES = 2;
+
+    IOWorkerMetrics()
+#if UV_VERSION_MAJOR == 0
+      : thread_state_()
+#else
+      : thread_state_(1)
+#endif
+      , iteration_times(&thread_state_, HIGHEST_TRACKABLE_TIME, SIGNIFICANT_FIGURES)
+      , execute_times(&thread_state_, HIGHEST_TRACKABLE_TIME, SIGNIFICANT_FIGURES)
+      , loop_lags(&thread_state_, HIGHEST_TRACKABLE_TIME, SIGNIFICANT_FIGURES)
+      , callbacks_per_iteration(&thread_state_, HIGHEST_TRACKABLE_COUNT, SIGNIFICANT_FIGURES)
+      , request_queue_depths(&thread_state_, HIGHEST_TRACKABLE_COUNT, SIGNIFICANT_FIGURES)
+      , flush_sizes(&thread_state_, HIGHEST_TRACKABLE_SIZE, SIGNIFICANT_FIGURES)
+      , flushes(&thread_state_) {}
+
+  private:
+    ThreadState thread_state_;
+
+  public:
+    // Microseconds between consecutive prepare callbacks, including the time
+    // spent waiting for I/O
+    Histogram iteration_times;
+    // Microseconds spent starting the requests dequeued by a single wakeup
+    Histogram execute_times;
+    // Microseconds that the periodic loop lag timer fired late
+    Histogram loop_lags;
+    // Callbacks run by the loop in a single iteration: request queue wakeups,
+    // events, timers and the socket and timer callbacks of its connections
+    Histogram callbacks_per_iteration;
+    Histogram request_queue_depths;
+    // Bytes written by a single connection flush from the prepare callback
+    Histogram flush_sizes;
+    Counter flushes;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(IOWorkerMetrics);
+  };
+
+  // "initial_threads" is the number of recording threads that per-thread
+  // storage is allocated for upfront. More is allocated as needed.
+  Metrics(size_t initial_threads,
+          int64_t highest_trackable_latency = Histogram::HIGHEST_TRACKABLE_VALUE,
+          int significant_figures = 3)
   // Note: For best performance use libuv 1.X!
 
   // libuv 0.10.X doesn't support thread-local variables so that means
@@ -458,9 +763,14 @@ public:
 #if UV_VERSION_MAJOR == 0
     : thread_state_()
 #else
-    : thread_state_(max_threads)
+    : thread_state_(initial_threads)
 #endif
-    , request_latencies(&thread_state_)
+    , highest_trackable_latency_(highest_trackable_latency)
+    , significant_figures_(significant_figures)
+    , has_host_latencies_(false)
+    , request_latencies(&thread_state_, highest_trackable_latency, significant_figures)
+    , normal_priority_request_latencies(&thread_state_, highest_trackable_latency, significant_figures)
+    , high_priority_request_latencies(&thread_state_, highest_trackable_latency, significant_figures)
     , request_rates(&thread_state_)
     , total_connections(&thread_state_)
     , available_connections(&thread_state_)
@@ -468,19 +778,109 @@ public:
     , exceeded_write_bytes_water_mark(&thread_state_)
     , connection_timeouts(&thread_state_)
     , pending_request_timeouts(&thread_state_)
-    , request_timeouts(&thread_state_) {}
+    , request_timeouts(&thread_state_)
+    , discarded_results(&thread_state_)
+    , discarded_errors(&thread_state_)
+    , expired_before_send(&thread_state_)
+    , sampled_request_timelines(&thread_state_)
+    , dropped_request_timelines(&thread_state_)
+    , slow_requests(&thread_state_)
+    , suppressed_slow_requests(&thread_state_) {
+    uv_mutex_init(&host_metrics_mutex_);
+  }
 
-  void record_request(uint64_t latency_ns) {
+  ~Metrics() {
+    uv_mutex_destroy(&host_metrics_mutex_);
+  }
+
+  void record_request(uint64_t latency_ns, CassRequestPriority priority) {
     // Final measurement is in microseconds
     request_latencies.record_value(latency_ns / 1000);
+    priority_request_latencies(priority).record_value(latency_ns / 1000);
     request_rates.mark();
   }
 
+  Histogram& priority_request_latencies(CassRequestPriority priority) {
+    return priority == CASS_REQUEST_PRIORITY_HIGH ? high_priority_request_latencies
+                                                  : normal_priority_request_latencies;
+  }
+
+  const Histogram& priority_request_latencies(CassRequestPriority priority) const {
+    return priority == CASS_REQUEST_PRIORITY_HIGH ? high_priority_request_latencies
+                                                  : normal_priority_request_latencies;
+  }
+
+  // The histograms are only allocated when request timelines are sampled.
+  // Must be called before the metrics are used by other threads.
+  void enable_request_stage_latencies() {
+    for (int i = CASS_REQUEST_STAGE_CREATED + 1; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+      request_stage_latencies_[i].reset(new Histogram(&thread_state_,
+                                                      highest_trackable_latency_,
+                                                      significant_figures_));
+    }
+  }
+
+  // Hosts only have a latency histogram once this is called.
+  // Must be called before the metrics are used by other threads.
+  void enable_host_latencies() {
+    has_host_latencies_ = true;
+  }
+
+  // The time taken to reach a stage from the previous stage. NULL if
+  // timelines aren't sampled.
+  Histogram* request_stage_latencies(CassRequestStage stage) const {
+    return request_stage_latencies_[stage].get();
+  }
+
+  void record_request_timeline(const CassRequestTimeline& timeline) {
+    const cass_uint64_t* timestamps = timeline.timestamps;
+    int previous = CASS_REQUEST_STAGE_CREATED;
+    for (int i = CASS_REQUEST_STAGE_CREATED + 1; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+      if (timestamps[i] == 0) continue;
+      if (timestamps[previous] != 0 && timestamps[i] >= timestamps[previous] &&
+          request_stage_latencies_[i]) {
+        // Final measurement is in microseconds
+        request_stage_latencies_[i]->record_value((timestamps[i] - timestamps[previous]) / 1000);
+      }
+      previous = i;
+    }
+  }
+
+  SharedRefPtr<HostMetrics> get_or_create_host_metrics(const Address& address) {
+    ScopedMutex l(&host_metrics_mutex_);
+    SharedRefPtr<HostMetrics>& host_metrics = host_metrics_[address];
+    if (!host_metrics) {
+      host_metrics.reset(new HostMetrics(&thread_state_,
+                                         has_host_latencies_,
+                                         highest_trackable_latency_,
+                                         significant_figures_));
+    }
+    return host_metrics;
+  }
+
+  void remove_host_metrics(const Address& address) {
+    ScopedMutex l(&host_metrics_mutex_);
+    host_metrics_.erase(address);
+  }
+
+  void get_host_metrics(HostMetricsMap* output) const {
+    ScopedMutex l(&host_metrics_mutex_);
+    *output = host_metrics_;
+  }
+
 private:
   ThreadState thread_state_;
+  const int64_t highest_trackable_latency_;
+  const int significant_figures_;
+  bool has_host_latencies_;
+  HostMetricsMap host_metrics_;
+  mutable uv_mutex_t host_metrics_mutex_;
+  ScopedPtr<Histogram> request_stage_latencies_[CASS_REQUEST_STAGE_LAST_ENTRY];
 
 public:
   Histogram request_latencies;
+  Histogram normal_priority_request_latencies;
+  Histogram high_priority_request_latencies;
   Meter request_rates;
 
   Counter total_connections;
@@ -492,6 +892,17 @@ public:
   Counter pending_request_timeouts;
   Counter request_timeouts;
 
+  Counter discarded_results;
+  Counter discarded_errors;
+
+  Counter expired_before_send;
+
+  Counter sampled_request_timelines;
+  Counter dropped_request_timelines;
+
+  Counter slow_requests;
+  Counter suppressed_slow_requests;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(Metrics);
 };
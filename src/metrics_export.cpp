@@ -0,0 +1,504 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metrics_export.hpp"
+
+// The writer's number formatting uses "__int128" with GCC on x86-64
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+#include "third_party/rapidjson/rapidjson/stringbuffer.h"
+#include "third_party/rapidjson/rapidjson/writer.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#include <sstream>
+
+namespace cass {
+
+struct HistogramSeries {
+  std::string labels;
+  Metrics::Histogram::Snapshot snapshot;
+  int64_t buckets[Metrics::Histogram::BUCKET_COUNT];
+};
+
+typedef std::vector<HistogramSeries> HistogramSeriesVec;
+
+typedef rapidjson::Writer<rapidjson::StringBuffer> JsonWriter;
+
+static const char* request_stage_name(int stage) {
+  static const char* names[] = {
+    "created", "session", "io_worker", "connection", "written", "response", "completed"
+  };
+  return names[stage];
+}
+
+static void add_series(const Metrics::Histogram& histogram,
+                       const std::string& labels,
+                       HistogramSeriesVec* series) {
+  series->push_back(HistogramSeries());
+  series->back().labels = labels;
+  histogram.get_snapshot(&series->back().snapshot, series->back().buckets);
+}
+
+static std::string host_label(const Address& address) {
+  return "host=\"" + address.to_string(true) + "\"";
+}
+
+static std::string join_labels(const std::string& labels, const std::string& other) {
+  if (labels.empty()) return other;
+  if (other.empty()) return labels;
+  return labels + "," + other;
+}
+
+static void write_header(std::ostringstream& out, const std::string& name,
+                         const char* type, const char* help) {
+  out << "# HELP cassandra_driver_" << name << " " << help << "\n"
+      << "# TYPE cassandra_driver_" << name << " " << type << "\n";
+}
+
+template <class T>
+static void write_sample(std::ostringstream& out, const std::string& name,
+                         const std::string& labels, T value) {
+  out << "cassandra_driver_" << name;
+  if (!labels.empty()) {
+    out << "{" << labels << "}";
+  }
+  out << " " << value << "\n";
+}
+
+template <class T>
+static void write_metric(std::ostringstream& out, const std::string& name,
+                         const char* type, const char* help, T value) {
+  write_header(out, name, type, help);
+  write_sample(out, name, "", value);
+}
+
+// Each histogram is exported as a Prometheus histogram with cumulative
+// buckets followed by gauges for its percentiles and other statistics.
+static void write_histograms(std::ostringstream& out, const std::string& stem,
+                             const char* help, const HistogramSeriesVec& series) {
+  std::string name(stem + "_microseconds");
+  write_header(out, name, "histogram", help);
+  for (HistogramSeriesVec::const_iterator it = series.begin(),
+       end = series.end(); it != end; ++it) {
+    for (size_t i = 0; i < Metrics::Histogram::BUCKET_COUNT; ++i) {
+      std::ostringstream le;
+      le << "le=\"" << Metrics::Histogram::bucket_bound(i) << "\"";
+      write_sample(out, name + "_bucket", join_labels(it->labels, le.str()), it->buckets[i]);
+    }
+    write_sample(out, name + "_bucket", join_labels(it->labels, "le=\"+Inf\""),
+                 it->snapshot.count);
+    // The sum isn't tracked by the histograms so it's derived from the mean
+    write_sample(out, name + "_sum", it->labels, it->snapshot.mean * it->snapshot.count);
+    write_sample(out, name + "_count", it->labels, it->snapshot.count);
+  }
+
+  name = stem + "_percentile_microseconds";
+  write_header(out, name, "gauge", help);
+  for (HistogramSeriesVec::const_iterator it = series.begin(),
+       end = series.end(); it != end; ++it) {
+    const Metrics::Histogram::Snapshot& s = it->snapshot;
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.5\""), s.median);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.75\""), s.percentile_75th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.95\""), s.percentile_95th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.98\""), s.percentile_98th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.99\""), s.percentile_99th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.999\""), s.percentile_999th);
+  }
+
+  const char* stats[] = { "min", "max", "mean", "stddev" };
+  for (size_t i = 0; i < 4; ++i) {
+    name = stem + "_" + stats[i] + "_microseconds";
+    write_header(out, name, "gauge", help);
+    for (HistogramSeriesVec::const_iterator it = series.begin(),
+         end = series.end(); it != end; ++it) {
+      const Metrics::Histogram::Snapshot& s = it->snapshot;
+      int64_t values[] = { s.min, s.max, s.mean, s.stddev };
+      write_sample(out, name, it->labels, values[i]);
+    }
+  }
+}
+
+// Histograms of values other than latencies are exported as Prometheus
+// summaries because the latency buckets don't apply to them.
+static void write_summaries(std::ostringstream& out, const std::string& name,
+                            const char* help, const HistogramSeriesVec& series) {
+  write_header(out, name, "summary", help);
+  for (HistogramSeriesVec::const_iterator it = series.begin(),
+       end = series.end(); it != end; ++it) {
+    const Metrics::Histogram::Snapshot& s = it->snapshot;
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.5\""), s.median);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.75\""), s.percentile_75th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.95\""), s.percentile_95th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.98\""), s.percentile_98th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.99\""), s.percentile_99th);
+    write_sample(out, name, join_labels(it->labels, "quantile=\"0.999\""), s.percentile_999th);
+    write_sample(out, name + "_sum", it->labels, s.mean * s.count);
+    write_sample(out, name + "_count", it->labels, s.count);
+  }
+}
+
+static const struct {
+  const char* name;
+  const char* json_name;
+  const char* help;
+  Metrics::Histogram Metrics::IOWorkerMetrics::* histogram;
+} io_worker_histograms[] = {
+  { "io_worker_loop_iteration_microseconds", "iteration_times",
+    "Time between event loop iterations including the time waiting for I/O",
+    &Metrics::IOWorkerMetrics::iteration_times },
+  { "io_worker_execute_microseconds", "execute_times",
+    "Time spent starting requests from the request queues",
+    &Metrics::IOWorkerMetrics::execute_times },
+  { "io_worker_loop_lag_microseconds", "loop_lags",
+    "Time that a periodic timer fired late",
+    &Metrics::IOWorkerMetrics::loop_lags },
+  { "io_worker_callbacks_per_iteration", "callbacks_per_iteration",
+    "Callbacks handled by the IO worker in each event loop iteration",
+    &Metrics::IOWorkerMetrics::callbacks_per_iteration },
+  { "io_worker_request_queue_depth", "request_queue_depths",
+    "Requests waiting in the request queues when the IO worker was woken up",
+    &Metrics::IOWorkerMetrics::request_queue_depths },
+  { "io_worker_flush_bytes", "flush_sizes",
+    "Bytes written by each connection flush",
+    &Metrics::IOWorkerMetrics::flush_sizes }
+};
+
+static std::string io_worker_label(size_t index) {
+  std::ostringstream label;
+  label << "io_worker=\"" << index << "\"";
+  return label.str();
+}
+
+static void export_prometheus(const Metrics* metrics,
+                              const Metrics::HostMetricsMap& hosts,
+                              const IOWorkerStatsVec& io_workers,
+                              std::string* output) {
+  std::ostringstream out;
+
+  HistogramSeriesVec series;
+  add_series(metrics->request_latencies, "", &series);
+  write_histograms(out, "request_latency", "Request latencies", series);
+
+  series.clear();
+  add_series(metrics->priority_request_latencies(CASS_REQUEST_PRIORITY_NORMAL),
+             "priority=\"normal\"", &series);
+  add_series(metrics->priority_request_latencies(CASS_REQUEST_PRIORITY_HIGH),
+             "priority=\"high\"", &series);
+  write_histograms(out, "priority_request_latency",
+                   "Request latencies by request priority", series);
+
+  series.clear();
+  for (int i = CASS_REQUEST_STAGE_CREATED; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+    const Metrics::Histogram* histogram =
+        metrics->request_stage_latencies(static_cast<CassRequestStage>(i));
+    if (histogram != NULL) {
+      add_series(*histogram, std::string("stage=\"") + request_stage_name(i) + "\"", &series);
+    }
+  }
+  if (!series.empty()) {
+    write_histograms(out, "request_stage_latency",
+                     "Time taken to reach each stage from the previous stage of sampled requests",
+                     series);
+  }
+
+  const Metrics::Meter& rates = metrics->request_rates;
+  write_header(out, "request_rate", "gauge", "Requests per second");
+  write_sample(out, "request_rate", "window=\"mean\"", rates.mean_rate());
+  write_sample(out, "request_rate", "window=\"1m\"", rates.one_minute_rate());
+  write_sample(out, "request_rate", "window=\"5m\"", rates.five_minute_rate());
+  write_sample(out, "request_rate", "window=\"15m\"", rates.fifteen_minute_rate());
+
+  write_metric(out, "connections", "gauge",
+               "The total number of connections",
+               metrics->total_connections.sum());
+  write_metric(out, "available_connections", "gauge",
+               "The number of connections available to take requests",
+               metrics->available_connections.sum());
+  write_metric(out, "exceeded_pending_requests_water_mark_total", "counter",
+               "Occurrences when requests exceeded a pool's water mark",
+               metrics->exceeded_pending_requests_water_mark.sum());
+  write_metric(out, "exceeded_write_bytes_water_mark_total", "counter",
+               "Occurrences when number of bytes exceeded a connection's water mark",
+               metrics->exceeded_write_bytes_water_mark.sum());
+  write_metric(out, "connection_timeouts_total", "counter",
+               "Occurrences of a connection timeout",
+               metrics->connection_timeouts.sum());
+  write_metric(out, "pending_request_timeouts_total", "counter",
+               "Occurrences of requests that timed out waiting for a connection",
+               metrics->pending_request_timeouts.sum());
+  write_metric(out, "request_timeouts_total", "counter",
+               "Occurrences of requests that timed out waiting for a request to finish",
+               metrics->request_timeouts.sum());
+  write_metric(out, "discarded_results_total", "counter",
+               "Successful requests executed without a future",
+               metrics->discarded_results.sum());
+  write_metric(out, "discarded_errors_total", "counter",
+               "Failed requests executed without a future",
+               metrics->discarded_errors.sum());
+  write_metric(out, "expired_before_send_total", "counter",
+               "Requests that timed out before they were sent",
+               metrics->expired_before_send.sum());
+  write_metric(out, "sampled_request_timelines_total", "counter",
+               "Requests with a timeline",
+               metrics->sampled_request_timelines.sum());
+  write_metric(out, "dropped_request_timelines_total", "counter",
+               "Timelines dropped because they weren't drained in time",
+               metrics->dropped_request_timelines.sum());
+  write_metric(out, "slow_requests_total", "counter",
+               "Requests that took longer than the slow request threshold",
+               metrics->slow_requests.sum());
+  write_metric(out, "suppressed_slow_requests_total", "counter",
+               "Slow requests that weren't reported because of sampling or the rate limit",
+               metrics->suppressed_slow_requests.sum());
+
+  series.clear();
+  for (Metrics::HostMetricsMap::const_iterator it = hosts.begin(),
+       end = hosts.end(); it != end; ++it) {
+    if (it->second->latencies) {
+      add_series(*it->second->latencies, host_label(it->first), &series);
+    }
+  }
+  write_histograms(out, "host_request_latency", "Request latencies by host", series);
+
+  struct {
+    const char* name;
+    const char* type;
+    const char* help;
+    Metrics::Counter Metrics::HostMetrics::* counter;
+  } host_counters[] = {
+    { "host_in_flight_requests", "gauge",
+      "Requests waiting for a response from the host", &Metrics::HostMetrics::in_flight_requests },
+    { "host_pending_requests", "gauge",
+      "Requests waiting for a connection to the host", &Metrics::HostMetrics::pending_requests },
+    { "host_request_timeouts_total", "counter",
+      "Occurrences of requests that timed out waiting for the host", &Metrics::HostMetrics::timeouts },
+    { "host_errors_total", "counter",
+      "Error responses and write errors", &Metrics::HostMetrics::errors },
+    { "host_written_bytes_total", "counter",
+      "Bytes of requests written to the host", &Metrics::HostMetrics::bytes_written },
+    { "host_read_bytes_total", "counter",
+      "Bytes read from the host", &Metrics::HostMetrics::bytes_read }
+  };
+  for (size_t i = 0; i < sizeof(host_counters) / sizeof(host_counters[0]); ++i) {
+    write_header(out, host_counters[i].name, host_counters[i].type, host_counters[i].help);
+    for (Metrics::HostMetricsMap::const_iterator it = hosts.begin(),
+         end = hosts.end(); it != end; ++it) {
+      write_sample(out, host_counters[i].name, host_label(it->first),
+                   ((*it->second).*host_counters[i].counter).sum());
+    }
+  }
+
+  write_header(out, "io_worker_request_queue_size", "gauge",
+               "Requests waiting in the IO worker's queues");
+  for (size_t i = 0; i < io_workers.size(); ++i) {
+    write_sample(out, "io_worker_request_queue_size", io_worker_label(i),
+                 io_workers[i].request_queue_size);
+  }
+
+  for (size_t i = 0; i < sizeof(io_worker_histograms) / sizeof(io_worker_histograms[0]); ++i) {
+    series.clear();
+    for (size_t j = 0; j < io_workers.size(); ++j) {
+      if (io_workers[j].loop_metrics == NULL) continue;
+      add_series(io_workers[j].loop_metrics->*io_worker_histograms[i].histogram,
+                 io_worker_label(j), &series);
+    }
+    write_summaries(out, io_worker_histograms[i].name, io_worker_histograms[i].help, series);
+  }
+
+  write_header(out, "io_worker_flushes_total", "counter",
+               "Connection flushes from the IO worker's prepare callback");
+  for (size_t i = 0; i < io_workers.size(); ++i) {
+    if (io_workers[i].loop_metrics == NULL) continue;
+    write_sample(out, "io_worker_flushes_total", io_worker_label(i),
+                 io_workers[i].loop_metrics->flushes.sum());
+  }
+
+  *output = out.str();
+}
+
+static void write_histogram(JsonWriter& writer, const Metrics::Histogram& histogram,
+                            bool has_buckets = true) {
+  HistogramSeries series;
+  histogram.get_snapshot(&series.snapshot, series.buckets);
+  const Metrics::Histogram::Snapshot& s = series.snapshot;
+
+  writer.StartObject();
+  writer.Key("count"); writer.Int64(s.count);
+  writer.Key("min"); writer.Int64(s.min);
+  writer.Key("max"); writer.Int64(s.max);
+  writer.Key("mean"); writer.Int64(s.mean);
+  writer.Key("stddev"); writer.Int64(s.stddev);
+  writer.Key("median"); writer.Int64(s.median);
+  writer.Key("percentile_75th"); writer.Int64(s.percentile_75th);
+  writer.Key("percentile_95th"); writer.Int64(s.percentile_95th);
+  writer.Key("percentile_98th"); writer.Int64(s.percentile_98th);
+  writer.Key("percentile_99th"); writer.Int64(s.percentile_99th);
+  writer.Key("percentile_999th"); writer.Int64(s.percentile_999th);
+  if (!has_buckets) {
+    writer.EndObject();
+    return;
+  }
+  writer.Key("buckets");
+  writer.StartArray();
+  for (size_t i = 0; i < Metrics::Histogram::BUCKET_COUNT; ++i) {
+    writer.StartObject();
+    writer.Key("le"); writer.Int64(Metrics::Histogram::bucket_bound(i));
+    writer.Key("count"); writer.Int64(series.buckets[i]);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+}
+
+static void export_json(const Metrics* metrics,
+                        const Metrics::HostMetricsMap& hosts,
+                        const IOWorkerStatsVec& io_workers,
+                        std::string* output) {
+  rapidjson::StringBuffer buffer;
+  JsonWriter writer(buffer);
+
+  writer.StartObject();
+
+  writer.Key("requests");
+  writer.StartObject();
+  writer.Key("latencies");
+  write_histogram(writer, metrics->request_latencies);
+  writer.Key("mean_rate"); writer.Double(metrics->request_rates.mean_rate());
+  writer.Key("one_minute_rate"); writer.Double(metrics->request_rates.one_minute_rate());
+  writer.Key("five_minute_rate"); writer.Double(metrics->request_rates.five_minute_rate());
+  writer.Key("fifteen_minute_rate"); writer.Double(metrics->request_rates.fifteen_minute_rate());
+  writer.EndObject();
+
+  writer.Key("priority_requests");
+  writer.StartObject();
+  writer.Key("normal");
+  write_histogram(writer, metrics->priority_request_latencies(CASS_REQUEST_PRIORITY_NORMAL));
+  writer.Key("high");
+  write_histogram(writer, metrics->priority_request_latencies(CASS_REQUEST_PRIORITY_HIGH));
+  writer.EndObject();
+
+  writer.Key("request_stages");
+  writer.StartObject();
+  for (int i = CASS_REQUEST_STAGE_CREATED; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+    const Metrics::Histogram* histogram =
+        metrics->request_stage_latencies(static_cast<CassRequestStage>(i));
+    if (histogram != NULL) {
+      writer.Key(request_stage_name(i));
+      write_histogram(writer, *histogram);
+    }
+  }
+  writer.EndObject();
+
+  writer.Key("request_timelines");
+  writer.StartObject();
+  writer.Key("sampled"); writer.Int64(metrics->sampled_request_timelines.sum());
+  writer.Key("dropped"); writer.Int64(metrics->dropped_request_timelines.sum());
+  writer.EndObject();
+
+  writer.Key("slow_requests");
+  writer.StartObject();
+  writer.Key("total"); writer.Int64(metrics->slow_requests.sum());
+  writer.Key("suppressed"); writer.Int64(metrics->suppressed_slow_requests.sum());
+  writer.EndObject();
+
+  writer.Key("stats");
+  writer.StartObject();
+  writer.Key("total_connections"); writer.Int64(metrics->total_connections.sum());
+  writer.Key("available_connections"); writer.Int64(metrics->available_connections.sum());
+  writer.Key("exceeded_pending_requests_water_mark");
+  writer.Int64(metrics->exceeded_pending_requests_water_mark.sum());
+  writer.Key("exceeded_write_bytes_water_mark");
+  writer.Int64(metrics->exceeded_write_bytes_water_mark.sum());
+  writer.EndObject();
+
+  writer.Key("errors");
+  writer.StartObject();
+  writer.Key("connection_timeouts"); writer.Int64(metrics->connection_timeouts.sum());
+  writer.Key("pending_request_timeouts"); writer.Int64(metrics->pending_request_timeouts.sum());
+  writer.Key("request_timeouts"); writer.Int64(metrics->request_timeouts.sum());
+  writer.Key("expired_before_send"); writer.Int64(metrics->expired_before_send.sum());
+  writer.EndObject();
+
+  writer.Key("discarded");
+  writer.StartObject();
+  writer.Key("results"); writer.Int64(metrics->discarded_results.sum());
+  writer.Key("errors"); writer.Int64(metrics->discarded_errors.sum());
+  writer.EndObject();
+
+  writer.Key("hosts");
+  writer.StartArray();
+  for (Metrics::HostMetricsMap::const_iterator it = hosts.begin(),
+       end = hosts.end(); it != end; ++it) {
+    const Metrics::HostMetrics& host_metrics = *it->second;
+    std::string address(it->first.to_string());
+    writer.StartObject();
+    writer.Key("address"); writer.String(address.data(), address.size());
+    writer.Key("port"); writer.Int(it->first.port());
+    if (host_metrics.latencies) {
+      writer.Key("latencies");
+      write_histogram(writer, *host_metrics.latencies);
+    }
+    writer.Key("in_flight_requests"); writer.Int64(host_metrics.in_flight_requests.sum());
+    writer.Key("pending_requests"); writer.Int64(host_metrics.pending_requests.sum());
+    writer.Key("request_timeouts"); writer.Int64(host_metrics.timeouts.sum());
+    writer.Key("errors"); writer.Int64(host_metrics.errors.sum());
+    writer.Key("bytes_written"); writer.Int64(host_metrics.bytes_written.sum());
+    writer.Key("bytes_read"); writer.Int64(host_metrics.bytes_read.sum());
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  writer.Key("io_workers");
+  writer.StartArray();
+  for (IOWorkerStatsVec::const_iterator it = io_workers.begin(),
+       end = io_workers.end(); it != end; ++it) {
+    writer.StartObject();
+    writer.Key("request_queue_size"); writer.Uint64(it->request_queue_size);
+    if (it->loop_metrics != NULL) {
+      for (size_t i = 0; i < sizeof(io_worker_histograms) / sizeof(io_worker_histograms[0]); ++i) {
+        writer.Key(io_worker_histograms[i].json_name);
+        write_histogram(writer, it->loop_metrics->*io_worker_histograms[i].histogram, false);
+      }
+      writer.Key("flushes"); writer.Int64(it->loop_metrics->flushes.sum());
+    }
+    writer.EndObject();
+  }
+  writer.EndArray();
+
+  writer.EndObject();
+
+  output->assign(buffer.GetString(), buffer.GetSize());
+}
+
+void export_metrics(const Metrics* metrics,
+                    const IOWorkerStatsVec& io_workers,
+                    CassMetricsFormat format,
+                    std::string* output) {
+  Metrics::HostMetricsMap hosts;
+  metrics->get_host_metrics(&hosts);
+
+  if (format == CASS_METRICS_FORMAT_JSON) {
+    export_json(metrics, hosts, io_workers, output);
+  } else {
+    export_prometheus(metrics, hosts, io_workers, output);
+  }
+}
+
+} // namespace cass
@@ -0,0 +1,50 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_METRICS_EXPORT_HPP_INCLUDED__
+#define __CASS_METRICS_EXPORT_HPP_INCLUDED__
+
+#include "cassandra.h"
+#include "metrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace cass {
+
+// Values that are read from each IO worker when the metrics are exported
+struct IOWorkerStats {
+  IOWorkerStats()
+    : request_queue_size(0)
+    , loop_metrics(NULL) {}
+
+  size_t request_queue_size;
+  // The IO worker's event loop metrics. They're only exported if not NULL.
+  const Metrics::IOWorkerMetrics* loop_metrics;
+};
+
+typedef std::vector<IOWorkerStats> IOWorkerStatsVec;
+
+// Serializes the metrics as Prometheus exposition text or as JSON. All
+// latencies are in microseconds.
+void export_metrics(const Metrics* metrics,
+                    const IOWorkerStatsVec& io_workers,
+                    CassMetricsFormat format,
+                    std::string* output);
+
+} // namespace cass
+
+#endif
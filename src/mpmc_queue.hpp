@@ -27,6 +27,7 @@
 #include "macros.hpp"
 
 #include <assert.h>
+#include <stdint.h>
 
 namespace cass {
 
@@ -27,6 +27,8 @@
 #include "result_response.hpp"
 #include "timer.hpp"
 
+#include <algorithm>
+
 namespace cass {
 
 static bool least_busy_comp(Connection* a, Connection* b) {
@@ -41,6 +43,7 @@ Pool::Pool(IOWorker* io_worker,
     , loop_(io_worker->loop())
     , config_(io_worker->config())
     , metrics_(io_worker->metrics())
+    , host_metrics_(metrics_->get_or_create_host_metrics(address))
     , state_(POOL_STATE_NEW)
     , available_connection_count_(0)
     , is_available_(false)
@@ -51,14 +54,18 @@ Pool::Pool(IOWorker* io_worker,
 
 Pool::~Pool() {
   LOG_DEBUG("Pool dtor with %u pending requests pool(%p)",
-            static_cast<unsigned int>(pending_requests_.size()),
+            static_cast<unsigned int>(pending_request_count()),
             static_cast<void*>(this));
-  while (!pending_requests_.is_empty()) {
-    RequestHandler* request_handler
-        = static_cast<RequestHandler*>(pending_requests_.front());
-    pending_requests_.remove(request_handler);
-    request_handler->stop_timer();
-    request_handler->retry(RETRY_WITH_NEXT_HOST);
+  List<Handler>* lists[] = { &high_priority_pending_requests_, &pending_requests_ };
+  for (size_t i = 0; i < 2; ++i) {
+    while (!lists[i]->is_empty()) {
+      RequestHandler* request_handler
+          = static_cast<RequestHandler*>(lists[i]->front());
+      lists[i]->remove(request_handler);
+      host_metrics_->pending_requests.dec();
+      request_handler->stop_timer();
+      request_handler->retry(RETRY_WITH_NEXT_HOST);
+    }
   }
 }
 
@@ -104,7 +111,7 @@ void Pool::close(bool cancel_reconnect) {
   maybe_close();
 }
 
-Connection* Pool::borrow_connection() {
+Connection* Pool::borrow_connection(CassRequestPriority priority) {
   if (connections_.empty()) {
     for (unsigned i = 0; i < config_.core_connections_per_host(); ++i) {
       maybe_spawn_connection();
@@ -113,6 +120,9 @@ Connection* Pool::borrow_connection() {
   }
 
   Connection* connection = find_least_busy();
+  if (connection != NULL && !is_stream_available(connection, priority)) {
+    connection = NULL;
+  }
 
   if (connection == NULL ||
       connection->pending_request_count() >=
@@ -124,30 +134,72 @@ Connection* Pool::borrow_connection() {
 }
 
 void Pool::return_connection(Connection* connection) {
-  if (!connection->is_ready() || pending_requests_.is_empty()) return;
-  RequestHandler* request_handler
-      = static_cast<RequestHandler*>(pending_requests_.front());
-  remove_pending_request(request_handler);
-  request_handler->stop_timer();
-  if (!write(connection, request_handler)) {
-    request_handler->retry(RETRY_WITH_NEXT_HOST);
+  if (!connection->is_ready()) return;
+  if (write_pending_request(connection, &high_priority_pending_requests_)) {
+    return;
   }
+  if (is_stream_available(connection, CASS_REQUEST_PRIORITY_NORMAL)) {
+    write_pending_request(connection, &pending_requests_);
+  }
+}
+
+List<Handler>& Pool::pending_requests(RequestHandler* request_handler) {
+  if (request_handler->request()->priority() == CASS_REQUEST_PRIORITY_HIGH) {
+    return high_priority_pending_requests_;
+  }
+  return pending_requests_;
+}
+
+size_t Pool::pending_request_count() const {
+  return pending_requests_.size() + high_priority_pending_requests_.size();
+}
+
+bool Pool::write_pending_request(Connection* connection, List<Handler>* pending_requests) {
+  while (!pending_requests->is_empty()) {
+    RequestHandler* request_handler
+        = static_cast<RequestHandler*>(pending_requests->front());
+    remove_pending_request(request_handler);
+    request_handler->stop_timer();
+    if (request_handler->is_cancelled()) {
+      request_handler->finish_cancelled();
+      continue;
+    }
+    if (request_handler->is_expired()) {
+      request_handler->expire();
+      continue;
+    }
+    if (!write(connection, request_handler)) {
+      request_handler->retry(RETRY_WITH_NEXT_HOST);
+    }
+    return true;
+  }
+  return false;
+}
+
+// The last streams of each connection can be reserved for high priority
+// requests
+bool Pool::is_stream_available(Connection* connection, CassRequestPriority priority) const {
+  return is_stream_available(connection->available_streams(),
+                             config_.reserved_high_priority_streams(),
+                             priority);
 }
 
 void Pool::add_pending_request(RequestHandler* request_handler) {
-  pending_requests_.add_to_back(request_handler);
+  pending_requests(request_handler).add_to_back(request_handler);
+  host_metrics_->pending_requests.inc();
 
-  if (pending_requests_.size() % 10 == 0) {
+  size_t pending_count = pending_request_count();
+  if (pending_count % 10 == 0) {
     LOG_DEBUG("%u request%s pending on %s pool(%p)",
-              static_cast<unsigned int>(pending_requests_.size() + 1),
-              pending_requests_.size() > 0 ? "s":"",
+              static_cast<unsigned int>(pending_count + 1),
+              pending_count > 0 ? "s":"",
               address_.to_string().c_str(),
               static_cast<void*>(this));
   }
 
-  if (pending_requests_.size() > config_.pending_requests_high_water_mark()) {
+  if (pending_count > config_.pending_requests_high_water_mark()) {
     LOG_WARN("Exceeded pending requests water mark (current: %u water mark: %u) for host %s",
-             static_cast<unsigned int>(pending_requests_.size()),
+             static_cast<unsigned int>(pending_count),
              config_.pending_requests_high_water_mark(),
              address_.to_string().c_str());
     set_is_available(false);
@@ -156,7 +208,8 @@ void Pool::add_pending_request(RequestHandler* request_handler) {
 }
 
 void Pool::remove_pending_request(RequestHandler* request_handler) {
-  pending_requests_.remove(request_handler);
+  pending_requests(request_handler).remove(request_handler);
+  host_metrics_->pending_requests.dec();
   set_is_available(true);
 }
 
@@ -164,7 +217,7 @@ void Pool::set_is_available(bool is_available) {
   if (is_available) {
     if (!is_available_ &&
         available_connection_count_ > 0 &&
-        pending_requests_.size() < config_.pending_requests_low_water_mark()) {
+        pending_request_count() < config_.pending_requests_low_water_mark()) {
       io_worker_->set_host_is_available(address_, true);
       is_available_ = true;
     }
@@ -201,9 +254,14 @@ bool Pool::write(Connection* connection, RequestHandler* request_handler) {
 
 void Pool::flush() {
   is_pending_flush_ = false;
+  Metrics::IOWorkerMetrics* loop_metrics = io_worker_->loop_metrics();
   for (ConnectionVec::iterator it = connections_.begin(),
        end = connections_.end(); it != end; ++it) {
-    (*it)->flush();
+    size_t size = (*it)->flush();
+    if (size > 0) {
+      loop_metrics->flushes.inc();
+      loop_metrics->flush_sizes.record_value(size);
+    }
   }
 }
 
@@ -232,6 +290,11 @@ void Pool::spawn_connection() {
                        io_worker_->keyspace(),
                        io_worker_->protocol_version(),
                        this);
+    // Only connections used for application requests defer decoding.
+    // Internal requests read the result on the IO thread.
+    connection->set_is_result_decoding_deferred(config_.deferred_result_decoding());
+    connection->set_host_metrics(host_metrics_.get());
+    connection->set_callback_count(io_worker_->callback_count());
 
     LOG_INFO("Spawning new connection to host %s", address_.to_string(true).c_str());
     connection->connect();
@@ -331,7 +394,8 @@ void Pool::on_pending_request_timeout(RequestTimer* timer) {
 void Pool::wait_for_connection(RequestHandler* request_handler) {
   request_handler->set_pool(this);
   request_handler->start_timer(loop_,
-                               config_.connect_timeout_ms(),
+                               std::min(static_cast<uint64_t>(config_.connect_timeout_ms()),
+                                        request_handler->request_timeout_ms(config_.connect_timeout_ms())),
                                request_handler,
                                Pool::on_pending_request_timeout);
   add_pending_request(request_handler);
@@ -59,7 +59,7 @@ public:
   void flush();
 
   void wait_for_connection(RequestHandler* request_handler);
-  Connection* borrow_connection();
+  Connection* borrow_connection(CassRequestPriority priority = CASS_REQUEST_PRIORITY_NORMAL);
 
   const Address& address() const { return address_; }
 
@@ -70,7 +70,22 @@ public:
 
   void return_connection(Connection* connection);
 
+  // Whether a request can use one of a connection's available streams when
+  // the last "reserved_streams" are reserved for high priority requests
+  static bool is_stream_available(size_t available_streams,
+                                  unsigned reserved_streams,
+                                  CassRequestPriority priority) {
+    return reserved_streams == 0 ||
+        priority == CASS_REQUEST_PRIORITY_HIGH ||
+        available_streams > reserved_streams;
+  }
+
 private:
+  List<Handler>& pending_requests(RequestHandler* request_handler);
+  size_t pending_request_count() const;
+  bool write_pending_request(Connection* connection, List<Handler>* pending_requests);
+  bool is_stream_available(Connection* connection, CassRequestPriority priority) const;
+
   void add_pending_request(RequestHandler* request_handler);
   void remove_pending_request(RequestHandler* request_handler);
   void set_is_available(bool is_available);
@@ -99,11 +114,13 @@ private:
   uv_loop_t* loop_;
   const Config& config_;
   Metrics* metrics_;
+  SharedRefPtr<Metrics::HostMetrics> host_metrics_;
 
   PoolState state_;
   ConnectionVec connections_;
   ConnectionSet connections_pending_;
   List<Handler> pending_requests_;
+  List<Handler> high_priority_pending_requests_;
   int available_connection_count_;
   bool is_available_;
   bool is_initial_connection_;
@@ -17,9 +17,11 @@
 #include "prepare_handler.hpp"
 
 #include "batch_request.hpp"
+#include "connection.hpp"
 #include "constants.hpp"
 #include "error_response.hpp"
 #include "execute_request.hpp"
+#include "logger.hpp"
 #include "prepare_request.hpp"
 #include "request_handler.hpp"
 #include "response.hpp"
@@ -75,4 +77,55 @@ void PrepareHandler::on_timeout() {
   request_handler_->retry(RETRY_WITH_NEXT_HOST);
 }
 
+void PrepareAllHandler::prepare_all(Connection* connection, const QueryVec& queries) {
+  SharedRefPtr<Queries> shared_queries(new Queries(queries));
+  for (size_t i = 0; i < MAX_CONCURRENT_PREPARES; ++i) {
+    if (!prepare_next(connection, shared_queries)) break;
+  }
+}
+
+void PrepareAllHandler::on_set(ResponseMessage* response) {
+  if (response->opcode() == CQL_OPCODE_ERROR) {
+    ErrorResponse* error =
+        static_cast<ErrorResponse*>(response->response_body().get());
+    LOG_WARN("Unable to prepare query on host %s: %s",
+             connection()->address_string().c_str(),
+             error->message().c_str());
+  }
+  prepare_next(connection(), queries_);
+}
+
+void PrepareAllHandler::on_error(CassError code, const std::string& message) {
+  LOG_WARN("Unable to prepare query on host %s: %s",
+           connection()->address_string().c_str(),
+           message.c_str());
+}
+
+void PrepareAllHandler::on_timeout() {
+  prepare_next(connection(), queries_);
+}
+
+PrepareAllHandler::PrepareAllHandler(const SharedRefPtr<Queries>& queries,
+                                     const std::string& query)
+  : queries_(queries) {
+  PrepareRequest* prepare = new PrepareRequest();
+  prepare->set_query(query);
+  request_.reset(prepare);
+}
+
+bool PrepareAllHandler::prepare_next(Connection* connection,
+                                     const SharedRefPtr<Queries>& queries) {
+  if (queries->next >= queries->queries.size() || !connection->is_ready()) {
+    return false;
+  }
+  PrepareAllHandler* handler =
+      new PrepareAllHandler(queries, queries->queries[queries->next]);
+  if (!connection->write(handler)) {
+    delete handler;
+    return false;
+  }
+  queries->next++;
+  return true;
+}
+
 } // namespace cass
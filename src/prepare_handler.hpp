@@ -22,6 +22,9 @@
 #include "ref_counted.hpp"
 #include "request_handler.hpp"
 
+#include <string>
+#include <vector>
+
 namespace cass {
 
 class ResponseMessage;
@@ -47,6 +50,48 @@ private:
   ScopedRefPtr<RequestHandler> request_handler_;
 };
 
+// Prepares queries on a connection, a few at a time, so that a host that's
+// added or comes back up already knows the session's prepared statements.
+// Failures are only logged because an unprepared statement is still
+// prepared when it's executed.
+class PrepareAllHandler : public Handler {
+public:
+  typedef std::vector<std::string> QueryVec;
+
+  static const size_t MAX_CONCURRENT_PREPARES = 8;
+
+  static void prepare_all(Connection* connection, const QueryVec& queries);
+
+  virtual const Request* request() const { return request_.get(); }
+
+  virtual bool is_result_discarded() const { return true; }
+
+  virtual void on_set(ResponseMessage* response);
+
+  virtual void on_error(CassError code, const std::string& message);
+
+  virtual void on_timeout();
+
+private:
+  struct Queries : public RefCounted<Queries> {
+    Queries(const QueryVec& queries)
+      : queries(queries)
+      , next(0) {}
+
+    QueryVec queries;
+    size_t next;
+  };
+
+  PrepareAllHandler(const SharedRefPtr<Queries>& queries,
+                    const std::string& query);
+
+  static bool prepare_next(Connection* connection,
+                           const SharedRefPtr<Queries>& queries);
+
+  ScopedRefPtr<Request> request_;
+  SharedRefPtr<Queries> queries_;
+};
+
 } // namespace cass
 
 #endif
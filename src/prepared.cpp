@@ -18,6 +18,7 @@
 
 #include "execute_request.hpp"
 #include "logger.hpp"
+#include "scoped_lock.hpp"
 #include "types.hpp"
 
 extern "C" {
@@ -58,4 +59,126 @@ Prepared::Prepared(const ResultResponse* result,
       }
     }
   }
+
+PreparedCache::PreparedCache(size_t max_size)
+  : max_size_(max_size) {
+  uv_mutex_init(&mutex_);
+}
+
+PreparedCache::~PreparedCache() {
+  uv_mutex_destroy(&mutex_);
+}
+
+void PreparedCache::set_max_size(size_t max_size) {
+  ScopedMutex l(&mutex_);
+  max_size_ = max_size;
+  remove_least_recently_used();
+}
+
+size_t PreparedCache::size() const {
+  ScopedMutex l(&mutex_);
+  return prepared_.size();
+}
+
+SharedRefPtr<const Prepared> PreparedCache::get(const std::string& keyspace,
+                                                const std::string& query) {
+  ScopedMutex l(&mutex_);
+  Map::iterator it = prepared_.find(Key(keyspace, query));
+  if (it == prepared_.end()) {
+    return SharedRefPtr<const Prepared>();
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  return it->second.prepared;
+}
+
+void PreparedCache::add(const std::string& keyspace,
+                        const SharedRefPtr<const Prepared>& prepared) {
+  ScopedMutex l(&mutex_);
+  Key key(keyspace, prepared->statement());
+  Map::iterator it = prepared_.find(key);
+  if (it != prepared_.end()) {
+    it->second.prepared = prepared;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    return;
+  }
+
+  Entry& entry = prepared_[key];
+  entry.prepared = prepared;
+  entry.lru_position = lru_.insert(lru_.begin(), key);
+  remove_least_recently_used();
+}
+
+void PreparedCache::remove_table(const std::string& keyspace,
+                                 const std::string& table) {
+  ScopedMutex l(&mutex_);
+  Map::iterator it = prepared_.begin();
+  while (it != prepared_.end()) {
+    const ScopedPtr<const ResultResponse>& result = it->second.prepared->result();
+    if (result->keyspace() == keyspace &&
+        (table.empty() || result->table() == table)) {
+      remove(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void PreparedCache::remove_id(const std::string& id) {
+  ScopedMutex l(&mutex_);
+  Map::iterator it = prepared_.begin();
+  while (it != prepared_.end()) {
+    if (it->second.prepared->id() == id) {
+      remove(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void PreparedCache::get_queries(const std::string& keyspace, QueryVec* queries) const {
+  ScopedMutex l(&mutex_);
+  for (Map::const_iterator it = prepared_.lower_bound(Key(keyspace, std::string())),
+       end = prepared_.end(); it != end && it->first.first == keyspace; ++it) {
+    queries->push_back(it->first.second);
+  }
 }
+
+bool PreparedCache::record_execution(const std::string& keyspace,
+                                     const std::string& query,
+                                     unsigned threshold) {
+  ScopedMutex l(&mutex_);
+  Key key(keyspace, query);
+  CountMap::iterator it = execution_counts_.find(key);
+  if (it == execution_counts_.end()) {
+    if (execution_counts_.size() >= MAX_EXECUTION_COUNTS) {
+      execution_counts_.clear();
+    }
+    it = execution_counts_.insert(CountMap::value_type(key, 0)).first;
+  }
+  if (++it->second >= threshold) {
+    execution_counts_.erase(it);
+    return true;
+  }
+  return false;
+}
+
+void PreparedCache::clear() {
+  ScopedMutex l(&mutex_);
+  prepared_.clear();
+  lru_.clear();
+  execution_counts_.clear();
+}
+
+void PreparedCache::remove(Map::iterator it) {
+  lru_.erase(it->second.lru_position);
+  prepared_.erase(it);
+}
+
+void PreparedCache::remove_least_recently_used() {
+  while (prepared_.size() > max_size_) {
+    prepared_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+} // namespace cass
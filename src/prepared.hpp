@@ -17,11 +17,16 @@
 #ifndef __CASS_PREPARED_HPP_INCLUDED__
 #define __CASS_PREPARED_HPP_INCLUDED__
 
+#include "macros.hpp"
 #include "ref_counted.hpp"
 #include "result_response.hpp"
 #include "scoped_ptr.hpp"
 
+#include <list>
+#include <map>
 #include <string>
+#include <uv.h>
+#include <vector>
 
 namespace cass {
 
@@ -43,6 +48,81 @@ private:
   std::vector<size_t> key_indices_;
 };
 
+// Prepared statements by keyspace and query. They're used to automatically
+// prepare queries and to prepare statements on new hosts. The least recently
+// used statements are removed once there are "max_size" statements.
+// Synchronized, it's used by the application threads and the IO threads.
+class PreparedCache {
+public:
+  typedef std::vector<std::string> QueryVec;
+
+  static const size_t DEFAULT_MAX_SIZE = 1000;
+
+  PreparedCache(size_t max_size = DEFAULT_MAX_SIZE);
+  ~PreparedCache();
+
+  // Removes the least recently used statements if there are more than
+  // the new maximum
+  void set_max_size(size_t max_size);
+
+  size_t size() const;
+
+  SharedRefPtr<const Prepared> get(const std::string& keyspace,
+                                   const std::string& query);
+  void add(const std::string& keyspace,
+           const SharedRefPtr<const Prepared>& prepared);
+
+  // Removes the statements that use the table or, if the table is empty,
+  // any of the keyspace's tables. Their result metadata is stale after
+  // the schema changes.
+  void remove_table(const std::string& keyspace, const std::string& table);
+
+  // Removes the statements with the prepared id (after an unprepared error)
+  void remove_id(const std::string& id);
+
+  // The queries that were prepared using the keyspace
+  void get_queries(const std::string& keyspace, QueryVec* queries) const;
+
+  // Counts the executions of a query that's not prepared. Returns true once
+  // the query has been executed "threshold" times, after that the query is
+  // counted again from zero.
+  bool record_execution(const std::string& keyspace,
+                        const std::string& query,
+                        unsigned threshold);
+
+  void clear();
+
+private:
+  // Queries with literal values are unique so the counts are reset instead
+  // of growing without bounds
+  static const size_t MAX_EXECUTION_COUNTS = 10000;
+
+  typedef std::pair<std::string, std::string> Key;
+  // From the most recently used to the least recently used
+  typedef std::list<Key> KeyList;
+
+  struct Entry {
+    SharedRefPtr<const Prepared> prepared;
+    KeyList::iterator lru_position;
+  };
+
+  typedef std::map<Key, Entry> Map;
+  typedef std::map<Key, unsigned> CountMap;
+
+  // Must be called with the mutex held
+  void remove(Map::iterator it);
+  void remove_least_recently_used();
+
+  size_t max_size_;
+  Map prepared_;
+  KeyList lru_;
+  CountMap execution_counts_;
+  mutable uv_mutex_t mutex_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PreparedCache);
+};
+
 } // namespace cass
 
 #endif
@@ -35,7 +35,9 @@ public:
   Request(uint8_t opcode)
       : opcode_(opcode)
       , consistency_(CASS_CONSISTENCY_ONE)
-      , serial_consistency_(CASS_CONSISTENCY_ANY) {}
+      , serial_consistency_(CASS_CONSISTENCY_ANY)
+      , request_timeout_ms_(0)
+      , priority_(CASS_REQUEST_PRIORITY_NORMAL) {}
 
   virtual ~Request() {}
 
@@ -51,12 +53,26 @@ public:
     serial_consistency_ = serial_consistency;
   }
 
+  // Starts when the request is executed, zero uses the cluster's
+  // request timeout once the request is written
+  uint64_t request_timeout_ms() const { return request_timeout_ms_; }
+
+  void set_request_timeout_ms(uint64_t timeout_ms) {
+    request_timeout_ms_ = timeout_ms;
+  }
+
+  CassRequestPriority priority() const { return priority_; }
+
+  void set_priority(CassRequestPriority priority) { priority_ = priority; }
+
   virtual int encode(int version, BufferVec* bufs) const = 0;
 
 private:
   uint8_t opcode_;
   CassConsistency consistency_;
   CassConsistency serial_consistency_;
+  uint64_t request_timeout_ms_;
+  CassRequestPriority priority_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Request);
@@ -16,27 +16,51 @@
 
 #include "request_handler.hpp"
 
+#include "batch_request.hpp"
 #include "connection.hpp"
 #include "error_response.hpp"
 #include "execute_request.hpp"
 #include "io_worker.hpp"
 #include "pool.hpp"
+#include "prepare_request.hpp"
 #include "prepare_handler.hpp"
 #include "result_response.hpp"
 #include "row.hpp"
 #include "schema_change_handler.hpp"
 #include "session.hpp"
+#include "slow_request_log.hpp"
+#include "statement.hpp"
 
+#include <sstream>
+#include <string.h>
 #include <uv.h>
 
 namespace cass {
 
+bool ResponseFuture::cancel() {
+  ScopedMutex lock(&mutex_);
+  if (internal_is_set()) {
+    return false;
+  }
+  is_cancelled_.store(true);
+  // The IO thread's loop can't be used from the canceling thread so the
+  // callback is run directly
+  internal_set_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request cancelled",
+                     lock, NULL);
+  return true;
+}
+
 void RequestHandler::on_set(ResponseMessage* response) {
   assert(connection_ != NULL);
   assert(!is_query_plan_exhausted_ && "Tried to set on a non-existent host");
+  response_size_ = response->length();
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
-      on_result_response(response);
+      if (response->is_body_discarded()) {
+        set_response(NULL);
+      } else {
+        on_result_response(response);
+      }
       break;
     case CQL_OPCODE_ERROR:
       on_error_response(response);
@@ -63,8 +87,40 @@ void RequestHandler::on_timeout() {
   set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
 }
 
+uint64_t RequestHandler::request_timeout_ms(uint64_t default_timeout_ms) const {
+  if (deadline_ns_ == 0) {
+    return default_timeout_ms;
+  }
+  uint64_t now = uv_hrtime();
+  if (now >= deadline_ns_) {
+    return 1;
+  }
+  return (deadline_ns_ - now + 999999) / 1000000; // Round up to milliseconds
+}
+
+void RequestHandler::expire() {
+  io_worker_->metrics()->expired_before_send.inc();
+  pool_ = NULL; // Nothing was written
+  set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out before it was sent");
+}
+
+void RequestHandler::finish_cancelled() {
+  pool_ = NULL; // Nothing was written
+  set_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request cancelled");
+}
+
+uint64_t RequestHandler::compute_deadline(const Request* request) {
+  uint64_t timeout_ms = request->request_timeout_ms();
+  if (timeout_ms == 0) {
+    return 0;
+  }
+  return uv_hrtime() + timeout_ms * 1000000;
+}
+
 void RequestHandler::set_io_worker(IOWorker* io_worker) {
-  future_->set_loop(io_worker->loop());
+  if (future_) {
+    future_->set_loop(io_worker->loop());
+  }
   io_worker_ = io_worker;
 }
 
@@ -72,6 +128,7 @@ void RequestHandler::retry(RetryType type) {
   // Reset the request so it can be executed again
   set_state(REQUEST_STATE_NEW);
   pool_ = NULL;
+  attempt_count_++;
 
   io_worker_->retry(this, type);
 }
@@ -95,18 +152,68 @@ bool RequestHandler::is_host_up(const Address& address) const {
 
 void RequestHandler::start_request() {
   start_time_ns_ = uv_hrtime();
+  // Only the hosts that the request is written to, not the ones that were
+  // skipped because they were down or busy
+  if (slow_request_log_ != NULL &&
+      (attempted_addresses_.empty() ||
+       !(attempted_addresses_.back() == current_host_->address()))) {
+    attempted_addresses_.push_back(current_host_->address());
+  }
 }
 
-void RequestHandler::set_response(Response* response) {
+void RequestHandler::record_latency() {
   uint64_t elapsed = uv_hrtime() - start_time_ns_;
   current_host_->update_latency(elapsed);
-  connection_->metrics()->record_request(elapsed);
-  future_->set_result(current_host_->address(), response);
+  connection_->metrics()->record_request(elapsed, request_->priority());
+  Metrics::HostMetrics* host_metrics = connection_->host_metrics();
+  if (host_metrics != NULL && host_metrics->latencies) {
+    // Final measurement is in microseconds
+    host_metrics->latencies->record_value(elapsed / 1000);
+  }
+}
+
+void RequestHandler::set_response(Response* response) {
+  record_latency();
+  if (future_) {
+    future_->set_result(current_host_->address(), response);
+  } else {
+    delete response;
+    metrics_->discarded_results.inc();
+  }
+  return_connection_and_finish();
+}
+
+void RequestHandler::set_prepared(ResultResponse* result) {
+  record_latency();
+
+  // The partition key columns are used to determine the routing key
+  std::vector<std::string> key_columns;
+  io_worker_->get_table_key_columns(result->keyspace(),
+                                    result->table(),
+                                    &key_columns);
+  SharedRefPtr<const Prepared> prepared(
+        new Prepared(result, future_->statement, key_columns));
+  // Only cached using the keyspace that it was actually prepared with, which
+  // can be different while a "USE <keyspace>" is propagated to the IO workers
+  if (connection_->keyspace() == future_->keyspace) {
+    io_worker_->add_prepared(future_->keyspace, prepared);
+  }
+
+  future_->set_prepared(current_host_->address(), prepared);
   return_connection_and_finish();
 }
 
 void RequestHandler::set_error(CassError code, const std::string& message) {
-  if (is_query_plan_exhausted_) {
+  error_code_ = code;
+  if (timeline_) {
+    timeline_->timeline.error = code;
+  }
+  if (!future_) {
+    metrics_->discarded_errors.inc();
+    if (error_callback_ != NULL) {
+      error_callback_(code, message.data(), message.size(), error_callback_data_);
+    }
+  } else if (is_query_plan_exhausted_) {
     future_->set_error(code, message);
   } else {
     future_->set_error_with_host_address(current_host_->address(), code, message);
@@ -122,27 +229,134 @@ void RequestHandler::return_connection() {
 
 void RequestHandler::return_connection_and_finish() {
   return_connection();
+  if (timeline_) {
+    timeline_->timeline.priority = request_->priority();
+    timeline_->record(CASS_REQUEST_STAGE_COMPLETED);
+  }
   if (io_worker_ != NULL) {
+    if (slow_request_log_ != NULL) {
+      maybe_report_slow_request();
+    }
     io_worker_->request_finished(this);
   }
   dec_ref();
 }
 
+static const std::string& statement_query(const Statement* statement) {
+  if (statement->opcode() == CQL_OPCODE_EXECUTE) {
+    return static_cast<const ExecuteRequest*>(statement)->prepared()->statement();
+  }
+  return statement->query();
+}
+
+static void get_query(const Request* request, std::string* query) {
+  switch (request->opcode()) {
+    case CQL_OPCODE_QUERY:
+    case CQL_OPCODE_EXECUTE:
+      *query = statement_query(static_cast<const Statement*>(request));
+      break;
+
+    case CQL_OPCODE_PREPARE:
+      *query = static_cast<const PrepareRequest*>(request)->query();
+      break;
+
+    case CQL_OPCODE_BATCH: {
+      const BatchRequest::StatementList& statements =
+          static_cast<const BatchRequest*>(request)->statements();
+      for (BatchRequest::StatementList::const_iterator it = statements.begin(),
+           end = statements.end(); it != end; ++it) {
+        if (!query->empty()) query->append("; ");
+        query->append(statement_query(it->get()));
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+void RequestHandler::maybe_report_slow_request() {
+  uint64_t elapsed = uv_hrtime() - execute_time_ns_;
+  if (!slow_request_log_->is_slow(elapsed) ||
+      !slow_request_log_->is_reported()) {
+    return;
+  }
+
+  CassSlowRequest slow_request;
+  memset(&slow_request, 0, sizeof(slow_request));
+
+  // Final measurement is in microseconds
+  slow_request.latency = elapsed / 1000;
+
+  std::string query;
+  get_query(request_.get(), &query);
+  slow_request.query = query.data();
+  slow_request.query_length = query.size();
+
+  std::string routing_key;
+  uint8_t opcode = request_->opcode();
+  if ((opcode == CQL_OPCODE_QUERY || opcode == CQL_OPCODE_EXECUTE ||
+       opcode == CQL_OPCODE_BATCH) &&
+      static_cast<const RoutableRequest*>(request_.get())->get_routing_key(&routing_key)) {
+    slow_request.routing_key = reinterpret_cast<const cass_byte_t*>(routing_key.data());
+    slow_request.routing_key_size = routing_key.size();
+    // Computed using the cluster's partitioner
+    int64_t token;
+    if (io_worker_->get_int64_token(routing_key, &token)) {
+      slow_request.token = token;
+      slow_request.has_token = cass_true;
+    }
+  }
+
+  std::ostringstream hosts;
+  for (std::vector<Address>::const_iterator it = attempted_addresses_.begin(),
+       end = attempted_addresses_.end(); it != end; ++it) {
+    if (it != attempted_addresses_.begin()) hosts << ",";
+    hosts << it->to_string(true);
+  }
+  std::string hosts_string(hosts.str());
+  slow_request.hosts = hosts_string.data();
+  slow_request.hosts_length = hosts_string.size();
+
+  // The first attempt is started using retry()
+  slow_request.retries = attempt_count_ > 0 ? attempt_count_ - 1 : 0;
+
+  if (timeline_) {
+    const cass_uint64_t* timestamps = timeline_->timeline.timestamps;
+    int previous = CASS_REQUEST_STAGE_CREATED;
+    for (int i = CASS_REQUEST_STAGE_CREATED + 1; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+      if (timestamps[i] == 0) continue;
+      if (timestamps[previous] != 0 && timestamps[i] >= timestamps[previous]) {
+        slow_request.stage_latencies[i] = (timestamps[i] - timestamps[previous]) / 1000;
+      }
+      previous = i;
+    }
+  }
+
+  slow_request.response_size = response_size_;
+  slow_request.priority = request_->priority();
+  slow_request.error = error_code_;
+
+  slow_request_log_->report(slow_request);
+}
+
 void RequestHandler::on_result_response(ResponseMessage* response) {
   ResultResponse* result =
       static_cast<ResultResponse*>(response->response_body().get());
   switch (result->kind()) {
     case CASS_RESULT_KIND_ROWS:
-      // Execute statements with no metadata get their metadata from
-      // result_metadata() returned when the statement was prepared.
-      if (request_->opcode() == CQL_OPCODE_EXECUTE && result->no_metadata()) {
-        const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request_.get());
-        if (!execute->skip_metadata()) {
+      // Statements with no metadata get their metadata from result_metadata()
+      // returned when the statement was prepared or from a previous page.
+      if ((request_->opcode() == CQL_OPCODE_EXECUTE ||
+           request_->opcode() == CQL_OPCODE_QUERY) && result->no_metadata()) {
+        const Statement* statement = static_cast<const Statement*>(request_.get());
+        if (!statement->skip_metadata() || !statement->result_metadata()) {
           // Caused by a race condition in C* 2.1.0
           on_error(CASS_ERROR_LIB_UNEXPECTED_RESPONSE, "Expected metadata but no metadata in response (see CASSANDRA-8054)");
           return;
         }
-        result->set_metadata(execute->prepared()->result()->result_metadata().get());
+        result->set_metadata(statement->result_metadata().get());
       }
       set_response(response->response_body().release());
       break;
@@ -156,6 +370,14 @@ void RequestHandler::on_result_response(ResponseMessage* response) {
       break;
     }
 
+    case CASS_RESULT_KIND_PREPARED:
+      if (future_) {
+        set_prepared(static_cast<ResultResponse*>(response->response_body().release()));
+      } else {
+        set_response(response->response_body().release());
+      }
+      break;
+
     case CASS_RESULT_KIND_SET_KEYSPACE:
       io_worker_->broadcast_keyspace_change(result->keyspace());
       set_response(response->response_body().release());
@@ -172,6 +394,8 @@ void RequestHandler::on_error_response(ResponseMessage* response) {
       static_cast<ErrorResponse*>(response->response_body().get());
 
   if (error->code() == CQL_ERROR_UNPREPARED) {
+    // The statement is prepared again with the current schema
+    io_worker_->remove_prepared(error->prepared_id());
     ScopedRefPtr<PrepareHandler> prepare_handler(new PrepareHandler(this));
     if (prepare_handler->init(error->prepared_id())) {
       if (!connection_->write(prepare_handler.get())) {
@@ -22,6 +22,8 @@
 #include "handler.hpp"
 #include "host.hpp"
 #include "load_balancing.hpp"
+#include "metrics.hpp"
+#include "prepared.hpp"
 #include "request.hpp"
 #include "response.hpp"
 #include "schema_metadata.hpp"
@@ -35,16 +37,50 @@ namespace cass {
 class Connection;
 class IOWorker;
 class Pool;
+class SlowRequestLog;
 class Timer;
 
 class ResponseFuture : public ResultFuture<Response> {
 public:
-  ResponseFuture(const Schema& schema)
+  ResponseFuture()
       : ResultFuture<Response>(CASS_FUTURE_TYPE_RESPONSE)
-      , schema(schema) {}
+      , is_cancelled_(false) {}
 
   std::string statement;
-  Schema schema;
+  // The session's keyspace when the statement was prepared. It's used as the
+  // prepared cache's key so that lookups, which also use the session's
+  // keyspace, find it.
+  std::string keyspace;
+
+  // Sets the future with a cancellation error. A request that's still queued
+  // is dropped before it's written and the response of a request that's
+  // already been written is discarded. Returns false if the future is
+  // already set.
+  bool cancel();
+
+  bool is_cancelled() const { return is_cancelled_.load(); }
+
+  // Prepared results are set as a prepared statement that's shared with the
+  // session's prepared cache instead of a response.
+  void set_prepared(Address address, const SharedRefPtr<const Prepared>& prepared) {
+    {
+      ScopedMutex lock(&mutex_);
+      prepared_ = prepared;
+    }
+    set_result(address, NULL);
+  }
+
+  SharedRefPtr<const Prepared> release_prepared() {
+    ScopedMutex lock(&mutex_);
+    internal_wait(lock);
+    SharedRefPtr<const Prepared> prepared(prepared_);
+    prepared_.reset();
+    return prepared;
+  }
+
+private:
+  SharedRefPtr<const Prepared> prepared_;
+  Atomic<bool> is_cancelled_;
 };
 
 class RequestHandler : public Handler {
@@ -52,12 +88,47 @@ public:
   RequestHandler(const Request* request, ResponseFuture* future)
       : request_(request)
       , future_(future)
+      , error_callback_(NULL)
+      , error_callback_data_(NULL)
+      , metrics_(NULL)
       , is_query_plan_exhausted_(true)
       , io_worker_(NULL)
-      , pool_(NULL) {}
+      , pool_(NULL)
+      , deadline_ns_(compute_deadline(request))
+      , slow_request_log_(NULL)
+      , execute_time_ns_(0)
+      , attempt_count_(0)
+      , response_size_(0)
+      , error_code_(CASS_OK) {}
+
+  // A request without a future. Successful "rows" and "void" results are
+  // discarded and errors are only reported using the (optional) callback and
+  // the metrics. "Set keyspace" and "schema change" results are still applied.
+  RequestHandler(const Request* request,
+                 CassRequestErrorCallback error_callback,
+                 void* error_callback_data,
+                 Metrics* metrics)
+      : request_(request)
+      , error_callback_(error_callback)
+      , error_callback_data_(error_callback_data)
+      , metrics_(metrics)
+      , is_query_plan_exhausted_(true)
+      , io_worker_(NULL)
+      , pool_(NULL)
+      , deadline_ns_(compute_deadline(request))
+      , slow_request_log_(NULL)
+      , execute_time_ns_(0)
+      , attempt_count_(0)
+      , response_size_(0)
+      , error_code_(CASS_OK) {}
 
   virtual const Request* request() const { return request_.get(); }
 
+  // Only "rows" and "void" bodies are skipped (see ResponseMessage::BodyFilter)
+  virtual bool is_result_discarded() const { return !future_ || future_->is_cancelled(); }
+
+  virtual uint64_t request_timeout_ms(uint64_t default_timeout_ms) const;
+
   virtual void start_request();
 
   virtual void on_set(ResponseMessage* response);
@@ -83,23 +154,59 @@ public:
   bool is_host_up(const Address& address) const;
 
   void set_response(Response* response);
+  void set_prepared(ResultResponse* result);
+
+  // Requests with their own timeout expire if they're not sent in time
+  bool is_expired() const {
+    return deadline_ns_ != 0 && uv_hrtime() >= deadline_ns_;
+  }
+
+  void expire();
+
+  bool is_cancelled() const { return future_ && future_->is_cancelled(); }
+
+  // Finishes a cancelled request without sending it
+  void finish_cancelled();
+
+  // The request is reported if it's slow. Must be called when the request
+  // is executed.
+  void set_slow_request_log(SlowRequestLog* slow_request_log) {
+    slow_request_log_ = slow_request_log;
+    execute_time_ns_ = uv_hrtime();
+  }
 
 private:
+  static uint64_t compute_deadline(const Request* request);
+
   void set_error(CassError code, const std::string& message);
+  void record_latency();
   void return_connection();
   void return_connection_and_finish();
+  void maybe_report_slow_request();
 
   void on_result_response(ResponseMessage* response);
   void on_error_response(ResponseMessage* response);
 
   ScopedRefPtr<const Request> request_;
   ScopedRefPtr<ResponseFuture> future_;
+  CassRequestErrorCallback error_callback_;
+  void* error_callback_data_;
+  Metrics* metrics_;
   bool is_query_plan_exhausted_;
   SharedRefPtr<Host> current_host_;
   ScopedPtr<QueryPlan> query_plan_;
   IOWorker* io_worker_;
   Pool* pool_;
+  uint64_t deadline_ns_;
   uint64_t start_time_ns_;
+
+  // Only used for the slow request log
+  SlowRequestLog* slow_request_log_;
+  uint64_t execute_time_ns_;
+  unsigned attempt_count_;
+  std::vector<Address> attempted_addresses_;
+  int32_t response_size_;
+  CassError error_code_;
 };
 
 } // namespace cass
@@ -0,0 +1,43 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_REQUEST_TIMELINE_HPP_INCLUDED__
+#define __CASS_REQUEST_TIMELINE_HPP_INCLUDED__
+
+#include "cassandra.h"
+
+#include <string.h>
+#include <uv.h>
+
+namespace cass {
+
+// The timestamps of a sampled request. A stage that's reached again when the
+// request is retried keeps its latest timestamp.
+struct RequestTimeline {
+  RequestTimeline() {
+    memset(&timeline, 0, sizeof(timeline));
+  }
+
+  void record(CassRequestStage stage) {
+    timeline.timestamps[stage] = uv_hrtime();
+  }
+
+  CassRequestTimeline timeline;
+};
+
+} // namespace cass
+
+#endif
@@ -24,6 +24,9 @@
 #include "supported_response.hpp"
 #include "serialization.hpp"
 
+#include <algorithm>
+#include <string.h>
+
 namespace cass {
 
 bool ResponseMessage::allocate_body(int8_t opcode) {
@@ -47,7 +50,7 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
       return true;
 
     case CQL_OPCODE_RESULT:
-      response_body_.reset(new ResultResponse());
+      response_body_.reset(new ResultResponse(is_result_decoding_deferred_));
       return true;
 
     case CQL_OPCODE_EVENT:
@@ -67,6 +70,15 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
+bool ResponseMessage::allocate_body_buffer() {
+  if (!allocate_body(opcode_) || !response_body_) {
+    return false;
+  }
+  response_body_->set_buffer(length_);
+  body_buffer_pos_ = response_body_->data();
+  return true;
+}
+
 int ResponseMessage::decode(int version, char* input, size_t size) {
   char* input_pos = input;
 
@@ -93,12 +105,17 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
 
       is_header_received_ = true;
 
-      if (!allocate_body(opcode_) || !response_body_) {
+      if (body_filter_ != NULL &&
+          body_filter_(body_filter_data_, stream_, opcode_)) {
+        if (opcode_ == CQL_OPCODE_RESULT &&
+            length_ >= static_cast<int32_t>(sizeof(int32_t))) {
+          is_result_kind_pending_ = true;
+        } else {
+          is_body_discarded_ = true;
+        }
+      } else if (!allocate_body_buffer()) {
         return -1;
       }
-
-      response_body_->set_buffer(length_);
-      body_buffer_pos_ = response_body_->data();
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -108,6 +125,30 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
     }
   }
 
+  if (is_result_kind_pending_) {
+    size_t available = size - (input_pos - input);
+    size_t needed = std::min(sizeof(int32_t) - result_kind_received_, available);
+    memcpy(result_kind_buffer_ + result_kind_received_, input_pos, needed);
+    result_kind_received_ += needed;
+    input_pos += needed;
+    if (result_kind_received_ < sizeof(int32_t)) {
+      return size;
+    }
+
+    is_result_kind_pending_ = false;
+    int32_t kind = 0;
+    decode_int32(result_kind_buffer_, kind);
+    if (kind == CASS_RESULT_KIND_ROWS || kind == CASS_RESULT_KIND_VOID) {
+      is_body_discarded_ = true;
+    } else {
+      if (!allocate_body_buffer()) {
+        return -1;
+      }
+      memcpy(body_buffer_pos_, result_kind_buffer_, sizeof(int32_t));
+      body_buffer_pos_ += sizeof(int32_t);
+    }
+  }
+
   const size_t remaining = size - (input_pos - input);
   const size_t frame_size = CASS_HEADER_SIZE_V1_AND_V2 + length_;
 
@@ -116,22 +157,26 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
     size_t overage = received_ - frame_size;
     size_t needed = remaining - overage;
 
-    memcpy(body_buffer_pos_, input_pos, needed);
-    body_buffer_pos_ += needed;
-    input_pos += needed;
-    assert(body_buffer_pos_ == response_body_->data() + length_);
+    if (!is_body_discarded_) {
+      memcpy(body_buffer_pos_, input_pos, needed);
+      body_buffer_pos_ += needed;
+      assert(body_buffer_pos_ == response_body_->data() + length_);
 
-    if (!response_body_->decode(version, response_body_->data(), length_)) {
-      is_body_error_ = true;
-      return -1;
+      if (!response_body_->decode(version, response_body_->data(), length_)) {
+        is_body_error_ = true;
+        return -1;
+      }
     }
+    input_pos += needed;
 
     is_body_ready_ = true;
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
-    memcpy(body_buffer_pos_, input_pos, remaining);
-    body_buffer_pos_ += remaining;
+    if (!is_body_discarded_) {
+      memcpy(body_buffer_pos_, input_pos, remaining);
+      body_buffer_pos_ += remaining;
+    }
     return size;
   }
 
@@ -54,7 +54,15 @@ private:
 
 class ResponseMessage {
 public:
-  ResponseMessage()
+  // Called once the header has been decoded. Returning true for a result
+  // skips its body instead of copying and decoding it if it's a "rows" or
+  // "void" result. Other results (e.g. "set keyspace" and "schema change")
+  // have side effects and are always decoded.
+  typedef bool (*BodyFilter)(void* data, int8_t stream, uint8_t opcode);
+
+  ResponseMessage(bool is_result_decoding_deferred = false,
+                  BodyFilter body_filter = NULL,
+                  void* body_filter_data = NULL)
       : version_(0x02)
       , flags_(0)
       , stream_(0)
@@ -65,20 +73,33 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
-      , body_buffer_pos_(NULL) {}
+      , is_body_discarded_(false)
+      , is_result_kind_pending_(false)
+      , result_kind_received_(0)
+      , body_buffer_pos_(NULL)
+      , is_result_decoding_deferred_(is_result_decoding_deferred)
+      , body_filter_(body_filter)
+      , body_filter_data_(body_filter_data) {}
 
   uint8_t opcode() const { return opcode_; }
 
   int8_t stream() const { return stream_; }
 
+  // The size of the body
+  int32_t length() const { return length_; }
+
   ScopedPtr<Response>& response_body() { return response_body_; }
 
   bool is_body_ready() const { return is_body_ready_; }
 
+  // The response body is NULL if the body was discarded
+  bool is_body_discarded() const { return is_body_discarded_; }
+
   int decode(int version, char* input, size_t size);
 
 private:
   bool allocate_body(int8_t opcode);
+  bool allocate_body_buffer();
 
 private:
   uint8_t version_;
@@ -94,8 +115,16 @@ private:
 
   bool is_body_ready_;
   bool is_body_error_;
+  bool is_body_discarded_;
+  // The result kind is read before deciding to skip the body
+  bool is_result_kind_pending_;
+  char result_kind_buffer_[sizeof(int32_t)];
+  size_t result_kind_received_;
   ScopedPtr<Response> response_body_;
   char* body_buffer_pos_;
+  bool is_result_decoding_deferred_;
+  BodyFilter body_filter_;
+  void* body_filter_data_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResponseMessage);
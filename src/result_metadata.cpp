@@ -23,6 +23,7 @@
 #include "common.hpp"
 
 #include <iterator>
+#include <string.h>
 
 // This can be decreased to reduce hash collisions, but it will require
 // additional memory.
@@ -42,9 +43,16 @@ uint64_t fnv1a_hash_lower(StringRef s) {
     return h;
 }
 
-ResultMetadata::ResultMetadata(size_t column_count) {
+ResultMetadata::ResultMetadata(size_t column_count,
+                               const char* column_specs,
+                               size_t column_specs_size) {
   defs_.reserve(column_count);
 
+  if (column_specs != NULL && column_specs_size > 0) {
+    column_specs_.reset(new char[column_specs_size]);
+    memcpy(column_specs_.get(), column_specs, column_specs_size);
+  }
+
   size_t index_size = next_pow_2(static_cast<size_t>(column_count / LOAD_FACTOR) + 1);
   index_.resize(index_size, NULL);
   index_mask_ = index_size - 1;
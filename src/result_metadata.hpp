@@ -21,6 +21,7 @@
 #include "list.hpp"
 #include "fixed_vector.hpp"
 #include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
 #include "string_ref.hpp"
 
 #include <uv.h>
@@ -82,7 +83,13 @@ class ResultMetadata : public RefCounted<ResultMetadata> {
 public:
   typedef FixedVector<size_t, 16> IndexVec;
 
-  ResultMetadata(size_t column_count);
+  // The column specs are copied so that the metadata can outlive the
+  // response that it was decoded from without keeping its rows alive. The
+  // strings of the inserted column definitions are expected to point into
+  // the copy (see column_specs()).
+  ResultMetadata(size_t column_count,
+                 const char* column_specs = NULL,
+                 size_t column_specs_size = 0);
 
   const ColumnDefinition& get(size_t index) const { return defs_[index]; }
 
@@ -92,12 +99,16 @@ public:
 
   void insert(ColumnDefinition& meta);
 
+  // The metadata's own copy of the column specs, NULL if none were copied
+  char* column_specs() const { return column_specs_.get(); }
+
 private:
   static const size_t FIXED_COLUMN_META_SIZE = 16;
 
   FixedVector<ColumnDefinition, FIXED_COLUMN_META_SIZE> defs_;
   FixedVector<ColumnDefinition*, 2 * FIXED_COLUMN_META_SIZE> index_;
   size_t index_mask_;
+  ScopedPtr<char[]> column_specs_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResultMetadata);
@@ -78,6 +78,13 @@ cass_bool_t cass_result_has_more_pages(const CassResult* result) {
 
 namespace cass {
 
+// Moves a string from the response's column specs to the metadata's copy
+static void rebase_string(const char* column_specs, char* copy, char** str) {
+  if (*str != NULL) {
+    *str = copy + (*str - column_specs);
+  }
+}
+
 size_t ResultResponse::find_column_indices(StringRef name,
                                            ResultMetadata::IndexVec* result) const {
   return metadata_->get(name, result);
@@ -135,10 +142,13 @@ char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<ResultMetadata>*
       buffer = decode_string(buffer, &table_, table_size_);
     }
 
-    metadata->reset(new ResultMetadata(column_count));
+    FixedVector<ColumnDefinition, 16> defs;
+    defs.reserve(column_count);
+    char* column_specs = buffer;
 
     for (int i = 0; i < column_count; ++i) {
-      ColumnDefinition def;
+      defs.push_back(ColumnDefinition());
+      ColumnDefinition& def = defs.back();
 
       def.index = i;
 
@@ -164,7 +174,21 @@ char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<ResultMetadata>*
                                &def.collection_secondary_class,
                                def.collection_secondary_class_size);
       }
+    }
 
+    // The metadata has its own copy of the column specs so that it doesn't
+    // keep this response's buffer, which also holds the rows, alive when
+    // it's shared by later pages or by a prepared statement.
+    metadata->reset(new ResultMetadata(column_count, column_specs, buffer - column_specs));
+    char* copy = (*metadata)->column_specs();
+    for (size_t i = 0; i < defs.size(); ++i) {
+      ColumnDefinition& def = defs[i];
+      rebase_string(column_specs, copy, &def.keyspace);
+      rebase_string(column_specs, copy, &def.table);
+      rebase_string(column_specs, copy, &def.name);
+      rebase_string(column_specs, copy, &def.class_name);
+      rebase_string(column_specs, copy, &def.collection_primary_class);
+      rebase_string(column_specs, copy, &def.collection_secondary_class);
       (*metadata)->insert(def);
     }
   }
@@ -172,6 +196,10 @@ char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<ResultMetadata>*
 }
 
 void ResultResponse::decode_first_row() {
+  if (deferred_rows_ != NULL) {
+    decode_rows_metadata(deferred_rows_);
+    deferred_rows_ = NULL;
+  }
   if (row_count_ > 0) {
     first_row_.values.reserve(column_count());
     rows_ = decode_row(rows_, this, first_row_.values);
@@ -179,9 +207,24 @@ void ResultResponse::decode_first_row() {
 }
 
 bool ResultResponse::decode_rows(char* input) {
+  if (is_rows_decoding_deferred_) {
+    int32_t flags = 0;
+    decode_int32(input, flags);
+    // Results without metadata are cheap to decode and the request handler
+    // needs to know about them, everything else is decoded by the consumer
+    // in decode_first_row().
+    if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
+      deferred_rows_ = input;
+      return true;
+    }
+  }
+  decode_rows_metadata(input);
+  return true;
+}
+
+void ResultResponse::decode_rows_metadata(char* input) {
   char* buffer = decode_metadata(input, &metadata_);
   rows_ = decode_int32(buffer, row_count_);
-  return true;
 }
 
 bool ResultResponse::decode_set_keyspace(char* input) {
@@ -34,8 +34,9 @@ class ResultIterator;
 
 class ResultResponse : public Response {
 public:
-  ResultResponse()
+  ResultResponse(bool is_rows_decoding_deferred = false)
       : Response(CQL_OPCODE_RESULT)
+      , is_rows_decoding_deferred_(is_rows_decoding_deferred)
       , kind_(0)
       , has_more_pages_(false)
       , paging_state_(NULL)
@@ -49,7 +50,8 @@ public:
       , table_(NULL)
       , table_size_(0)
       , row_count_(0)
-      , rows_(NULL) {
+      , rows_(NULL)
+      , deferred_rows_(NULL) {
     first_row_.set_result(this);
   }
 
@@ -59,7 +61,7 @@ public:
 
   int32_t column_count() const { return (metadata_ ? metadata_->column_count() : 0); }
 
-  bool no_metadata() const { return !metadata_; }
+  bool no_metadata() const { return !metadata_ && deferred_rows_ == NULL; }
 
   const ScopedRefPtr<ResultMetadata>& metadata() const { return metadata_; }
 
@@ -103,6 +105,8 @@ private:
 
   bool decode_rows(char* input);
 
+  void decode_rows_metadata(char* input);
+
   bool decode_set_keyspace(char* input);
 
   bool decode_prepared(int version, char* input);
@@ -110,6 +114,7 @@ private:
   bool decode_schema_change(char* input);
 
 private:
+  bool is_rows_decoding_deferred_;
   int32_t kind_;
   bool has_more_pages_; // row data
   ScopedRefPtr<ResultMetadata> metadata_;
@@ -126,6 +131,7 @@ private:
   size_t table_size_;
   int32_t row_count_;
   char* rows_;
+  char* deferred_rows_; // rows result waiting to be decoded
   Row first_row_;
 
 private:
@@ -54,10 +54,9 @@ bool SchemaChangeHandler::has_schema_agreement(const ResponseVec& responses) {
 
   ResultResponse* local_result =
       static_cast<ResultResponse*>(responses[0]);
+  local_result->decode_first_row();
 
   if (local_result->row_count() > 0) {
-    local_result->decode_first_row();
-
     const Row* row = &local_result->first_row();
 
     const Value* v = row->get_by_name("schema_version");
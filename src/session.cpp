@@ -17,14 +17,126 @@
 #include "session.hpp"
 
 #include "config.hpp"
+#include "execute_request.hpp"
 #include "logger.hpp"
+#include "metrics_export.hpp"
 #include "prepare_request.hpp"
+#include "query_request.hpp"
 #include "request_handler.hpp"
 #include "resolver.hpp"
 #include "scoped_lock.hpp"
 #include "timer.hpp"
 #include "types.hpp"
 
+#include <algorithm>
+#include <string.h>
+
+static void get_snapshot(const cass::Metrics::Histogram& histogram,
+                         bool is_interval,
+                         cass::Metrics::Histogram::Snapshot* snapshot) {
+  if (is_interval) {
+    histogram.get_interval_snapshot(snapshot);
+  } else {
+    histogram.get_snapshot(snapshot);
+  }
+}
+
+// The latency histograms only cover the requests since the previous interval
+// when "is_interval" is set. The counters and rates are always cumulative.
+static void get_metrics(const cass::Metrics* internal_metrics,
+                        bool is_interval,
+                        CassMetrics* metrics) {
+  cass::Metrics::Histogram::Snapshot requests_snapshot;
+  get_snapshot(internal_metrics->request_latencies, is_interval, &requests_snapshot);
+
+  metrics->requests.min = requests_snapshot.min;
+  metrics->requests.max = requests_snapshot.max;
+  metrics->requests.mean = requests_snapshot.mean;
+  metrics->requests.stddev = requests_snapshot.stddev;
+  metrics->requests.median = requests_snapshot.median;
+  metrics->requests.percentile_75th = requests_snapshot.percentile_75th;
+  metrics->requests.percentile_95th = requests_snapshot.percentile_95th;
+  metrics->requests.percentile_98th = requests_snapshot.percentile_98th;
+  metrics->requests.percentile_99th = requests_snapshot.percentile_99th;
+  metrics->requests.percentile_999th = requests_snapshot.percentile_999th;
+
+  metrics->requests.one_minute_rate = internal_metrics->request_rates.one_minute_rate();
+  metrics->requests.five_minute_rate = internal_metrics->request_rates.five_minute_rate();
+  metrics->requests.fifteen_minute_rate = internal_metrics->request_rates.fifteen_minute_rate();
+  metrics->requests.mean_rate = internal_metrics->request_rates.mean_rate();
+
+
+  metrics->stats.total_connections = internal_metrics->total_connections.sum();
+  metrics->stats.available_connections = internal_metrics->available_connections.sum();
+  metrics->stats.exceeded_write_bytes_water_mark = internal_metrics->exceeded_write_bytes_water_mark.sum();
+  metrics->stats.exceeded_pending_requests_water_mark = internal_metrics->exceeded_pending_requests_water_mark.sum();
+
+  metrics->errors.connection_timeouts = internal_metrics->connection_timeouts.sum();
+  metrics->errors.pending_request_timeouts = internal_metrics->pending_request_timeouts.sum();
+  metrics->errors.request_timeouts = internal_metrics->request_timeouts.sum();
+}
+
+static void get_extended_metrics(const cass::Metrics* internal_metrics,
+                                 bool is_interval,
+                                 CassExtendedMetrics* output,
+                                 size_t output_size) {
+  // The application might have been built using an older header with a
+  // smaller struct so only the fields that fit in its output are copied.
+  CassExtendedMetrics metrics;
+  memset(&metrics, 0, sizeof(CassExtendedMetrics));
+
+  metrics.errors.expired_before_send = internal_metrics->expired_before_send.sum();
+
+  metrics.discarded.results = internal_metrics->discarded_results.sum();
+  metrics.discarded.errors = internal_metrics->discarded_errors.sum();
+
+  for (int i = CASS_REQUEST_STAGE_CREATED; i < CASS_REQUEST_STAGE_LAST_ENTRY; ++i) {
+    cass::Metrics::Histogram::Snapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+    const cass::Metrics::Histogram* histogram =
+        internal_metrics->request_stage_latencies(static_cast<CassRequestStage>(i));
+    if (histogram != NULL) {
+      get_snapshot(*histogram, is_interval, &snapshot);
+    }
+
+    metrics.request_stages[i].min = snapshot.min;
+    metrics.request_stages[i].max = snapshot.max;
+    metrics.request_stages[i].mean = snapshot.mean;
+    metrics.request_stages[i].stddev = snapshot.stddev;
+    metrics.request_stages[i].median = snapshot.median;
+    metrics.request_stages[i].percentile_75th = snapshot.percentile_75th;
+    metrics.request_stages[i].percentile_95th = snapshot.percentile_95th;
+    metrics.request_stages[i].percentile_98th = snapshot.percentile_98th;
+    metrics.request_stages[i].percentile_99th = snapshot.percentile_99th;
+    metrics.request_stages[i].percentile_999th = snapshot.percentile_999th;
+  }
+
+  metrics.request_timelines.sampled = internal_metrics->sampled_request_timelines.sum();
+  metrics.request_timelines.dropped = internal_metrics->dropped_request_timelines.sum();
+
+  metrics.slow_requests.total = internal_metrics->slow_requests.sum();
+  metrics.slow_requests.suppressed = internal_metrics->suppressed_slow_requests.sum();
+
+  for (int i = CASS_REQUEST_PRIORITY_NORMAL; i <= CASS_REQUEST_PRIORITY_HIGH; ++i) {
+    cass::Metrics::Histogram::Snapshot snapshot;
+    get_snapshot(internal_metrics->priority_request_latencies(static_cast<CassRequestPriority>(i)),
+                 is_interval, &snapshot);
+
+    metrics.priority_requests[i].min = snapshot.min;
+    metrics.priority_requests[i].max = snapshot.max;
+    metrics.priority_requests[i].mean = snapshot.mean;
+    metrics.priority_requests[i].stddev = snapshot.stddev;
+    metrics.priority_requests[i].median = snapshot.median;
+    metrics.priority_requests[i].percentile_75th = snapshot.percentile_75th;
+    metrics.priority_requests[i].percentile_95th = snapshot.percentile_95th;
+    metrics.priority_requests[i].percentile_98th = snapshot.percentile_98th;
+    metrics.priority_requests[i].percentile_99th = snapshot.percentile_99th;
+    metrics.priority_requests[i].percentile_999th = snapshot.percentile_999th;
+  }
+
+  memcpy(output, &metrics, std::min(output_size, sizeof(CassExtendedMetrics)));
+}
+
 extern "C" {
 
 CassSession* cass_session_new() {
@@ -91,42 +203,72 @@ CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* ba
   return CassFuture::to(session->execute(batch->from()));
 }
 
+CassError cass_session_execute_discard(CassSession* session,
+                                       const CassStatement* statement,
+                                       CassRequestErrorCallback callback,
+                                       void* data) {
+  return session->execute_discard(statement->from(), callback, data);
+}
+
+CassError cass_session_execute_batch_discard(CassSession* session,
+                                             const CassBatch* batch,
+                                             CassRequestErrorCallback callback,
+                                             void* data) {
+  return session->execute_discard(batch->from(), callback, data);
+}
+
 const CassSchema* cass_session_get_schema(CassSession* session) {
   return CassSchema::to(session->copy_schema());
 }
 
 void  cass_session_get_metrics(CassSession* session,
                                CassMetrics* metrics) {
-  const cass::Metrics* internal_metrics = session->metrics();
+  get_metrics(session->metrics(), false, metrics);
+}
 
-  cass::Metrics::Histogram::Snapshot requests_snapshot;
-  internal_metrics->request_latencies.get_snapshot(&requests_snapshot);
+void cass_session_get_interval_metrics(CassSession* session,
+                                       CassMetrics* metrics) {
+  get_metrics(session->metrics(), true, metrics);
+}
 
-  metrics->requests.min = requests_snapshot.min;
-  metrics->requests.max = requests_snapshot.max;
-  metrics->requests.mean = requests_snapshot.mean;
-  metrics->requests.stddev = requests_snapshot.stddev;
-  metrics->requests.median = requests_snapshot.median;
-  metrics->requests.percentile_75th = requests_snapshot.percentile_75th;
-  metrics->requests.percentile_95th = requests_snapshot.percentile_95th;
-  metrics->requests.percentile_98th = requests_snapshot.percentile_98th;
-  metrics->requests.percentile_99th = requests_snapshot.percentile_99th;
-  metrics->requests.percentile_999th = requests_snapshot.percentile_999th;
+void cass_session_get_extended_metrics(CassSession* session,
+                                       CassExtendedMetrics* output,
+                                       size_t output_size) {
+  get_extended_metrics(session->metrics(), false, output, output_size);
+}
 
-  metrics->requests.one_minute_rate = internal_metrics->request_rates.one_minute_rate();
-  metrics->requests.five_minute_rate = internal_metrics->request_rates.five_minute_rate();
-  metrics->requests.fifteen_minute_rate = internal_metrics->request_rates.fifteen_minute_rate();
-  metrics->requests.mean_rate = internal_metrics->request_rates.mean_rate();
+void cass_session_get_interval_extended_metrics(CassSession* session,
+                                                CassExtendedMetrics* output,
+                                                size_t output_size) {
+  get_extended_metrics(session->metrics(), true, output, output_size);
+}
 
+CassError cass_session_export_metrics(CassSession* session,
+                                      CassMetricsFormat format,
+                                      char* output,
+                                      size_t* output_size) {
+  if (format != CASS_METRICS_FORMAT_PROMETHEUS &&
+      format != CASS_METRICS_FORMAT_JSON) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
 
-  metrics->stats.total_connections = internal_metrics->total_connections.sum();
-  metrics->stats.available_connections = internal_metrics->available_connections.sum();
-  metrics->stats.exceeded_write_bytes_water_mark = internal_metrics->exceeded_write_bytes_water_mark.sum();
-  metrics->stats.exceeded_pending_requests_water_mark = internal_metrics->exceeded_pending_requests_water_mark.sum();
+  std::string metrics;
+  session->export_metrics(format, &metrics);
 
-  metrics->errors.connection_timeouts = internal_metrics->connection_timeouts.sum();
-  metrics->errors.pending_request_timeouts = internal_metrics->pending_request_timeouts.sum();
-  metrics->errors.request_timeouts = internal_metrics->request_timeouts.sum();
+  size_t size = metrics.size() + 1;
+  if (output == NULL || *output_size < size) {
+    *output_size = size;
+    return CASS_ERROR_LIB_BUFFER_TOO_SMALL;
+  }
+  memcpy(output, metrics.c_str(), size);
+  *output_size = size;
+  return CASS_OK;
+}
+
+size_t cass_session_drain_request_timelines(CassSession* session,
+                                            CassRequestTimeline* output,
+                                            size_t count) {
+  return session->drain_request_timelines(output, count);
 }
 
 } // extern "C"
@@ -139,20 +281,36 @@ Session::Session()
     , pending_resolve_count_(0)
     , pending_pool_count_(0)
     , pending_workers_count_(0)
-    , current_io_worker_(0) {
+    , current_io_worker_(0)
+    , timeline_sample_count_(0)
+    , current_timeline_io_worker_(0) {
   uv_mutex_init(&state_mutex_);
   uv_mutex_init(&hosts_mutex_);
+  uv_mutex_init(&prepared_hosts_mutex_);
+  uv_mutex_init(&timelines_mutex_);
 }
 
 Session::~Session() {
   join();
   uv_mutex_destroy(&state_mutex_);
   uv_mutex_destroy(&hosts_mutex_);
+  uv_mutex_destroy(&prepared_hosts_mutex_);
+  uv_mutex_destroy(&timelines_mutex_);
 }
 
 void Session::clear(const Config& config) {
   config_ = config;
-  metrics_.reset(new Metrics(config_.thread_count_io() + 1));
+  metrics_.reset(new Metrics(io_thread_count() + 1,
+                             config_.histogram_highest_latency_us(),
+                             config_.histogram_significant_figures()));
+  if (config_.request_timeline_sample_rate() > 0) {
+    metrics_->enable_request_stage_latencies();
+  }
+  if (config_.host_latency_histograms()) {
+    metrics_->enable_host_latencies();
+  }
+  slow_request_log_.reset(config_.slow_request_threshold_ms() > 0
+                          ? new SlowRequestLog(config_, metrics_.get()) : NULL);
   load_balancing_policy_.reset(config.load_balancing_policy());
   connect_future_.reset();
   close_future_.reset();
@@ -163,6 +321,12 @@ void Session::clear(const Config& config) {
   io_workers_.clear();
   request_queue_.reset();
   cluster_meta_.clear();
+  prepared_cache_.clear();
+  prepared_cache_.set_max_size(config_.prepared_cache_size());
+  { // Lock prepared hosts
+    ScopedMutex l(&prepared_hosts_mutex_);
+    prepared_hosts_.clear();
+  }
   control_connection_.clear();
   current_host_mark_ = true;
   pending_resolve_count_ = 0;
@@ -179,8 +343,16 @@ int Session::init() {
   rc = request_queue_->init(loop(), this, &Session::on_execute);
   if (rc != 0) return rc;
 
-  for (unsigned int i = 0; i < config_.thread_count_io(); ++i) {
-    SharedRefPtr<IOWorker> io_worker(new IOWorker(this));
+  IOThreadGroup* io_thread_group = config_.io_thread_group();
+  if (io_thread_group != NULL) {
+    rc = io_thread_group->start();
+    if (rc != 0) return rc;
+  }
+
+  // The session has an IO worker for each of the shared IO threads
+  for (unsigned int i = 0; i < io_thread_count(); ++i) {
+    IOThread* thread = io_thread_group != NULL ? io_thread_group->thread(i) : NULL;
+    SharedRefPtr<IOWorker> io_worker(new IOWorker(this, thread));
     int rc = io_worker->init();
     if (rc != 0) return rc;
     io_workers_.push_back(io_worker);
@@ -189,6 +361,34 @@ int Session::init() {
   return rc;
 }
 
+void Session::export_metrics(CassMetricsFormat format, std::string* output) const {
+  IOWorkerStatsVec io_workers(io_workers_.size());
+  for (size_t i = 0; i < io_workers_.size(); ++i) {
+    io_workers[i].request_queue_size = io_workers_[i]->request_queue_size();
+    io_workers[i].loop_metrics = io_workers_[i]->loop_metrics();
+  }
+  cass::export_metrics(metrics_.get(), io_workers, format, output);
+}
+
+size_t Session::drain_request_timelines(CassRequestTimeline* output, size_t count) {
+  ScopedMutex l(&timelines_mutex_);
+  size_t drained = 0;
+  size_t size = io_workers_.size();
+  // Drain the IO workers in turns so that a busy worker doesn't starve the others
+  size_t empty_count = 0;
+  while (drained < count && empty_count < size) {
+    const SharedRefPtr<IOWorker>& io_worker
+        = io_workers_[current_timeline_io_worker_++ % size];
+    if (io_worker->drain_timeline(&output[drained])) {
+      drained++;
+      empty_count = 0;
+    } else {
+      empty_count++;
+    }
+  }
+  return drained;
+}
+
 void Session::broadcast_keyspace_change(const std::string& keyspace,
                                         const IOWorker* calling_io_worker) {
   // This can run on an IO worker thread. This is thread-safe because the IO workers
@@ -383,9 +583,22 @@ void Session::close_handles() {
   load_balancing_policy_->close_handles();
 }
 
+unsigned Session::io_thread_count() const {
+  IOThreadGroup* io_thread_group = config_.io_thread_group();
+  if (io_thread_group != NULL) {
+    return io_thread_group->thread_count();
+  }
+  return config_.thread_count_io();
+}
+
 void Session::on_run() {
-  LOG_INFO("Creating %u IO worker threads",
-           static_cast<unsigned int>(io_workers_.size()));
+  if (config_.io_thread_group() != NULL) {
+    LOG_INFO("Using %u shared IO threads",
+             static_cast<unsigned int>(io_workers_.size()));
+  } else {
+    LOG_INFO("Creating %u IO worker threads",
+             static_cast<unsigned int>(io_workers_.size()));
+  }
 
   for (IOWorkerVec::iterator it = io_workers_.begin(), end = io_workers_.end();
        it != end; ++it) {
@@ -472,7 +685,19 @@ void Session::on_resolve(Resolver* resolver) {
   }
 }
 
+void Session::track_request(RequestHandler* request_handler) {
+  unsigned sample_rate = config_.request_timeline_sample_rate();
+  if (sample_rate > 0 && timeline_sample_count_.fetch_add(1) % sample_rate == 0) {
+    request_handler->enable_timeline();
+    request_handler->record_stage(CASS_REQUEST_STAGE_CREATED);
+  }
+  if (slow_request_log_) {
+    request_handler->set_slow_request_log(slow_request_log_.get());
+  }
+}
+
 void Session::execute(RequestHandler* request_handler) {
+  track_request(request_handler);
   if (!request_queue_->enqueue(request_handler)) {
     request_handler->on_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
                               "The request queue has reached capacity");
@@ -502,13 +727,26 @@ void Session::on_control_connection_error(CassError code, const std::string& mes
 }
 
 Future* Session::prepare(const char* statement, size_t length) {
-  PrepareRequest* prepare = new PrepareRequest();
-  prepare->set_query(statement, length);
-
-  ResponseFuture* future = new ResponseFuture(cluster_meta_.schema());
+  ResponseFuture* future = new ResponseFuture();
   future->inc_ref(); // External reference
   future->statement.assign(statement, length);
 
+  if (!io_workers_.empty()) {
+    future->keyspace = io_workers_[0]->keyspace();
+  }
+
+  // Cached statements are removed when their table is altered or dropped,
+  // or when a host no longer has them, so they're still current
+  SharedRefPtr<const Prepared> prepared(prepared_cache_.get(future->keyspace,
+                                                            future->statement));
+  if (prepared) {
+    future->set_prepared(Address(), prepared);
+    return future;
+  }
+
+  PrepareRequest* prepare = new PrepareRequest();
+  prepare->set_query(statement, length);
+
   RequestHandler* request_handler = new RequestHandler(prepare, future);
   request_handler->inc_ref(); // IOWorker reference
 
@@ -542,6 +780,11 @@ void Session::on_remove(SharedRefPtr<Host> host) {
     ScopedMutex l(&hosts_mutex_);
     hosts_.erase(host->address());
   }
+  { // Lock prepared hosts
+    ScopedMutex l(&prepared_hosts_mutex_);
+    prepared_hosts_.erase(host->address());
+  }
+  metrics_->remove_host_metrics(host->address());
   for (IOWorkerVec::iterator it = io_workers_.begin(),
        end = io_workers_.end(); it != end; ++it) {
     (*it)->remove_pool_async(host->address(), true);
@@ -566,6 +809,10 @@ void Session::on_up(SharedRefPtr<Host> host) {
 void Session::on_down(SharedRefPtr<Host> host) {
   host->set_down();
   load_balancing_policy_->on_down(host);
+  { // Lock prepared hosts
+    ScopedMutex l(&prepared_hosts_mutex_);
+    prepared_hosts_.erase(host->address());
+  }
 
   bool cancel_reconnect = false;
   if (load_balancing_policy_->distance(host) == CASS_HOST_DISTANCE_IGNORE) {
@@ -580,10 +827,10 @@ void Session::on_down(SharedRefPtr<Host> host) {
 }
 
 Future* Session::execute(const RoutableRequest* request) {
-  ResponseFuture* future = new ResponseFuture(cluster_meta_.schema());
+  ResponseFuture* future = new ResponseFuture();
   future->inc_ref(); // External reference
 
-  RequestHandler* request_handler = new RequestHandler(request, future);
+  RequestHandler* request_handler = new RequestHandler(maybe_auto_prepare(request), future);
   request_handler->inc_ref(); // IOWorker reference
 
   execute(request_handler);
@@ -591,6 +838,22 @@ Future* Session::execute(const RoutableRequest* request) {
   return future;
 }
 
+CassError Session::execute_discard(const RoutableRequest* request,
+                                   CassRequestErrorCallback callback,
+                                   void* data) {
+  RequestHandler* request_handler
+      = new RequestHandler(maybe_auto_prepare(request), callback, data, metrics_.get());
+  request_handler->inc_ref(); // IOWorker reference
+
+  track_request(request_handler);
+  if (!request_queue_->enqueue(request_handler)) {
+    request_handler->dec_ref();
+    return CASS_ERROR_LIB_REQUEST_QUEUE_FULL;
+  }
+
+  return CASS_OK;
+}
+
 #if UV_VERSION_MAJOR == 0
 void Session::on_execute(uv_async_t* data, int status) {
 #else
@@ -603,6 +866,7 @@ void Session::on_execute(uv_async_t* data) {
   RequestHandler* request_handler = NULL;
   while (session->request_queue_->dequeue(request_handler)) {
     if (request_handler != NULL) {
+      request_handler->record_stage(CASS_REQUEST_STAGE_SESSION);
       request_handler->set_query_plan(session->new_query_plan(request_handler->request()));
 
       bool is_done = false;
@@ -643,6 +907,54 @@ void Session::on_execute(uv_async_t* data) {
   }
 }
 
+const RoutableRequest* Session::maybe_auto_prepare(const RoutableRequest* request) {
+  unsigned threshold = config_.auto_prepare_threshold();
+  if (threshold == 0 || request->opcode() != CQL_OPCODE_QUERY) {
+    return request;
+  }
+
+  const QueryRequest* query = static_cast<const QueryRequest*>(request);
+  if (!query->paging_state().empty()) {
+    // The paging state is only valid for the original query
+    return request;
+  }
+
+  std::string keyspace;
+  if (!io_workers_.empty()) {
+    keyspace = io_workers_[0]->keyspace();
+  }
+
+  SharedRefPtr<const Prepared> prepared(prepared_cache_.get(keyspace, query->query()));
+  if (prepared) {
+    if (prepared->result()->column_count() != static_cast<int>(query->values_count())) {
+      return request;
+    }
+    ExecuteRequest* execute = new ExecuteRequest(prepared.get());
+    execute->copy_values_and_settings(*query);
+    return execute;
+  }
+
+  if (prepared_cache_.record_execution(keyspace, query->query(), threshold)) {
+    LOG_DEBUG("Automatically preparing query \"%s\"", query->query().c_str());
+    prepare(query->query().data(), query->query().size())->dec_ref();
+  }
+  return request;
+}
+
+bool Session::claim_prepare_on_host(const Address& address) {
+  ScopedMutex l(&prepared_hosts_mutex_);
+  return prepared_hosts_.insert(address).second;
+}
+
+CopyOnWriteHostVec Session::get_replicas(const std::string& keyspace,
+                                         const std::string& routing_key) const {
+  if (keyspace.empty() && !io_workers_.empty()) {
+    // The IO worker vector never changes after initialization
+    return cluster_meta_.get_replicas(io_workers_[0]->keyspace(), routing_key);
+  }
+  return cluster_meta_.get_replicas(keyspace, routing_key);
+}
+
 QueryPlan* Session::new_query_plan(const Request* request) {
   std::string connected_keyspace;
   if (!io_workers_.empty()) {
@@ -27,11 +27,13 @@
 #include "load_balancing.hpp"
 #include "metrics.hpp"
 #include "mpmc_queue.hpp"
+#include "prepared.hpp"
 #include "ref_counted.hpp"
 #include "row.hpp"
 #include "schema_metadata.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
+#include "slow_request_log.hpp"
 
 #include <list>
 #include <memory>
@@ -80,6 +82,10 @@ public:
   const Config& config() const { return config_; }
   Metrics* metrics() const { return metrics_.get(); }
 
+  void export_metrics(CassMetricsFormat format, std::string* output) const;
+
+  size_t drain_request_timelines(CassRequestTimeline* output, size_t count);
+
   void set_load_balancing_policy(LoadBalancingPolicy* policy) {
     load_balancing_policy_.reset(policy);
   }
@@ -99,13 +105,37 @@ public:
 
   Future* prepare(const char* statement, size_t length);
   Future* execute(const RoutableRequest* statement);
+  CassError execute_discard(const RoutableRequest* statement,
+                            CassRequestErrorCallback callback, void* data);
 
   const Schema* copy_schema() const { return cluster_meta_.copy_schema(); }
 
+  void get_table_key_columns(const std::string& keyspace,
+                             const std::string& table,
+                             std::vector<std::string>* output) const {
+    cluster_meta_.get_table_key_columns(keyspace, table, output);
+  }
+
+  bool get_int64_token(const std::string& routing_key, int64_t* token) const {
+    return cluster_meta_.get_int64_token(routing_key, token);
+  }
+
+  PreparedCache& prepared_cache() { return prepared_cache_; }
+
+  // Returns true only for the first IO worker's pool that becomes ready after
+  // the host is added or comes back up. Synchronized.
+  bool claim_prepare_on_host(const Address& address);
+
+  // Synchronized, the session's keyspace is used if the keyspace is empty
+  CopyOnWriteHostVec get_replicas(const std::string& keyspace,
+                                  const std::string& routing_key) const;
+
 private:
   void clear(const Config& config);
   int init();
 
+  unsigned io_thread_count() const;
+
   void close_handles();
 
   void internal_connect();
@@ -116,6 +146,12 @@ private:
   void notify_closed();
 
   void execute(RequestHandler* request_handler);
+  // Samples the request's timeline and checks if it's slow once it's finished
+  void track_request(RequestHandler* request_handler);
+
+  // Returns a prepared statement for simple statements with queries that
+  // have been executed enough times to be automatically prepared
+  const RoutableRequest* maybe_auto_prepare(const RoutableRequest* request);
 
   virtual void on_run();
   virtual void on_after_run();
@@ -160,6 +196,7 @@ private:
 
   Config config_;
   ScopedPtr<Metrics> metrics_;
+  ScopedPtr<SlowRequestLog> slow_request_log_;
   ScopedRefPtr<LoadBalancingPolicy> load_balancing_policy_;
   ScopedRefPtr<Future> connect_future_;
   ScopedRefPtr<Future> close_future_;
@@ -170,12 +207,18 @@ private:
   IOWorkerVec io_workers_;
   ScopedPtr<AsyncQueue<MPMCQueue<RequestHandler*> > > request_queue_;
   ClusterMetadata cluster_meta_;
+  PreparedCache prepared_cache_;
+  AddressSet prepared_hosts_;
+  uv_mutex_t prepared_hosts_mutex_;
   ControlConnection control_connection_;
   bool current_host_mark_;
   int pending_resolve_count_;
   int pending_pool_count_;
   int pending_workers_count_;
   int current_io_worker_;
+  Atomic<unsigned> timeline_sample_count_;
+  uv_mutex_t timelines_mutex_;
+  size_t current_timeline_io_worker_;
 };
 
 class SessionFuture : public Future {
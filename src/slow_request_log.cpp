@@ -0,0 +1,79 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "slow_request_log.hpp"
+
+#include "config.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+
+namespace cass {
+
+SlowRequestLog::SlowRequestLog(const Config& config, Metrics* metrics)
+  : threshold_ns_(static_cast<uint64_t>(config.slow_request_threshold_ms()) * 1000 * 1000)
+  , sample_rate_(std::max(config.slow_request_sample_rate(), 1U))
+  , max_per_second_(config.slow_request_max_per_second())
+  , callback_(config.slow_request_callback())
+  , callback_data_(config.slow_request_callback_data())
+  , metrics_(metrics)
+  , slow_count_(0)
+  , window_(0)
+  , window_count_(0) {}
+
+bool SlowRequestLog::is_reported() {
+  metrics_->slow_requests.inc();
+
+  if (slow_count_.fetch_add(1) % sample_rate_ != 0) {
+    metrics_->suppressed_slow_requests.inc();
+    return false;
+  }
+
+  if (max_per_second_ > 0) {
+    // The requests are counted in one second windows. The first thread to
+    // see a new window resets the count.
+    uint64_t window = uv_hrtime() / (1000 * 1000 * 1000);
+    uint64_t current = window_.load();
+    if (current != window && window_.compare_exchange_strong(current, window)) {
+      window_count_.store(0);
+    }
+    if (window_count_.fetch_add(1) >= max_per_second_) {
+      metrics_->suppressed_slow_requests.inc();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void SlowRequestLog::report(const CassSlowRequest& request) const {
+  if (callback_ != NULL) {
+    callback_(&request, callback_data_);
+    return;
+  }
+
+  LOG_WARN("Slow request (%u ms, %u retries, %u response bytes, error '%s') "
+           "on hosts %.*s: %.*s",
+           static_cast<unsigned int>(request.latency / 1000),
+           request.retries,
+           static_cast<unsigned int>(request.response_size),
+           cass_error_desc(request.error),
+           static_cast<int>(request.hosts_length), request.hosts,
+           static_cast<int>(request.query_length), request.query);
+}
+
+} // namespace cass
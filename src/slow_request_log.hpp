@@ -0,0 +1,68 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_SLOW_REQUEST_LOG_HPP_INCLUDED__
+#define __CASS_SLOW_REQUEST_LOG_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "macros.hpp"
+#include "metrics.hpp"
+
+#include <uv.h>
+
+namespace cass {
+
+class Config;
+
+// Reports requests that take longer than the slow request threshold. Slow
+// requests are sampled and rate limited so that a burst of them (e.g. when a
+// host is overloaded) doesn't slow down the IO threads further.
+class SlowRequestLog {
+public:
+  SlowRequestLog(const Config& config, Metrics* metrics);
+
+  bool is_slow(uint64_t latency_ns) const {
+    return latency_ns >= threshold_ns_;
+  }
+
+  // Counts a slow request and returns true if it should be reported. It's
+  // only called by the IO threads.
+  bool is_reported();
+
+  // Calls the slow request callback or logs the request as a warning
+  void report(const CassSlowRequest& request) const;
+
+private:
+  const uint64_t threshold_ns_;
+  const unsigned sample_rate_;
+  const unsigned max_per_second_;
+  CassSlowRequestCallback callback_;
+  void* callback_data_;
+  Metrics* metrics_;
+
+  Atomic<uint64_t> slow_count_;
+  Atomic<uint64_t> window_;
+  Atomic<unsigned> window_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SlowRequestLog);
+};
+
+} // namespace cass
+
+#endif
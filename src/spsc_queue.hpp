@@ -75,6 +75,12 @@ public:
         tail_.load(MEMORY_ORDER_ACQUIRE);
   }
 
+  // Approximate when called concurrently with enqueue() or dequeue()
+  size_t size() const {
+    return (tail_.load(MEMORY_ORDER_ACQUIRE) -
+            head_.load(MEMORY_ORDER_ACQUIRE)) & mask_;
+  }
+
   static void memory_fence() {
    // Internally, libuv has a "pending" flag check whose load can be reordered
    // before storing the data into the queue causing the data in the queue
@@ -26,6 +26,8 @@
 
 #include <uv.h>
 
+#include <limits>
+
 namespace cass {
 
   template<class T>
@@ -202,6 +204,11 @@ void cass_statement_free(CassStatement* statement) {
   statement->dec_ref();
 }
 
+CassError cass_statement_reset(CassStatement* statement) {
+  statement->reset_values();
+  return CASS_OK;
+}
+
 CassError cass_statement_set_consistency(CassStatement* statement,
                                          CassConsistency consistency) {
   statement->set_consistency(consistency);
@@ -214,6 +221,22 @@ CassError cass_statement_set_serial_consistency(CassStatement* statement,
   return CASS_OK;
 }
 
+CassError cass_statement_set_request_timeout(CassStatement* statement,
+                                             cass_uint64_t timeout_ms) {
+  statement->set_request_timeout_ms(timeout_ms);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_priority(CassStatement* statement,
+                                      CassRequestPriority priority) {
+  if (priority != CASS_REQUEST_PRIORITY_NORMAL &&
+      priority != CASS_REQUEST_PRIORITY_HIGH) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  statement->set_priority(priority);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_paging_size(CassStatement* statement,
                                          int page_size) {
   statement->set_page_size(page_size);
@@ -223,6 +246,12 @@ CassError cass_statement_set_paging_size(CassStatement* statement,
 CassError cass_statement_set_paging_state(CassStatement* statement,
                                           const CassResult* result) {
   statement->set_paging_state(result->paging_state());
+  // The following pages have the same columns as this page so the
+  // metadata from this result can be reused.
+  if (result->has_more_pages() && result->metadata()) {
+    statement->set_result_metadata(result->metadata().get());
+    statement->set_skip_metadata(true);
+  }
   return CASS_OK;
 }
 
@@ -268,6 +297,34 @@ CassError cass_statement_bind_string_n(CassStatement* statement, size_t index,
   return statement->bind(index, s);
 }
 
+CassError cass_statement_bind_string_no_copy(CassStatement* statement,
+                                             size_t index,
+                                             const char* value,
+                                             size_t value_length,
+                                             CassValueReleaseCallback callback,
+                                             void* data) {
+  if (index >= statement->values_count()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  // The size is encoded as an [int32]
+  if (value_length > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return statement->bind(index, new cass::ExternalBuffer(value, value_length,
+                                                         callback, data));
+}
+
+CassError cass_statement_bind_bytes_no_copy(CassStatement* statement,
+                                            size_t index,
+                                            const cass_byte_t* value,
+                                            size_t value_size,
+                                            CassValueReleaseCallback callback,
+                                            void* data) {
+  return cass_statement_bind_string_no_copy(statement, index,
+                                            reinterpret_cast<const char*>(value),
+                                            value_size, callback, data);
+}
+
 CassError cass_statement_bind_bytes(CassStatement* statement, size_t index,
                                     const cass_byte_t* value,
                                     size_t value_size) {
@@ -521,56 +578,192 @@ CassError cass_statement_bind_collection_by_name_n(CassStatement* statement,
 
 namespace cass {
 
-static int32_t decode_buffer_size(const Buffer& buffer) {
-  if (!buffer.is_buffer()) {
-    LOG_ERROR("Routing key cannot contain an empty value or a collection");
-    return -1;
+void Statement::reset_values() {
+  for (ValueVec::iterator it = values_.begin(), end = values_.end();
+       it != end; ++it) {
+    *it = ValueSlot();
+  }
+  arena_.clear(); // Keeps the arena's capacity
+  arena_garbage_ = 0;
+}
+
+void Statement::compact_arena() {
+  std::vector<char> arena;
+  arena.reserve(arena_.size() - arena_garbage_);
+  for (ValueVec::iterator it = values_.begin(), end = values_.end();
+       it != end; ++it) {
+    if (it->is_in_arena()) {
+      size_t offset = arena.size();
+      arena.insert(arena.end(),
+                   arena_.begin() + it->offset,
+                   arena_.begin() + it->offset + it->size);
+      it->offset = offset;
+      it->capacity = it->size;
+    } else {
+      it->offset = 0;
+      it->capacity = 0;
+    }
+  }
+  arena_.swap(arena);
+  arena_garbage_ = 0;
+}
+
+void Statement::copy_values_and_settings(const Statement& statement) {
+  assert(values_.size() == statement.values_.size());
+  values_ = statement.values_;
+  arena_ = statement.arena_;
+  arena_garbage_ = statement.arena_garbage_;
+  page_size_ = statement.page_size_;
+  set_consistency(statement.consistency());
+  set_serial_consistency(statement.serial_consistency());
+  set_request_timeout_ms(statement.request_timeout_ms());
+  set_priority(statement.priority());
+  if (!statement.keyspace().empty()) {
+    set_keyspace(statement.keyspace());
+  }
+  if (!statement.key_indices_.empty()) {
+    key_indices_ = statement.key_indices_;
+  }
+}
+
+bool Statement::get_value(size_t index, const char** data, int32_t* size) const {
+  const ValueSlot& slot = values_[index];
+  if (slot.buffer.is_external()) {
+    *data = slot.buffer.data();
+    *size = slot.buffer.size();
+    return true;
+  } else if (!slot.is_in_arena()) {
+    if (!slot.buffer.is_buffer()) {
+      LOG_ERROR("Routing key cannot contain an empty value or a collection");
+      return false;
+    }
+    *data = slot.buffer.data();
+  } else {
+    *data = &arena_[slot.offset];
   }
-  int32_t size;
-  decode_int32(const_cast<char*>(buffer.data()), size);
-  if (size < 0) {
+  decode_int32(const_cast<char*>(*data), *size);
+  if (*size < 0) {
     LOG_ERROR("Routing key cannot contain a null value");
+    return false;
   }
-  return size;
+  *data += sizeof(int32_t);
+  return true;
 }
 
 int32_t Statement::encode_values(int version, BufferVec* bufs) const {
   int32_t values_size = 0;
-  for (ValueVec::const_iterator it = values_.begin(), end = values_.end();
-       it != end; ++it) {
-    if (it->is_empty()) {
+  size_t i = 0;
+  const size_t count = values_.size();
+
+  while (i < count) {
+    const ValueSlot& slot = values_[i];
+
+    if (slot.buffer.is_collection()) {
+      values_size += slot.buffer.collection()->encode(version, bufs);
+      ++i;
+      continue;
+    }
+
+    if (slot.buffer.is_external()) {
+      // Only the size is copied, the value is written straight from the
+      // application's memory. An empty value is only its size, writes
+      // (and SSL encryption) don't expect empty buffers.
       Buffer buf(sizeof(int32_t));
-      buf.encode_int32(0, -1); // [bytes] "null"
+      buf.encode_int32(0, slot.buffer.size());
       bufs->push_back(buf);
-      values_size += sizeof(int32_t);
-    } else if (it->is_collection()) {
-      values_size += it->collection()->encode(version, bufs);
+      if (slot.buffer.size() > 0) {
+        bufs->push_back(slot.buffer);
+      }
+      values_size += sizeof(int32_t) + slot.buffer.size();
+      ++i;
+      continue;
+    }
+
+    if (slot.buffer.is_buffer()) {
+      bufs->push_back(slot.buffer);
+      values_size += slot.buffer.size();
+      ++i;
+      continue;
+    }
+
+    // Arena and unset values up to the next collection or custom value are
+    // copied into a single buffer. That's a single copy when the values were
+    // bound in order.
+    size_t size = 0;
+    size_t run_end = i;
+    bool is_contiguous = true;
+    size_t expected_offset = slot.offset;
+    while (run_end < count && values_[run_end].buffer.is_empty()) {
+      const ValueSlot& run_slot = values_[run_end];
+      if (!run_slot.is_in_arena() || run_slot.offset != expected_offset) {
+        is_contiguous = false;
+      }
+      size_t slot_size = run_slot.is_in_arena() ? run_slot.size : sizeof(int32_t);
+      expected_offset += slot_size;
+      size += slot_size;
+      ++run_end;
+    }
+
+    Buffer buf(size);
+    if (is_contiguous) {
+      buf.copy(0, &arena_[slot.offset], size);
     } else {
-      bufs->push_back(*it);
-      values_size += it->size();
+      size_t pos = 0;
+      for (; i < run_end; ++i) {
+        const ValueSlot& run_slot = values_[i];
+        if (run_slot.is_in_arena()) {
+          pos = buf.copy(pos, &arena_[run_slot.offset], run_slot.size);
+        } else {
+          pos = buf.encode_int32(pos, -1); // [bytes] "null"
+        }
+      }
     }
+    bufs->push_back(buf);
+    values_size += size;
+    i = run_end;
   }
+
   return values_size;
 }
 
+size_t Statement::values_size() const {
+  size_t size = 0;
+  for (ValueVec::const_iterator it = values_.begin(), end = values_.end();
+       it != end; ++it) {
+    if (it->is_in_arena()) {
+      size += it->size;
+    } else if (it->buffer.is_collection()) {
+      // [bytes] with the [short] item count
+      size += sizeof(int32_t) + sizeof(uint16_t) + it->buffer.collection()->calculate_size(2);
+    } else if (it->buffer.is_external()) {
+      size += sizeof(int32_t) + it->buffer.size();
+    } else if (it->buffer.is_buffer()) {
+      size += it->buffer.size();
+    } else {
+      size += sizeof(int32_t); // [bytes] "null"
+    }
+  }
+  return size;
+}
+
 bool Statement::get_routing_key(std::string* routing_key)  const {
   if (key_indices_.empty()) return false;
 
   if (key_indices_.size() == 1) {
       assert(key_indices_.front() < values_.size());
-      const Buffer& buffer = values_[key_indices_.front()];
-      int32_t size = decode_buffer_size(buffer);
-      if (size < 0) return false;
-      routing_key->assign(buffer.data() + sizeof(int32_t), size);
+      const char* data;
+      int32_t size;
+      if (!get_value(key_indices_.front(), &data, &size)) return false;
+      routing_key->assign(data, size);
   } else {
     size_t length = 0;
 
     for (std::vector<size_t>::const_iterator i = key_indices_.begin();
          i != key_indices_.end(); ++i) {
       assert(*i < values_.size());
-      const Buffer& buffer = values_[*i];
-      int32_t size = decode_buffer_size(buffer);
-      if (size < 0) return false;
+      const char* data;
+      int32_t size;
+      if (!get_value(*i, &data, &size)) return false;
       length += sizeof(uint16_t) + size + 1;
     }
 
@@ -579,13 +772,13 @@ bool Statement::get_routing_key(std::string* routing_key)  const {
 
     for (std::vector<size_t>::const_iterator i = key_indices_.begin();
          i != key_indices_.end(); ++i) {
-      const Buffer& buffer = values_[*i];
+      const char* data;
       int32_t size;
       char size_buf[sizeof(uint16_t)];
-      decode_int32(const_cast<char*>(buffer.data()), size);
+      get_value(*i, &data, &size);
       encode_uint16(size_buf, size);
       routing_key->append(size_buf, sizeof(uint16_t));
-      routing_key->append(buffer.data() + sizeof(int32_t), size);
+      routing_key->append(data, size);
       routing_key->push_back(0);
     }
   }
@@ -21,6 +21,7 @@
 #include "buffer_collection.hpp"
 #include "macros.hpp"
 #include "request.hpp"
+#include "result_metadata.hpp"
 
 #include <vector>
 #include <string>
@@ -60,6 +61,7 @@ public:
   Statement(uint8_t opcode, uint8_t kind, size_t value_count = 0)
       : RoutableRequest(opcode)
       , values_(value_count)
+      , arena_garbage_(0)
       , skip_metadata_(false)
       , page_size_(-1)
       , kind_(kind) {}
@@ -69,6 +71,7 @@ public:
             const std::string& keyspace)
       : RoutableRequest(opcode, keyspace)
       , values_(value_count)
+      , arena_garbage_(0)
       , skip_metadata_(false)
       , page_size_(-1)
       , kind_(kind)
@@ -94,6 +97,15 @@ public:
     paging_state_ = paging_state;
   }
 
+  // Metadata used to decode results that were sent without metadata
+  const SharedRefPtr<ResultMetadata>& result_metadata() const {
+    return result_metadata_;
+  }
+
+  void set_result_metadata(ResultMetadata* result_metadata) {
+    result_metadata_.reset(result_metadata);
+  }
+
   uint8_t kind() const { return kind_; }
 
   virtual const std::string& query() const = 0;
@@ -104,28 +116,30 @@ public:
 
   virtual bool get_routing_key(std::string* routing_key)  const;
 
-#define BIND_FIXED_TYPE(DeclType, EncodeType)						\
-  CassError bind(size_t index, const DeclType& value) { \
-    CASS_VALUE_CHECK_INDEX(index);                      \
-    Buffer buf(sizeof(int32_t) + sizeof(DeclType));     \
-    size_t pos = buf.encode_int32(0, sizeof(DeclType)); \
-    buf.encode_##EncodeType(pos, value);                \
-    values_[index] = buf;                               \
-    return CASS_OK;                                     \
+#define BIND_FIXED_TYPE(DeclType, EncodeType)            \
+  CassError bind(size_t index, const DeclType& value) {    \
+    CASS_VALUE_CHECK_INDEX(index);                         \
+    char* pos = allocate_value(index, sizeof(DeclType));   \
+    encode_##EncodeType(pos, value);                       \
+    return CASS_OK;                                        \
   }
 
   BIND_FIXED_TYPE(int32_t, int32)
   BIND_FIXED_TYPE(cass_int64_t, int64)
   BIND_FIXED_TYPE(float, float)
   BIND_FIXED_TYPE(double, double)
-  BIND_FIXED_TYPE(bool, bool)
+  BIND_FIXED_TYPE(CassUuid, uuid)
 #undef BIND_FIXED_TYPE
 
+  CassError bind(size_t index, const bool& value) {
+    CASS_VALUE_CHECK_INDEX(index);
+    encode_byte(allocate_value(index, sizeof(uint8_t)), value);
+    return CASS_OK;
+  }
+
   CassError bind(size_t index, CassNull) {
     CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(sizeof(int32_t));
-    buf.encode_int32(0, -1); // [bytes] "null"
-    values_[index] = buf;
+    allocate_value(index, -1); // [bytes] "null"
     return CASS_OK;
   }
 
@@ -137,15 +151,6 @@ public:
     return bind(index, value.data, value.size);
   }
 
-  CassError bind(size_t index, CassUuid value) {
-    CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(sizeof(int32_t) + sizeof(CassUuid));
-    size_t pos = buf.encode_int32(0, sizeof(CassUuid));
-    buf.encode_uuid(pos, value);
-    values_[index] = buf;
-    return CASS_OK;
-  }
-
   CassError bind(size_t index, CassInet value) {
     return bind(index, value.address, value.address_length);
   }
@@ -156,11 +161,9 @@ public:
 
   CassError bind(size_t index, const uint8_t* varint, size_t varint_size, int32_t scale) {
     CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(sizeof(int32_t) + sizeof(int32_t) + varint_size);
-    size_t pos = buf.encode_int32(0, sizeof(int32_t) + varint_size);
-    pos = buf.encode_int32(pos, scale);
-    buf.copy(pos, varint, varint_size);
-    values_[index] = buf;
+    char* pos = allocate_value(index, sizeof(int32_t) + varint_size);
+    encode_int32(pos, scale);
+    memcpy(pos + sizeof(int32_t), varint, varint_size);
     return CASS_OK;
   }
 
@@ -169,25 +172,28 @@ public:
     if (collection->is_map() && collection->item_count() % 2 != 0) {
       return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
     }
-    values_[index] = Buffer(collection);
+    ValueSlot& slot = values_[index];
+    slot.size = 0;
+    slot.buffer = Buffer(collection);
     return CASS_OK;
   }
 
   CassError bind(size_t index, CassCustom custom) {
     CASS_VALUE_CHECK_INDEX(index);
+    // The application writes the value after it's bound so it can't be
+    // stored in the arena which can be moved by a later bind.
     Buffer buf(4 + custom.output_size);
     size_t pos = buf.encode_int32(0, custom.output_size);
     *(custom.output) = reinterpret_cast<uint8_t*>(buf.data() + pos);
-    values_[index] = buf;
+    ValueSlot& slot = values_[index];
+    slot.size = 0;
+    slot.buffer = buf;
     return CASS_OK;
   }
 
   CassError bind(size_t index, const char* value, size_t value_length) {
     CASS_VALUE_CHECK_INDEX(index);
-    Buffer buf(sizeof(int32_t) + value_length);
-    size_t pos = buf.encode_int32(0, value_length);
-    buf.copy(pos, value, value_length);
-    values_[index] = buf;
+    memcpy(allocate_value(index, value_length), value, value_length);
     return CASS_OK;
   }
 
@@ -195,15 +201,91 @@ public:
     return bind(index, reinterpret_cast<const char*>(value), value_length);
   }
 
+  // References the application's memory instead of copying it
+  CassError bind(size_t index, const ExternalBuffer* external) {
+    CASS_VALUE_CHECK_INDEX(index);
+    ValueSlot& slot = values_[index];
+    slot.size = 0;
+    slot.buffer = Buffer(external);
+    return CASS_OK;
+  }
+
+  // Unbinds all the values so that the statement can be reused
+  void reset_values();
+
+  // Copies the bound values, routing and paging settings of a statement
+  // with the same number of values. It's used to execute a query as a
+  // prepared statement.
+  void copy_values_and_settings(const Statement& statement);
+
   int32_t encode_values(int version, BufferVec*  bufs) const;
 
+  // The size of the encoded values (version 2), without encoding them
+  size_t values_size() const;
+
+  // The number of bytes used by the arena, including regions that were
+  // abandoned by a value that was bound again with a larger size
+  size_t arena_size() const { return arena_.size(); }
+
 private:
-  typedef BufferVec ValueVec;
+  // Bound values are stored in wire format ([bytes]) in a single arena. A
+  // value that's not in the arena (size is 0) is either unset, a collection,
+  // a custom value that's kept in its own buffer or an external buffer. A
+  // slot keeps its region (capacity) so that it can be reused by the next
+  // value that fits.
+  struct ValueSlot {
+    ValueSlot()
+      : offset(0)
+      , size(0)
+      , capacity(0) {}
+
+    bool is_in_arena() const { return size > 0; }
+
+    size_t offset;
+    size_t size;
+    size_t capacity;
+    Buffer buffer;
+  };
+
+  typedef std::vector<ValueSlot> ValueVec;
+
+  // Writes the value's [int32] size and returns where its data should be
+  // written. A value that fits in the slot's region is overwritten in place,
+  // otherwise the region is abandoned and the arena is compacted once more
+  // than half of it is abandoned.
+  char* allocate_value(size_t index, int32_t size) {
+    ValueSlot& slot = values_[index];
+    size_t total_size = sizeof(int32_t) + (size > 0 ? size : 0);
+    slot.buffer = Buffer();
+    if (total_size > slot.capacity) {
+      arena_garbage_ += slot.capacity;
+      slot.size = slot.capacity = 0;
+      if (arena_garbage_ > arena_.size() / 2) {
+        compact_arena();
+      }
+      slot.offset = arena_.size();
+      slot.capacity = total_size;
+      arena_.resize(slot.offset + total_size);
+    }
+    slot.size = total_size;
+    char* pos = &arena_[slot.offset];
+    encode_int32(pos, size);
+    return pos + sizeof(int32_t);
+  }
+
+  // Moves the values that are in the arena next to each other, in bind
+  // order, dropping the abandoned regions
+  void compact_arena();
+
+  bool get_value(size_t index, const char** data, int32_t* size) const;
 
   ValueVec values_;
+  std::vector<char> arena_;
+  size_t arena_garbage_;
   bool skip_metadata_;
   int32_t page_size_;
   std::string paging_state_;
+  SharedRefPtr<ResultMetadata> result_metadata_;
   uint8_t kind_;
   std::vector<size_t> key_indices_;
 
@@ -195,6 +195,12 @@ const CopyOnWriteHostVec& TokenMap::get_replicas(const std::string& ks_name,
   return NO_REPLICAS;
 }
 
+bool TokenMap::get_int64_token(const std::string& routing_key, int64_t* token) const {
+  if (!partitioner_) return false;
+  return partitioner_->hash_int64(reinterpret_cast<const uint8_t*>(routing_key.data()),
+                                  routing_key.size(), token);
+}
+
 void TokenMap::set_replication_strategy(const std::string& ks_name,
                                         const SharedRefPtr<ReplicationStrategy>& strategy) {
   keyspace_strategy_map_[ks_name] = strategy;
@@ -252,12 +258,19 @@ Token Murmur3Partitioner::token_from_string_ref(const StringRef& token_string_re
 
 Token Murmur3Partitioner::hash(const uint8_t* data, size_t size) const {
   Token token(sizeof(int64_t), 0);
+  int64_t token_value;
+  hash_int64(data, size, &token_value);
+  encode_uint64(&token[0], static_cast<uint64_t>(token_value) + std::numeric_limits<uint64_t>::max() / 2);
+  return token;
+}
+
+bool Murmur3Partitioner::hash_int64(const uint8_t* data, size_t size, int64_t* token) const {
   int64_t token_value = MurmurHash3_x64_128(data, size, 0);
   if (token_value == std::numeric_limits<int64_t>::min()) {
     token_value = std::numeric_limits<int64_t>::max();
   }
-  encode_uint64(&token[0], static_cast<uint64_t>(token_value) + std::numeric_limits<uint64_t>::max() / 2);
-  return token;
+  *token = token_value;
+  return true;
 }
 
 const std::string RandomPartitioner::PARTITIONER_CLASS("RandomPartitioner");
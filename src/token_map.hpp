@@ -37,6 +37,12 @@ public:
   virtual ~Partitioner() {}
   virtual Token token_from_string_ref(const StringRef& token_string_ref) const = 0;
   virtual Token hash(const uint8_t* data, size_t size) const = 0;
+
+  // The token as a signed 64-bit value. Only the Murmur3Partitioner's tokens
+  // fit in 64 bits.
+  virtual bool hash_int64(const uint8_t* data, size_t size, int64_t* token) const {
+    return false;
+  }
 };
 
 class TokenMap {
@@ -53,6 +59,9 @@ public:
   void drop_keyspace(const std::string& ks_name);
   const CopyOnWriteHostVec& get_replicas(const std::string& ks_name,
                                          const std::string& routing_key) const;
+  // Returns false if the partitioner isn't known yet or its tokens don't fit
+  // in 64 bits
+  bool get_int64_token(const std::string& routing_key, int64_t* token) const;
 
   // Testing only
   void set_replication_strategy(const std::string& ks_name,
@@ -87,6 +96,7 @@ public:
 
   virtual Token token_from_string_ref(const StringRef& token_string_ref) const;
   virtual Token hash(const uint8_t* data, size_t size) const;
+  virtual bool hash_int64(const uint8_t* data, size_t size, int64_t* token) const;
 };
 
 
@@ -23,8 +23,10 @@
 #include "session.hpp"
 #include "statement.hpp"
 #include "future.hpp"
+#include "io_thread_group.hpp"
 #include "prepared.hpp"
 #include "batch_request.hpp"
+#include "bulk_loader.hpp"
 #include "result_response.hpp"
 #include "row.hpp"
 #include "value.hpp"
@@ -66,6 +68,8 @@ EXTERNAL_TYPE(cass::Schema, CassSchema);
 EXTERNAL_TYPE(cass::SchemaMetadata, CassSchemaMeta);
 EXTERNAL_TYPE(cass::SchemaMetadataField, CassSchemaMetaField);
 EXTERNAL_TYPE(cass::UuidGen, CassUuidGen);
+EXTERNAL_TYPE(cass::BulkLoader, CassBulkLoader);
+EXTERNAL_TYPE(cass::IOThreadGroup, CassIOThreadGroup);
 
 }
 
@@ -16,6 +16,7 @@
 
 #include "value.hpp"
 
+#include "fixed_width_decoder.hpp"
 #include "types.hpp"
 
 extern "C" {
@@ -121,6 +122,56 @@ CassError cass_value_get_decimal(const CassValue* value,
   return CASS_OK;
 }
 
+CassError cass_value_get_collection_int32(const CassValue* collection,
+                                          cass_int32_t* output,
+                                          size_t output_count) {
+  if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE;
+  if (collection->primary_type() != CASS_VALUE_TYPE_INT) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+  return collection->get_fixed_width_items(sizeof(cass_int32_t),
+                                           reinterpret_cast<char*>(output),
+                                           output_count);
+}
+
+CassError cass_value_get_collection_int64(const CassValue* collection,
+                                          cass_int64_t* output,
+                                          size_t output_count) {
+  if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE;
+  if (collection->primary_type() != CASS_VALUE_TYPE_BIGINT &&
+      collection->primary_type() != CASS_VALUE_TYPE_COUNTER &&
+      collection->primary_type() != CASS_VALUE_TYPE_TIMESTAMP) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+  return collection->get_fixed_width_items(sizeof(cass_int64_t),
+                                           reinterpret_cast<char*>(output),
+                                           output_count);
+}
+
+CassError cass_value_get_collection_float(const CassValue* collection,
+                                          cass_float_t* output,
+                                          size_t output_count) {
+  if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE;
+  if (collection->primary_type() != CASS_VALUE_TYPE_FLOAT) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+  return collection->get_fixed_width_items(sizeof(cass_float_t),
+                                           reinterpret_cast<char*>(output),
+                                           output_count);
+}
+
+CassError cass_value_get_collection_double(const CassValue* collection,
+                                           cass_double_t* output,
+                                           size_t output_count) {
+  if (collection == NULL || collection->is_null()) return CASS_ERROR_LIB_NULL_VALUE;
+  if (collection->primary_type() != CASS_VALUE_TYPE_DOUBLE) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+  return collection->get_fixed_width_items(sizeof(cass_double_t),
+                                           reinterpret_cast<char*>(output),
+                                           output_count);
+}
+
 CassValueType cass_value_type(const CassValue* value) {
   return value->type();
 }
@@ -160,4 +211,19 @@ bool Value::is_collection(CassValueType t) {
   }
 }
 
+CassError Value::get_fixed_width_items(size_t width, char* output,
+                                       size_t output_count) const {
+  if (type_ != CASS_VALUE_TYPE_LIST && type_ != CASS_VALUE_TYPE_SET) {
+    return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+  }
+  if (output_count < static_cast<size_t>(count_)) {
+    return CASS_ERROR_LIB_INVALID_ITEM_COUNT;
+  }
+  if (!decode_fixed_width_collection(buffer_.data(), buffer_.size(),
+                                     count_, width, output)) {
+    return CASS_ERROR_LIB_UNEXPECTED_RESPONSE;
+  }
+  return CASS_OK;
 }
+
+} // namespace cass
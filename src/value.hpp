@@ -78,6 +78,11 @@ public:
     return buffer_;
   }
 
+  // Decodes all the items of a list or set with a fixed width primary type
+  // into a contiguous array
+  CassError get_fixed_width_items(size_t width, char* output,
+                                  size_t output_count) const;
+
 private:
   CassValueType type_;
   CassValueType primary_type_;
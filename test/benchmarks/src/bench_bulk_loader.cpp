@@ -0,0 +1,53 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "bulk_loader.hpp"
+#include "query_request.hpp"
+
+#include <stdio.h>
+
+static const size_t REPLICA_SET_COUNT = 16;
+
+// Splits statements into batches for 16 replica sets (of three hosts)
+BENCHMARK(bulk_loader_group) {
+  std::vector<cass::HostVec> replica_sets(REPLICA_SET_COUNT);
+  for (size_t i = 0; i < REPLICA_SET_COUNT; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      char address[32];
+      sprintf(address, "127.0.0.%u", static_cast<unsigned>((i + j) % REPLICA_SET_COUNT + 1));
+      replica_sets[i].push_back(cass::SharedRefPtr<cass::Host>(
+                                  new cass::Host(cass::Address(address, 9042), false)));
+    }
+  }
+
+  cass::BatchGrouper grouper(cass::BulkLoader::DEFAULT_MAX_BATCH_STATEMENTS,
+                             cass::BulkLoader::DEFAULT_MAX_BATCH_SIZE);
+  cass::BatchGrouper::BatchVec batches;
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::SharedRefPtr<cass::QueryRequest> query(
+          new cass::QueryRequest("INSERT INTO t (k, v) VALUES (?, ?)", 2));
+    query->bind(0, static_cast<cass_int64_t>(i));
+    query->bind(1, "abcdefghijklmnopqrstuvwxyz", 26);
+    grouper.add(replica_sets[i % REPLICA_SET_COUNT], query.get(), &batches);
+    benchmark::use(&batches);
+    batches.clear();
+  }
+
+  grouper.take_all(&batches);
+  benchmark::use(&batches);
+}
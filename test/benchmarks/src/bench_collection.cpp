@@ -0,0 +1,35 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "buffer_collection.hpp"
+
+static const size_t ITEM_COUNT = 1000;
+
+// Builds and encodes a set<text> with 1000 items
+BENCHMARK(collection_text_append_encode) {
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::SharedRefPtr<cass::BufferCollection> collection(
+          new cass::BufferCollection(false, ITEM_COUNT));
+    for (size_t j = 0; j < ITEM_COUNT; ++j) {
+      collection->append("abcdefghijklmnopqrstuvwxyz", 26);
+    }
+    cass::BufferVec bufs;
+    benchmark::use(&bufs);
+    collection->encode(2, &bufs);
+  }
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "benchmark.hpp"
+
+#include "mpmc_queue.hpp"
+#include "spsc_queue.hpp"
+
+#include <uv.h>
+
+#if defined(WIN32) || defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sched.h>
+#endif
+
+static const size_t QUEUE_SIZE = 1024;
+
+// Gives the other threads a chance to run when there are fewer cores than
+// threads
+static void yield() {
+#if defined(WIN32) || defined(_WIN32)
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+template <class Queue>
+struct ProducerArgs {
+  Queue* queue;
+  size_t count;
+};
+
+template <class Queue>
+static void produce(void* data) {
+  ProducerArgs<Queue>* args = static_cast<ProducerArgs<Queue>*>(data);
+  for (size_t i = 0; i < args->count; ++i) {
+    while (!args->queue->enqueue(i)) yield();
+  }
+}
+
+// Consumes "count" items on the calling thread while "num_producers" threads
+// produce them
+template <class Queue>
+static void run_producers(size_t count, size_t num_producers) {
+  Queue queue(QUEUE_SIZE);
+  uv_thread_t threads[4];
+  ProducerArgs<Queue> args[4];
+  for (size_t i = 0; i < num_producers; ++i) {
+    args[i].queue = &queue;
+    args[i].count = count / num_producers + (i < count % num_producers ? 1 : 0);
+    uv_thread_create(&threads[i], produce<Queue>, &args[i]);
+  }
+
+  size_t item = 0;
+  for (size_t i = 0; i < count; ++i) {
+    while (!queue.dequeue(item)) yield();
+  }
+  benchmark::use(&item);
+
+  for (size_t i = 0; i < num_producers; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+}
+
+// An uncontended enqueue and dequeue on the same thread
+BENCHMARK(spsc_queue_enqueue_dequeue) {
+  cass::SPSCQueue<size_t> queue(QUEUE_SIZE);
+  size_t item = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    queue.enqueue(i);
+    queue.dequeue(item);
+  }
+  benchmark::use(&item);
+}
+
+// Passes items from a producer thread to a consumer thread
+BENCHMARK(spsc_queue_producer_consumer) {
+  run_producers<cass::SPSCQueue<size_t> >(iterations, 1);
+}
+
+BENCHMARK(mpmc_queue_enqueue_dequeue) {
+  cass::MPMCQueue<size_t> queue(QUEUE_SIZE);
+  size_t item = 0;
+  for (size_t i = 0; i < iterations; ++i) {
+    queue.enqueue(i);
+    queue.dequeue(item);
+  }
+  benchmark::use(&item);
+}
+
+BENCHMARK(mpmc_queue_producer_consumer) {
+  run_producers<cass::MPMCQueue<size_t> >(iterations, 1);
+}
+
+// Four producer threads contend on the queue's tail
+BENCHMARK(mpmc_queue_4_producers) {
+  run_producers<cass::MPMCQueue<size_t> >(iterations, 4);
+}
@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "benchmark.hpp"
+
+#include "handler.hpp"
+#include "query_request.hpp"
+
+// Only used to encode requests
+class EncodeHandler : public cass::Handler {
+public:
+  EncodeHandler(const cass::Request* request)
+    : request_(request) {}
+
+  virtual const cass::Request* request() const { return request_; }
+
+  virtual void on_set(cass::ResponseMessage* response) {}
+  virtual void on_error(CassError code, const std::string& message) {}
+  virtual void on_timeout() {}
+
+private:
+  const cass::Request* request_;
+};
+
+// Encodes the frame (header, query, parameters and values) of a typical
+// write with a few values
+BENCHMARK(request_encode_query) {
+  cass::QueryRequest query("INSERT INTO ks.table (key, v1, v2, v3) VALUES (?, ?, ?, ?)", 4);
+  query.bind(0, "abcdefghijklmnop", 16);
+  query.bind(1, static_cast<cass_int64_t>(42));
+  query.bind(2, "abcdefghijklmnopqrstuvwxyz", 26);
+  query.bind(3, static_cast<cass_int32_t>(7));
+
+  EncodeHandler handler(&query);
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::BufferVec bufs;
+    benchmark::use(&bufs);
+    handler.encode(2, 0, &bufs);
+  }
+}
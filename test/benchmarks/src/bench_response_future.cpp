@@ -0,0 +1,44 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "request_handler.hpp"
+#include "schema_metadata.hpp"
+
+// The per-request cost of a response future
+BENCHMARK(response_future) {
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::ResponseFuture* future = new cass::ResponseFuture();
+    future->inc_ref();
+    benchmark::use(future);
+    future->dec_ref();
+  }
+}
+
+// The per-request cost of a response future when every future copied the
+// session's schema metadata
+BENCHMARK(response_future_schema_copy) {
+  cass::Schema schema;
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::ResponseFuture* future = new cass::ResponseFuture();
+    future->inc_ref();
+    cass::Schema* copy = new cass::Schema(schema);
+    benchmark::use(copy);
+    delete copy;
+    future->dec_ref();
+  }
+}
@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "benchmark.hpp"
+
+#include "constants.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+#include "types.hpp"
+
+#include <string.h>
+
+#include <string>
+
+static const int32_t ROW_COUNT = 100;
+
+static void append_uint16(std::string* body, uint16_t value) {
+  char buf[sizeof(uint16_t)];
+  cass::encode_uint16(buf, value);
+  body->append(buf, sizeof(buf));
+}
+
+static void append_int32(std::string* body, int32_t value) {
+  char buf[sizeof(int32_t)];
+  cass::encode_int32(buf, value);
+  body->append(buf, sizeof(buf));
+}
+
+static void append_string(std::string* body, const char* value) {
+  append_uint16(body, strlen(value));
+  body->append(value);
+}
+
+// A rows result with an "int", a "text" and a "bigint" column
+static std::string create_rows_body() {
+  const char* text = "abcdefghijklmnopqrstuvwxyz";
+
+  std::string body;
+  append_int32(&body, CASS_RESULT_KIND_ROWS);
+  append_int32(&body, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  append_int32(&body, 3);
+  append_string(&body, "ks");
+  append_string(&body, "table");
+  append_string(&body, "c1");
+  append_uint16(&body, CASS_VALUE_TYPE_INT);
+  append_string(&body, "c2");
+  append_uint16(&body, CASS_VALUE_TYPE_VARCHAR);
+  append_string(&body, "c3");
+  append_uint16(&body, CASS_VALUE_TYPE_BIGINT);
+  append_int32(&body, ROW_COUNT);
+  for (int32_t i = 0; i < ROW_COUNT; ++i) {
+    append_int32(&body, sizeof(int32_t));
+    append_int32(&body, i);
+    append_int32(&body, strlen(text));
+    body.append(text);
+    append_int32(&body, sizeof(cass_int64_t));
+    append_int32(&body, 0);
+    append_int32(&body, i);
+  }
+
+  return body;
+}
+
+// Decodes a result of 100 rows and reads every value using the public API
+BENCHMARK(result_decode_rows) {
+  std::string body(create_rows_body());
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::ResultResponse result;
+    result.decode(2, &body[0], body.size());
+
+    CassIterator* rows = cass_iterator_from_result(CassResult::to(&result));
+    while (cass_iterator_next(rows)) {
+      const CassRow* row = cass_iterator_get_row(rows);
+      cass_int32_t c1;
+      const char* c2;
+      size_t c2_size;
+      cass_int64_t c3;
+      cass_value_get_int32(cass_row_get_column(row, 0), &c1);
+      cass_value_get_string(cass_row_get_column(row, 1), &c2, &c2_size);
+      cass_value_get_int64(cass_row_get_column(row, 2), &c3);
+      benchmark::use(&c1);
+      benchmark::use(c2);
+      benchmark::use(&c3);
+    }
+    cass_iterator_free(rows);
+  }
+}
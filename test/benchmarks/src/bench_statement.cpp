@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include "query_request.hpp"
+
+static const size_t VALUE_COUNT = 20;
+
+static void bind_values(cass::Statement* statement) {
+  for (size_t i = 0; i < VALUE_COUNT; ++i) {
+    if (i % 2 == 0) {
+      statement->bind(i, static_cast<cass_int64_t>(i));
+    } else {
+      statement->bind(i, "abcdefghijklmnopqrstuvwxyz", 26);
+    }
+  }
+}
+
+// Binds and encodes the values of a new statement
+BENCHMARK(statement_bind_encode) {
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::QueryRequest query(VALUE_COUNT);
+    bind_values(&query);
+    cass::BufferVec bufs;
+    benchmark::use(&bufs);
+    query.encode_values(2, &bufs);
+  }
+}
+
+// Binds and encodes the values of a statement that's reset and reused
+BENCHMARK(statement_reset_bind_encode) {
+  cass::QueryRequest query(VALUE_COUNT);
+  for (size_t i = 0; i < iterations; ++i) {
+    query.reset_values();
+    bind_values(&query);
+    cass::BufferVec bufs;
+    benchmark::use(&bufs);
+    query.encode_values(2, &bufs);
+  }
+}
@@ -0,0 +1,50 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "benchmark.hpp"
+
+#include "stream_manager.hpp"
+
+typedef cass::StreamManager<size_t> StreamManager;
+
+// Acquires all the streams of a connection and releases them as their
+// responses are received
+BENCHMARK(stream_manager_acquire_get_item) {
+  StreamManager streams;
+  int8_t acquired[StreamManager::MAX_STREAMS];
+  size_t item = 0;
+  for (size_t i = 0; i < iterations; i += StreamManager::MAX_STREAMS) {
+    for (int j = 0; j < StreamManager::MAX_STREAMS; ++j) {
+      acquired[j] = streams.acquire_stream(j);
+    }
+    for (int j = 0; j < StreamManager::MAX_STREAMS; ++j) {
+      streams.get_item(acquired[j], item);
+    }
+  }
+  benchmark::use(&item);
+}
+
+// A single stream acquired and released at a time, the common case for
+// lightly loaded connections
+BENCHMARK(stream_manager_acquire_release) {
+  StreamManager streams;
+  for (size_t i = 0; i < iterations; ++i) {
+    int8_t stream = streams.acquire_stream(i);
+    streams.release_stream(stream);
+  }
+  benchmark::use(&streams);
+}
@@ -0,0 +1,90 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "benchmark.hpp"
+
+#include "address.hpp"
+#include "host.hpp"
+#include "random.hpp"
+#include "replication_strategy.hpp"
+#include "token_map.hpp"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+static const size_t NUM_HOSTS = 6;
+static const size_t TOKENS_PER_HOST = 256;
+static const size_t NUM_KEYS = 1024;
+
+// A ring of 6 hosts with 256 random (Murmur3) tokens each and a keyspace
+// that uses "SimpleStrategy" with a replication factor of 3
+static void build_token_map(cass::TokenMap* token_map) {
+  token_map->set_partitioner(cass::Murmur3Partitioner::PARTITIONER_CLASS);
+  token_map->set_replication_strategy("ks",
+                                      cass::SharedRefPtr<cass::ReplicationStrategy>(
+                                        new cass::SimpleStrategy(cass::SimpleStrategy::STRATEGY_CLASS, 3)));
+
+  MT19937_64 ng;
+  for (size_t i = 0; i < NUM_HOSTS; ++i) {
+    char ip[32];
+    sprintf(ip, "127.0.0.%u", static_cast<unsigned>(i + 1));
+    cass::SharedRefPtr<cass::Host> host(new cass::Host(cass::Address(ip, 9042), false));
+
+    std::vector<std::string> strings;
+    for (size_t j = 0; j < TOKENS_PER_HOST; ++j) {
+      char token[32];
+      sprintf(token, "%lld", static_cast<long long>(ng()));
+      strings.push_back(token);
+    }
+    cass::TokenStringList tokens;
+    for (size_t j = 0; j < strings.size(); ++j) {
+      tokens.push_back(cass::StringRef(strings[j]));
+    }
+    token_map->update_host(host, tokens);
+  }
+
+  token_map->build();
+}
+
+// Hashes the routing key and finds its replicas
+BENCHMARK(token_map_get_replicas) {
+  cass::TokenMap token_map;
+  build_token_map(&token_map);
+
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    char key[32];
+    sprintf(key, "key%u", static_cast<unsigned>(i));
+    keys.push_back(key);
+  }
+
+  for (size_t i = 0; i < iterations; ++i) {
+    const cass::CopyOnWriteHostVec& replicas = token_map.get_replicas("ks", keys[i % NUM_KEYS]);
+    benchmark::use(&replicas);
+  }
+}
+
+// Rebuilding the replicas of a keyspace after a topology or schema change
+BENCHMARK(token_map_build) {
+  for (size_t i = 0; i < iterations; ++i) {
+    cass::TokenMap token_map;
+    build_token_map(&token_map);
+    benchmark::use(&token_map);
+  }
+}
@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "benchmark.hpp"
+
+#include "uuids.hpp"
+
+BENCHMARK(uuid_generate_time) {
+  cass::UuidGen gen;
+  CassUuid uuid;
+  for (size_t i = 0; i < iterations; ++i) {
+    gen.generate_time(&uuid);
+  }
+  benchmark::use(&uuid);
+}
+
+BENCHMARK(uuid_generate_random) {
+  cass::UuidGen gen;
+  CassUuid uuid;
+  for (size_t i = 0; i < iterations; ++i) {
+    gen.generate_random(&uuid);
+  }
+  benchmark::use(&uuid);
+}
+
+BENCHMARK(uuid_to_string) {
+  cass::UuidGen gen;
+  CassUuid uuid;
+  gen.generate_time(&uuid);
+  char str[CASS_UUID_STRING_LENGTH];
+  for (size_t i = 0; i < iterations; ++i) {
+    cass_uuid_string(uuid, str);
+  }
+  benchmark::use(str);
+}
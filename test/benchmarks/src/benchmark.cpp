@@ -0,0 +1,142 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <uv.h>
+
+#include "cassandra.h"
+
+#include <vector>
+
+namespace benchmark {
+
+// Each benchmark is run with an increasing number of iterations until it
+// takes at least this long
+static const uint64_t MIN_ELAPSED_NS = 500 * 1000 * 1000;
+
+struct Benchmark {
+  const char* name;
+  Function function;
+};
+
+typedef std::vector<Benchmark> BenchmarkVec;
+
+static BenchmarkVec& benchmarks() {
+  // Avoids depending on the initialization order of the registrars
+  static BenchmarkVec benchmarks;
+  return benchmarks;
+}
+
+Registrar::Registrar(const char* name, Function function) {
+  Benchmark benchmark = { name, function };
+  benchmarks().push_back(benchmark);
+}
+
+static bool is_selected(const char* name, const std::vector<const char*>& filters) {
+  if (filters.empty()) return true;
+  for (size_t i = 0; i < filters.size(); ++i) {
+    if (strstr(name, filters[i]) != NULL) return true;
+  }
+  return false;
+}
+
+int run(int argc, char* argv[]) {
+  std::vector<const char*> filters;
+  const char* json_file = NULL;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+      json_file = argv[++i];
+    } else {
+      filters.push_back(argv[i]);
+    }
+  }
+
+  FILE* json = NULL;
+  if (json_file != NULL) {
+    json = fopen(json_file, "w");
+    if (json == NULL) {
+      fprintf(stderr, "Unable to open \"%s\"\n", json_file);
+      return 1;
+    }
+    fprintf(json, "{\n  \"driver_version\": \"%d.%d.%d\",\n  \"benchmarks\": [",
+            CASS_VERSION_MAJOR, CASS_VERSION_MINOR, CASS_VERSION_PATCH);
+  }
+
+  printf("%-40s %14s %14s\n", "Benchmark", "Iterations", "ns/iteration");
+
+  bool is_first = true;
+  for (BenchmarkVec::const_iterator it = benchmarks().begin(),
+       end = benchmarks().end(); it != end; ++it) {
+    if (!is_selected(it->name, filters)) continue;
+
+    size_t iterations = 1;
+    uint64_t elapsed = 0;
+    while (true) {
+      uint64_t start = uv_hrtime();
+      it->function(iterations);
+      elapsed = uv_hrtime() - start;
+      if (elapsed >= MIN_ELAPSED_NS) break;
+      iterations *= 2;
+    }
+
+    printf("%-40s %14lu %14.2f\n", it->name,
+           static_cast<unsigned long>(iterations),
+           static_cast<double>(elapsed) / iterations);
+
+    if (json != NULL) {
+      fprintf(json, "%s\n    { \"name\": ", is_first ? "" : ",");
+      print_json_string(json, it->name);
+      fprintf(json, ", \"iterations\": %lu, \"ns_per_iteration\": %.2f }",
+              static_cast<unsigned long>(iterations),
+              static_cast<double>(elapsed) / iterations);
+      is_first = false;
+    }
+  }
+
+  if (json != NULL) {
+    fprintf(json, "\n  ]\n}\n");
+    fclose(json);
+  }
+
+  return 0;
+}
+
+static volatile const void* sink;
+
+void use(const void* value) {
+  sink = value;
+}
+
+void print_json_string(FILE* file, const std::string& str) {
+  fputc('"', file);
+  for (size_t i = 0; i < str.size(); ++i) {
+    char c = str[i];
+    if (c == '"' || c == '\\') {
+      fprintf(file, "\\%c", c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      fprintf(file, "\\u%04x", static_cast<unsigned char>(c));
+    } else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+} // namespace benchmark
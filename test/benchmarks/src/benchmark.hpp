@@ -0,0 +1,53 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_BENCHMARK_HPP_INCLUDED__
+#define __CASS_BENCHMARK_HPP_INCLUDED__
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <string>
+
+namespace benchmark {
+
+// Runs the benchmarked operation "iterations" times
+typedef void (*Function)(size_t iterations);
+
+class Registrar {
+public:
+  Registrar(const char* name, Function function);
+};
+
+// Runs the benchmarks with names that contain one of the arguments (or all
+// of them if there are no arguments) and prints the time per iteration. The
+// results are also written as JSON to the file given by "--json <file>".
+int run(int argc, char* argv[]);
+
+// Prevents the compiler from optimizing away a value that's otherwise unused
+void use(const void* value);
+
+// Writes a quoted and escaped JSON string
+void print_json_string(FILE* file, const std::string& str);
+
+} // namespace benchmark
+
+#define BENCHMARK(name) \
+  static void name(size_t iterations); \
+  static benchmark::Registrar name##_registrar(#name, name); \
+  static void name(size_t iterations)
+
+#endif
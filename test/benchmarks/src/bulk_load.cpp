@@ -0,0 +1,286 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "bulk_load.hpp"
+
+#include "atomic.hpp"
+#include "benchmark.hpp"
+#include "cassandra.h"
+#include "mock_server.hpp"
+#include "random.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <uv.h>
+
+#include <string>
+
+namespace bulk_load {
+
+static const int MOCK_PORT = 19043;
+
+struct Options {
+  Options()
+    : port(0)
+    , mock_nodes(3)
+    , mock_latency_ms(0)
+    , statements(1000000)
+    , max_batch_statements(100)
+    , max_batch_size(5 * 1024)
+    , max_concurrent_batches(64)
+    , io_threads(1)
+    , connections(1)
+    , keys(100000)
+    , query("INSERT INTO bench.kv (key, value) VALUES (?, ?)") {}
+
+  std::string hosts;
+  int port;
+  int mock_nodes;
+  unsigned mock_latency_ms;
+  unsigned statements;
+  unsigned max_batch_statements;
+  unsigned max_batch_size;
+  unsigned max_concurrent_batches;
+  unsigned io_threads;
+  unsigned connections;
+  unsigned keys;
+  std::string query;
+  std::string json_file;
+};
+
+static void print_usage() {
+  fprintf(stderr,
+          "Usage: cassandra_benchmarks bulk [options]\n"
+          "\n"
+          "Without --hosts a mock cluster is started on 127.0.0.1-127.0.0.N and\n"
+          "the default query is run against its \"bench.kv\" table. A real cluster\n"
+          "needs that table (or another --query) to exist.\n"
+          "\n"
+          "  --hosts <contact points>        Run against a real cluster\n"
+          "  --port <port>                   Native protocol port (default: 9042, mock: %d)\n"
+          "  --mock-nodes <n>                Number of mock nodes (default: 3)\n"
+          "  --mock-latency-ms <ms>          Latency added by the mock nodes (default: 0)\n"
+          "  --statements <n>                Statements to load (default: 1000000)\n"
+          "  --max-batch-statements <n>      Statements per batch (default: 100)\n"
+          "  --max-batch-size <bytes>        Size of a batch (default: 5120)\n"
+          "  --max-concurrent-batches <n>    Batches executing at the same time\n"
+          "                                  (default: 64)\n"
+          "  --io-threads <n>                Driver IO threads (default: 1)\n"
+          "  --connections <n>               Connections per host (default: 1)\n"
+          "  --query <query>                 Prepared query (default: \"%s\").\n"
+          "                                  Each \"?\" is bound to a random key.\n"
+          "  --keys <n>                      Number of distinct keys (default: 100000)\n"
+          "  --json <file>                   Write the results as JSON\n",
+          MOCK_PORT, Options().query.c_str());
+}
+
+static bool parse_options(int argc, char* argv[], Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string name(argv[i]);
+    if (i + 1 >= argc) return false;
+    const char* value = argv[++i];
+    if (name == "--hosts") {
+      options->hosts = value;
+    } else if (name == "--port") {
+      options->port = atoi(value);
+    } else if (name == "--mock-nodes") {
+      options->mock_nodes = atoi(value);
+    } else if (name == "--mock-latency-ms") {
+      options->mock_latency_ms = atoi(value);
+    } else if (name == "--statements") {
+      options->statements = atoi(value);
+    } else if (name == "--max-batch-statements") {
+      options->max_batch_statements = atoi(value);
+    } else if (name == "--max-batch-size") {
+      options->max_batch_size = atoi(value);
+    } else if (name == "--max-concurrent-batches") {
+      options->max_concurrent_batches = atoi(value);
+    } else if (name == "--io-threads") {
+      options->io_threads = atoi(value);
+    } else if (name == "--connections") {
+      options->connections = atoi(value);
+    } else if (name == "--query") {
+      options->query = value;
+    } else if (name == "--keys") {
+      options->keys = atoi(value);
+    } else if (name == "--json") {
+      options->json_file = value;
+    } else {
+      return false;
+    }
+  }
+
+  return options->statements > 0 && options->max_batch_statements > 0 &&
+      options->max_concurrent_batches > 0 &&
+      options->mock_nodes > 0 && options->mock_nodes < 255 && options->keys > 0;
+}
+
+static void print_error(CassFuture* future) {
+  const char* message;
+  size_t message_length;
+  cass_future_error_message(future, &message, &message_length);
+  fprintf(stderr, "Error: %.*s\n", static_cast<int>(message_length), message);
+}
+
+// Called on the IO threads for each statement of a failed batch
+static void on_error(const CassStatement* statement, CassError code,
+                     const char* message, size_t message_length, void* data) {
+  static_cast<cass::Atomic<int64_t>*>(data)->fetch_add(1);
+}
+
+static bool write_json(const Options& options, double elapsed_s, int64_t error_count) {
+  FILE* file = fopen(options.json_file.c_str(), "w");
+  if (file == NULL) {
+    fprintf(stderr, "Unable to open \"%s\"\n", options.json_file.c_str());
+    return false;
+  }
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"driver_version\": \"%d.%d.%d\",\n",
+          CASS_VERSION_MAJOR, CASS_VERSION_MINOR, CASS_VERSION_PATCH);
+  fprintf(file, "  \"target\": ");
+  benchmark::print_json_string(file, options.hosts.empty() ? "mock" : options.hosts);
+  fprintf(file, ",\n  \"query\": ");
+  benchmark::print_json_string(file, options.query);
+  fprintf(file, ",\n  \"max_batch_statements\": %u,\n", options.max_batch_statements);
+  fprintf(file, "  \"max_batch_size\": %u,\n", options.max_batch_size);
+  fprintf(file, "  \"max_concurrent_batches\": %u,\n", options.max_concurrent_batches);
+  fprintf(file, "  \"io_threads\": %u,\n", options.io_threads);
+  fprintf(file, "  \"connections\": %u,\n", options.connections);
+  fprintf(file, "  \"statements\": %u,\n", options.statements);
+  fprintf(file, "  \"errors\": %lld,\n", static_cast<long long>(error_count));
+  fprintf(file, "  \"elapsed_s\": %.3f,\n", elapsed_s);
+  fprintf(file, "  \"throughput\": %.2f\n", options.statements / elapsed_s);
+  fprintf(file, "}\n");
+
+  fclose(file);
+  return true;
+}
+
+static int run_bulk_load(const Options& options, CassSession* session) {
+  size_t marker_count = 0;
+  for (size_t i = 0; i < options.query.size(); ++i) {
+    if (options.query[i] == '?') ++marker_count;
+  }
+
+  // Prepared so that the statements have routing keys
+  CassFuture* future = cass_session_prepare(session, options.query.c_str());
+  if (cass_future_error_code(future) != CASS_OK) {
+    print_error(future);
+    cass_future_free(future);
+    return 1;
+  }
+  const CassPrepared* prepared = cass_future_get_prepared(future);
+  cass_future_free(future);
+
+  // Only changed by the loader's callbacks, which are done once the loader
+  // is flushed
+  cass::Atomic<int64_t> error_count(0);
+
+  CassBulkLoader* loader = cass_bulk_loader_new(session);
+  cass_bulk_loader_set_max_batch_statements(loader, options.max_batch_statements);
+  cass_bulk_loader_set_max_batch_size(loader, options.max_batch_size);
+  cass_bulk_loader_set_max_concurrent_batches(loader, options.max_concurrent_batches);
+  cass_bulk_loader_set_error_callback(loader, on_error, &error_count);
+
+  printf("Loading %u statements in batches of up to %u statements (%u bytes)\n",
+         options.statements, options.max_batch_statements, options.max_batch_size);
+
+  MT19937_64 ng;
+  const uint64_t start = uv_hrtime();
+  for (unsigned i = 0; i < options.statements; ++i) {
+    CassStatement* statement = cass_prepared_bind(prepared);
+    for (size_t j = 0; j < marker_count; ++j) {
+      char key[32];
+      sprintf(key, "key%u", static_cast<unsigned>(ng() % options.keys));
+      cass_statement_bind_string(statement, j, key);
+    }
+    cass_bulk_loader_add(loader, statement);
+    cass_statement_free(statement);
+  }
+  cass_bulk_loader_flush(loader);
+  const double elapsed_s = (uv_hrtime() - start) / 1e9;
+
+  cass_bulk_loader_free(loader);
+  cass_prepared_free(prepared);
+
+  printf("Loaded %u statements in %.3f s (%.2f statements/s), %lld failed\n",
+         options.statements, elapsed_s, options.statements / elapsed_s,
+         static_cast<long long>(error_count.load()));
+
+  if (!options.json_file.empty() &&
+      !write_json(options, elapsed_s, error_count.load())) {
+    return 1;
+  }
+
+  return error_count.load() > 0 ? 1 : 0;
+}
+
+int run(int argc, char* argv[]) {
+  Options options;
+  if (!parse_options(argc, argv, &options)) {
+    print_usage();
+    return 1;
+  }
+
+  mock::Server server(options.port > 0 ? options.port : MOCK_PORT);
+  if (options.hosts.empty()) {
+    server.add_keyspace("bench", 3);
+    server.add_table("bench", "kv");
+    if (options.mock_latency_ms > 0) {
+      mock::Rule rule;
+      rule.latency_ms = options.mock_latency_ms;
+      server.add_rule(rule);
+    }
+    if (!server.start(options.mock_nodes)) {
+      fprintf(stderr, "Error: Unable to start the mock cluster\n");
+      return 1;
+    }
+  }
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, options.hosts.empty() ? "127.0.0.1"
+                                                                 : options.hosts.c_str());
+  cass_cluster_set_port(cluster, options.hosts.empty() ? server.port()
+                                                       : (options.port > 0 ? options.port : 9042));
+  cass_cluster_set_num_threads_io(cluster, options.io_threads);
+  cass_cluster_set_core_connections_per_host(cluster, options.connections);
+  cass_cluster_set_max_connections_per_host(cluster, options.connections);
+  // Room for all the batches so that they're not failed by the connections'
+  // write water marks
+  unsigned write_bytes = 2 * options.max_concurrent_batches * options.max_batch_size;
+  if (write_bytes > 64 * 1024) {
+    cass_cluster_set_write_bytes_high_water_mark(cluster, write_bytes);
+    cass_cluster_set_write_bytes_low_water_mark(cluster, write_bytes / 2);
+  }
+
+  CassSession* session = cass_session_new();
+  CassFuture* future = cass_session_connect(session, cluster);
+  int rc = 1;
+  if (cass_future_error_code(future) == CASS_OK) {
+    rc = run_bulk_load(options, session);
+  } else {
+    print_error(future);
+  }
+  cass_future_free(future);
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+  return rc;
+}
+
+} // namespace bulk_load
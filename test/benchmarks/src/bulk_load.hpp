@@ -0,0 +1,31 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_BULK_LOAD_HPP_INCLUDED__
+#define __CASS_BULK_LOAD_HPP_INCLUDED__
+
+namespace bulk_load {
+
+// Runs the bulk load benchmark ("cassandra_benchmarks bulk ...") against the
+// mock server or a real cluster. Statements are added to a bulk loader as
+// fast as it accepts them and the throughput is measured once the final
+// flush completes.
+int run(int argc, char* argv[]);
+
+} // namespace bulk_load
+
+#endif
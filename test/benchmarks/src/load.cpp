@@ -0,0 +1,516 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "load.hpp"
+
+#include "atomic.hpp"
+#include "benchmark.hpp"
+#include "cassandra.h"
+#include "mock_server.hpp"
+#include "random.hpp"
+
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <uv.h>
+
+#if defined(WIN32) || defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <map>
+#include <string>
+
+namespace load {
+
+static const int MOCK_PORT = 19042;
+static const int64_t HIGHEST_TRACKABLE_LATENCY_US = 60LL * 1000 * 1000;
+static const uint64_t DRAIN_TIMEOUT_NS = 30ULL * 1000 * 1000 * 1000;
+
+struct Options {
+  Options()
+    : port(0)
+    , mock_nodes(3)
+    , mock_latency_ms(0)
+    , rate(10000)
+    , duration_s(10)
+    , warmup_s(2)
+    , max_in_flight(10000)
+    , io_threads(1)
+    , connections(1)
+    , keys(100000)
+    , query("INSERT INTO bench.kv (key, value) VALUES (?, ?)")
+    , is_prepared(true) {}
+
+  std::string hosts;
+  int port;
+  int mock_nodes;
+  unsigned mock_latency_ms;
+  double rate;
+  unsigned duration_s;
+  unsigned warmup_s;
+  int max_in_flight;
+  unsigned io_threads;
+  unsigned connections;
+  unsigned keys;
+  std::string query;
+  bool is_prepared;
+  std::string json_file;
+  std::string hdr_file;
+};
+
+// Only the requests scheduled after the warmup are recorded
+struct Stats {
+  Stats(uint64_t measure_start)
+    : measure_start(measure_start)
+    , in_flight(0) {
+    uv_mutex_init(&mutex);
+    hdr_init(1, HIGHEST_TRACKABLE_LATENCY_US, 3, &latency);
+    hdr_init(1, HIGHEST_TRACKABLE_LATENCY_US, 3, &service_time);
+  }
+
+  ~Stats() {
+    free(latency);
+    free(service_time);
+    uv_mutex_destroy(&mutex);
+  }
+
+  const uint64_t measure_start;
+  cass::Atomic<int> in_flight;
+
+  // Protects everything below
+  uv_mutex_t mutex;
+  // From the time the request was scheduled to start (corrected for
+  // coordinated omission)
+  hdr_histogram* latency;
+  // From the time the request was actually started
+  hdr_histogram* service_time;
+  std::map<std::string, int64_t> errors;
+};
+
+struct RequestData {
+  Stats* stats;
+  uint64_t scheduled;
+  uint64_t started;
+};
+
+static void print_usage() {
+  fprintf(stderr,
+          "Usage: cassandra_benchmarks load [options]\n"
+          "\n"
+          "Without --hosts a mock cluster is started on 127.0.0.1-127.0.0.N and\n"
+          "the default query is run against its \"bench.kv\" table. A real cluster\n"
+          "needs that table (or another --query) to exist.\n"
+          "\n"
+          "  --hosts <contact points>   Run against a real cluster\n"
+          "  --port <port>              Native protocol port (default: 9042, mock: %d)\n"
+          "  --mock-nodes <n>           Number of mock nodes (default: 3)\n"
+          "  --mock-latency-ms <ms>     Latency added by the mock nodes (default: 0)\n"
+          "  --rate <requests/s>        Request rate (default: 10000)\n"
+          "  --duration <s>             Measured duration (default: 10)\n"
+          "  --warmup <s>               Unmeasured warmup (default: 2)\n"
+          "  --max-in-flight <n>        Requests in flight before the rate is held\n"
+          "                             back (default: 10000)\n"
+          "  --io-threads <n>           Driver IO threads (default: 1)\n"
+          "  --connections <n>          Connections per host (default: 1)\n"
+          "  --query <query>            Query (default: \"%s\"). Each \"?\"\n"
+          "                             is bound to a random key.\n"
+          "  --keys <n>                 Number of distinct keys (default: 100000)\n"
+          "  --simple                   Don't prepare the query\n"
+          "  --json <file>              Write the results as JSON\n"
+          "  --hdr <file>               Write the latency percentile distribution\n"
+          "                             in the HdrHistogram text format\n",
+          MOCK_PORT, Options().query.c_str());
+}
+
+static bool parse_options(int argc, char* argv[], Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string name(argv[i]);
+    if (name == "--simple") {
+      options->is_prepared = false;
+      continue;
+    }
+
+    if (i + 1 >= argc) return false;
+    const char* value = argv[++i];
+    if (name == "--hosts") {
+      options->hosts = value;
+    } else if (name == "--port") {
+      options->port = atoi(value);
+    } else if (name == "--mock-nodes") {
+      options->mock_nodes = atoi(value);
+    } else if (name == "--mock-latency-ms") {
+      options->mock_latency_ms = atoi(value);
+    } else if (name == "--rate") {
+      options->rate = atof(value);
+    } else if (name == "--duration") {
+      options->duration_s = atoi(value);
+    } else if (name == "--warmup") {
+      options->warmup_s = atoi(value);
+    } else if (name == "--max-in-flight") {
+      options->max_in_flight = atoi(value);
+    } else if (name == "--io-threads") {
+      options->io_threads = atoi(value);
+    } else if (name == "--connections") {
+      options->connections = atoi(value);
+    } else if (name == "--query") {
+      options->query = value;
+    } else if (name == "--keys") {
+      options->keys = atoi(value);
+    } else if (name == "--json") {
+      options->json_file = value;
+    } else if (name == "--hdr") {
+      options->hdr_file = value;
+    } else {
+      return false;
+    }
+  }
+
+  return options->rate > 0 && options->duration_s > 0 && options->max_in_flight > 0 &&
+      options->mock_nodes > 0 && options->mock_nodes < 255 && options->keys > 0;
+}
+
+static void sleep_ms(unsigned ms) {
+#if defined(WIN32) || defined(_WIN32)
+  Sleep(ms);
+#else
+  usleep(ms * 1000);
+#endif
+}
+
+static void yield() {
+#if defined(WIN32) || defined(_WIN32)
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+// Sleeps for most of the wait and yields for the rest so that requests
+// start close to their scheduled time without starving the driver's threads
+static void wait_until(uint64_t time) {
+  uint64_t now = uv_hrtime();
+  while (now < time) {
+    if (time - now > 1100 * 1000) {
+      sleep_ms(1);
+    } else {
+      yield();
+    }
+    now = uv_hrtime();
+  }
+}
+
+static void print_error(CassFuture* future) {
+  const char* message;
+  size_t message_length;
+  cass_future_error_message(future, &message, &message_length);
+  fprintf(stderr, "Error: %.*s\n", static_cast<int>(message_length), message);
+}
+
+static void on_result(CassFuture* future, void* data) {
+  uint64_t now = uv_hrtime();
+  RequestData* request = static_cast<RequestData*>(data);
+  Stats* stats = request->stats;
+
+  if (request->scheduled >= stats->measure_start) {
+    CassError rc = cass_future_error_code(future);
+    uv_mutex_lock(&stats->mutex);
+    if (rc == CASS_OK) {
+      hdr_record_value(stats->latency, (now - request->scheduled) / 1000);
+      hdr_record_value(stats->service_time, (now - request->started) / 1000);
+    } else {
+      stats->errors[cass_error_desc(rc)]++;
+    }
+    uv_mutex_unlock(&stats->mutex);
+  }
+
+  stats->in_flight.fetch_sub(1);
+  delete request;
+}
+
+static CassStatement* create_statement(const Options& options, const CassPrepared* prepared,
+                                       size_t marker_count, MT19937_64* ng) {
+  CassStatement* statement = prepared != NULL ? cass_prepared_bind(prepared)
+                                              : cass_statement_new(options.query.c_str(),
+                                                                   marker_count);
+  for (size_t i = 0; i < marker_count; ++i) {
+    char key[32];
+    sprintf(key, "key%u", static_cast<unsigned>((*ng)() % options.keys));
+    cass_statement_bind_string(statement, i, key);
+  }
+  return statement;
+}
+
+static void print_latency_json(FILE* file, const char* name, hdr_histogram* h) {
+  const double percentiles[] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+  const char* names[] = { "p50", "p90", "p99", "p999", "p9999" };
+
+  fprintf(file, "  \"%s\": {\n", name);
+  fprintf(file, "    \"min\": %lld,\n", static_cast<long long>(h->total_count > 0 ? hdr_min(h) : 0));
+  fprintf(file, "    \"mean\": %.2f,\n", h->total_count > 0 ? hdr_mean(h) : 0.0);
+  for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); ++i) {
+    fprintf(file, "    \"%s\": %lld,\n", names[i],
+            static_cast<long long>(h->total_count > 0 ? hdr_value_at_percentile(h, percentiles[i]) : 0));
+  }
+  fprintf(file, "    \"max\": %lld\n", static_cast<long long>(h->total_count > 0 ? hdr_max(h) : 0));
+  fprintf(file, "  }");
+}
+
+static bool write_json(const Options& options, const Stats& stats, uint64_t max_lag_ns) {
+  FILE* file = fopen(options.json_file.c_str(), "w");
+  if (file == NULL) {
+    fprintf(stderr, "Unable to open \"%s\"\n", options.json_file.c_str());
+    return false;
+  }
+
+  int64_t error_count = 0;
+  for (std::map<std::string, int64_t>::const_iterator i = stats.errors.begin(),
+       end = stats.errors.end(); i != end; ++i) {
+    error_count += i->second;
+  }
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"driver_version\": \"%d.%d.%d\",\n",
+          CASS_VERSION_MAJOR, CASS_VERSION_MINOR, CASS_VERSION_PATCH);
+  fprintf(file, "  \"target\": ");
+  benchmark::print_json_string(file, options.hosts.empty() ? "mock" : options.hosts);
+  fprintf(file, ",\n  \"query\": ");
+  benchmark::print_json_string(file, options.query);
+  fprintf(file, ",\n  \"prepared\": %s,\n", options.is_prepared ? "true" : "false");
+  fprintf(file, "  \"rate\": %.2f,\n", options.rate);
+  fprintf(file, "  \"duration_s\": %u,\n", options.duration_s);
+  fprintf(file, "  \"io_threads\": %u,\n", options.io_threads);
+  fprintf(file, "  \"connections\": %u,\n", options.connections);
+  fprintf(file, "  \"requests\": %lld,\n", static_cast<long long>(stats.latency->total_count));
+  fprintf(file, "  \"errors\": %lld,\n", static_cast<long long>(error_count));
+  fprintf(file, "  \"throughput\": %.2f,\n",
+          static_cast<double>(stats.latency->total_count) / options.duration_s);
+  fprintf(file, "  \"max_schedule_lag_us\": %llu,\n",
+          static_cast<unsigned long long>(max_lag_ns / 1000));
+  print_latency_json(file, "latency_us", stats.latency);
+  fprintf(file, ",\n");
+  print_latency_json(file, "service_time_us", stats.service_time);
+  fprintf(file, "\n}\n");
+
+  fclose(file);
+  return true;
+}
+
+// The same format as HdrHistogram's "outputPercentileDistribution()" so the
+// file can be plotted with the HdrHistogram tools
+static bool write_hdr(const Options& options, hdr_histogram* h) {
+  FILE* file = fopen(options.hdr_file.c_str(), "w");
+  if (file == NULL) {
+    fprintf(stderr, "Unable to open \"%s\"\n", options.hdr_file.c_str());
+    return false;
+  }
+
+  fprintf(file, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+
+  if (h->total_count > 0) {
+    hdr_iter iter;
+    hdr_iter_percentile_init(&iter, h, 5);
+    while (hdr_iter_next(&iter)) {
+      double percentile = iter.specifics.percentiles.percentile / 100.0;
+      if (percentile < 1.0) {
+        fprintf(file, "%12.3f %2.12f %10lld %14.2f\n",
+                static_cast<double>(iter.highest_equivalent_value), percentile,
+                static_cast<long long>(iter.count_to_index), 1.0 / (1.0 - percentile));
+      } else {
+        fprintf(file, "%12.3f %2.12f %10lld\n",
+                static_cast<double>(iter.highest_equivalent_value), percentile,
+                static_cast<long long>(iter.count_to_index));
+      }
+    }
+  }
+
+  fprintf(file, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n",
+          h->total_count > 0 ? hdr_mean(h) : 0.0, h->total_count > 0 ? hdr_stddev(h) : 0.0);
+  fprintf(file, "#[Max     = %12.3f, Total count    = %12lld]\n",
+          h->total_count > 0 ? static_cast<double>(hdr_max(h)) : 0.0,
+          static_cast<long long>(h->total_count));
+  fprintf(file, "#[Buckets = %12d, SubBuckets     = %12d]\n",
+          h->bucket_count, h->sub_bucket_count);
+
+  fclose(file);
+  return true;
+}
+
+static void print_latency(const char* name, hdr_histogram* h) {
+  if (h->total_count == 0) {
+    printf("%-22s no samples\n", name);
+    return;
+  }
+  printf("%-22s min %8lld  p50 %8lld  p99 %8lld  p99.9 %8lld  max %8lld\n", name,
+         static_cast<long long>(hdr_min(h)),
+         static_cast<long long>(hdr_value_at_percentile(h, 50.0)),
+         static_cast<long long>(hdr_value_at_percentile(h, 99.0)),
+         static_cast<long long>(hdr_value_at_percentile(h, 99.9)),
+         static_cast<long long>(hdr_max(h)));
+}
+
+static int run_load(const Options& options, CassSession* session) {
+  size_t marker_count = 0;
+  for (size_t i = 0; i < options.query.size(); ++i) {
+    if (options.query[i] == '?') ++marker_count;
+  }
+
+  const CassPrepared* prepared = NULL;
+  if (options.is_prepared) {
+    CassFuture* future = cass_session_prepare(session, options.query.c_str());
+    if (cass_future_error_code(future) != CASS_OK) {
+      print_error(future);
+      cass_future_free(future);
+      return 1;
+    }
+    prepared = cass_future_get_prepared(future);
+    cass_future_free(future);
+  }
+
+  MT19937_64 ng;
+  const uint64_t start = uv_hrtime();
+  const uint64_t measure_start = start + options.warmup_s * 1000000000ULL;
+  const uint64_t end = measure_start + options.duration_s * 1000000000ULL;
+  const double interval_ns = 1e9 / options.rate;
+  Stats stats(measure_start);
+  uint64_t max_lag_ns = 0;
+
+  printf("Running %.0f requests/s for %u s (and %u s of warmup)\n",
+         options.rate, options.duration_s, options.warmup_s);
+
+  for (uint64_t i = 0; ; ++i) {
+    uint64_t scheduled = start + static_cast<uint64_t>(i * interval_ns);
+    if (scheduled >= end) break;
+    wait_until(scheduled);
+
+    // The rate is held back instead of queuing requests without bound. The
+    // latency of the delayed requests still includes the delay.
+    while (stats.in_flight.load() >= options.max_in_flight) {
+      sleep_ms(1);
+    }
+
+    RequestData* request = new RequestData();
+    request->stats = &stats;
+    request->scheduled = scheduled;
+    request->started = uv_hrtime();
+    if (scheduled >= measure_start && request->started - scheduled > max_lag_ns) {
+      max_lag_ns = request->started - scheduled;
+    }
+
+    stats.in_flight.fetch_add(1);
+    CassStatement* statement = create_statement(options, prepared, marker_count, &ng);
+    CassFuture* future = cass_session_execute(session, statement);
+    cass_future_set_callback(future, on_result, request);
+    cass_future_free(future);
+    cass_statement_free(statement);
+  }
+
+  uint64_t drain_start = uv_hrtime();
+  while (stats.in_flight.load() > 0 && uv_hrtime() - drain_start < DRAIN_TIMEOUT_NS) {
+    sleep_ms(1);
+  }
+
+  if (prepared != NULL) {
+    cass_prepared_free(prepared);
+  }
+
+  if (stats.in_flight.load() > 0) {
+    fprintf(stderr, "Error: %d requests didn't complete\n", stats.in_flight.load());
+    // The outstanding callbacks still reference the stats. The session doesn't
+    // finish closing until every request has completed or timed out.
+    CassFuture* close_future = cass_session_close(session);
+    cass_future_wait(close_future);
+    cass_future_free(close_future);
+    return 1;
+  }
+
+  printf("Completed %lld requests (%.2f requests/s), max schedule lag %llu us\n",
+         static_cast<long long>(stats.latency->total_count),
+         static_cast<double>(stats.latency->total_count) / options.duration_s,
+         static_cast<unsigned long long>(max_lag_ns / 1000));
+  print_latency("Latency (us)", stats.latency);
+  print_latency("Service time (us)", stats.service_time);
+  for (std::map<std::string, int64_t>::const_iterator i = stats.errors.begin(),
+       end = stats.errors.end(); i != end; ++i) {
+    printf("Errors: %lld \"%s\"\n", static_cast<long long>(i->second), i->first.c_str());
+  }
+
+  if (!options.json_file.empty() && !write_json(options, stats, max_lag_ns)) {
+    return 1;
+  }
+  if (!options.hdr_file.empty() && !write_hdr(options, stats.latency)) {
+    return 1;
+  }
+
+  return 0;
+}
+
+int run(int argc, char* argv[]) {
+  Options options;
+  if (!parse_options(argc, argv, &options)) {
+    print_usage();
+    return 1;
+  }
+
+  mock::Server server(options.port > 0 ? options.port : MOCK_PORT);
+  if (options.hosts.empty()) {
+    server.add_keyspace("bench", 3);
+    server.add_table("bench", "kv");
+    if (options.mock_latency_ms > 0) {
+      mock::Rule rule;
+      rule.latency_ms = options.mock_latency_ms;
+      server.add_rule(rule);
+    }
+    if (!server.start(options.mock_nodes)) {
+      fprintf(stderr, "Error: Unable to start the mock cluster\n");
+      return 1;
+    }
+  }
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, options.hosts.empty() ? "127.0.0.1"
+                                                                 : options.hosts.c_str());
+  cass_cluster_set_port(cluster, options.hosts.empty() ? server.port()
+                                                       : (options.port > 0 ? options.port : 9042));
+  cass_cluster_set_num_threads_io(cluster, options.io_threads);
+  cass_cluster_set_core_connections_per_host(cluster, options.connections);
+  cass_cluster_set_max_connections_per_host(cluster, options.connections);
+  cass_cluster_set_queue_size_io(cluster, options.max_in_flight);
+  cass_cluster_set_pending_requests_high_water_mark(cluster, options.max_in_flight);
+  cass_cluster_set_pending_requests_low_water_mark(cluster, options.max_in_flight / 2);
+
+  CassSession* session = cass_session_new();
+  CassFuture* future = cass_session_connect(session, cluster);
+  int rc = 1;
+  if (cass_future_error_code(future) == CASS_OK) {
+    rc = run_load(options, session);
+  } else {
+    print_error(future);
+  }
+  cass_future_free(future);
+
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+  return rc;
+}
+
+} // namespace load
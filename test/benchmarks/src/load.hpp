@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_LOAD_HPP_INCLUDED__
+#define __CASS_LOAD_HPP_INCLUDED__
+
+namespace load {
+
+// Runs the end-to-end load generator ("cassandra_benchmarks load ...")
+// against the mock server or a real cluster. Requests are started at a fixed
+// rate whether or not the previous ones have completed (open-loop) and their
+// latency is measured from the time they were scheduled to start, so a stall
+// in the driver or the server is reflected in every request that it delayed
+// (the "coordinated omission" correction).
+int run(int argc, char* argv[]);
+
+} // namespace load
+
+#endif
@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "benchmark.hpp"
+#include "bulk_load.hpp"
+#include "load.hpp"
+
+#include <string.h>
+
+int main(int argc, char* argv[]) {
+  // "cassandra_benchmarks load [options]" runs the end-to-end load generator
+  if (argc > 1 && strcmp(argv[1], "load") == 0) {
+    return load::run(argc - 1, argv + 1);
+  }
+  // "cassandra_benchmarks bulk [options]" runs the bulk load benchmark
+  if (argc > 1 && strcmp(argv[1], "bulk") == 0) {
+    return bulk_load::run(argc - 1, argv + 1);
+  }
+  return benchmark::run(argc, argv);
+}
@@ -0,0 +1,213 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __MOCK_SERVER_HPP_INCLUDED__
+#define __MOCK_SERVER_HPP_INCLUDED__
+
+#include <uv.h>
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+// An in-process server that speaks the native protocol (versions 1 and 2) and
+// simulates a cluster of nodes on the loopback addresses 127.0.0.1,
+// 127.0.0.2, ... It answers the driver's queries of the "system" tables from
+// its own topology and schema, and answers every other request with an empty
+// result unless a rule scripts a different response.
+//
+// The server runs its own event loop thread and all its methods can be called
+// from any thread. Binding to loopback addresses other than 127.0.0.1 needs
+// aliases for them on some platforms (e.g. Mac OS X).
+
+namespace mock {
+
+// The error codes of error responses
+enum ErrorCode {
+  ERROR_SERVER_ERROR = 0x0000,
+  ERROR_PROTOCOL_ERROR = 0x000A,
+  ERROR_UNAVAILABLE = 0x1000,
+  ERROR_OVERLOADED = 0x1001,
+  ERROR_IS_BOOTSTRAPPING = 0x1002,
+  ERROR_WRITE_TIMEOUT = 0x1100,
+  ERROR_READ_TIMEOUT = 0x1200,
+  ERROR_SYNTAX_ERROR = 0x2000,
+  ERROR_INVALID_QUERY = 0x2200,
+  ERROR_ALREADY_EXISTS = 0x2400,
+  ERROR_UNPREPARED = 0x2500
+};
+
+// Scripts the response to the requests (QUERY, PREPARE, EXECUTE and BATCH)
+// that match. Rules are checked in the order they were added and the first
+// one that matches is used.
+struct Rule {
+  Rule()
+    : node(0)
+    , latency_ms(0)
+    , error_code(-1)
+    , is_dropped(false)
+    , count(-1) {}
+
+  // A substring of the request's query (the prepared query for EXECUTE and
+  // any of the queries of a BATCH). An empty string matches all requests
+  // except the queries of the "system" tables.
+  std::string query;
+
+  // The node (starting at 1) that the rule applies to or 0 for all nodes
+  int node;
+
+  // Delays the response
+  unsigned latency_ms;
+
+  // Responds with an error instead of a result if not -1
+  int error_code;
+  std::string error_message;
+
+  // Never responds to the request
+  bool is_dropped;
+
+  // The number of requests the rule applies to or -1 for all of them
+  int count;
+};
+
+class Server {
+public:
+  static const int DEFAULT_PORT = 9042;
+
+  Server(int port = DEFAULT_PORT);
+  ~Server();
+
+  // Starts "num_nodes" nodes in "dc1" and "num_nodes_dc2" nodes in "dc2".
+  // Returns false if a node's address can't be bound.
+  bool start(int num_nodes, int num_nodes_dc2 = 0);
+  void stop();
+
+  // Adds a keyspace that uses "SimpleStrategy" to the schema. The nodes
+  // don't send schema change events.
+  void add_keyspace(const std::string& keyspace, int replication_factor);
+
+  // Adds a table with a "key" partition key and a "value" column (both
+  // "text") to the schema. The statements prepared for queries that contain
+  // "<keyspace>.<table>" have their bind variables named after these columns,
+  // in that order, so that they can be routed by the driver.
+  void add_table(const std::string& keyspace, const std::string& table);
+
+  void add_rule(const Rule& rule);
+  void clear_rules();
+
+  // Topology changes are sent as events to the connections that registered
+  // for them.
+
+  // Starts a new node and returns its number
+  int add_node(const std::string& dc = "dc1");
+
+  // Stops the node and removes it from the "system.peers" table
+  void remove_node(int node);
+
+  // Closes the node's connections and stops accepting new ones
+  void stop_node(int node);
+
+  // Restarts a stopped node. Its prepared statements are lost.
+  bool start_node(int node);
+
+  // The number of requests (QUERY, PREPARE, EXECUTE and BATCH) received by
+  // the node, including the queries of the "system" tables
+  int request_count(int node) const;
+
+  // The number of connections that are currently open to the node
+  int connection_count(int node) const;
+
+  std::string address(int node) const;
+
+  int port() const { return port_; }
+
+public:
+  class Node;
+  class ClientConnection;
+
+private:
+  enum CommandType {
+    COMMAND_ADD_NODE,
+    COMMAND_REMOVE_NODE,
+    COMMAND_STOP_NODE,
+    COMMAND_START_NODE,
+    COMMAND_STOP
+  };
+
+  struct Command {
+    CommandType type;
+    int node;
+    std::string dc;
+    int result;
+    bool is_done;
+  };
+
+  int run(CommandType type, int node, const std::string& dc = std::string());
+
+  int do_add_node(const std::string& dc);
+  void do_remove_node(int node);
+  void do_stop_node(int node);
+  bool do_start_node(int node);
+  void do_stop();
+
+  Node* get_node(int node) const;
+  int64_t next_token() const;
+  void send_event(int event_type, const std::string& change, const Node* node,
+                  const Node* except = NULL);
+
+  static void run_thread(void* data);
+#if UV_VERSION_MAJOR == 0
+  static void on_command(uv_async_t* async, int status);
+#else
+  static void on_command(uv_async_t* async);
+#endif
+
+private:
+  friend class Node;
+  friend class ClientConnection;
+
+  struct Table {
+    std::string keyspace;
+    std::string table;
+  };
+
+  const int port_;
+  bool is_running_;
+
+  uv_loop_t* loop_;
+  uv_thread_t thread_;
+  uv_async_t async_;
+
+  // Protects everything below. The nodes are only added and started or
+  // stopped on the loop thread.
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  std::list<Command*> commands_;
+  std::vector<Node*> nodes_;
+  std::map<std::string, int> keyspaces_;
+  std::vector<Table> tables_;
+  std::list<Rule> rules_;
+
+private:
+  Server(const Server&);
+  void operator=(const Server&);
+};
+
+} // namespace mock
+
+#endif
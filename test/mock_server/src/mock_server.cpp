@@ -0,0 +1,1405 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "mock_server.hpp"
+
+#include <algorithm>
+#include <ctype.h>
+#include <limits>
+#include <stdio.h>
+#include <string.h>
+
+namespace mock {
+
+enum Opcode {
+  OPCODE_ERROR = 0x00,
+  OPCODE_STARTUP = 0x01,
+  OPCODE_READY = 0x02,
+  OPCODE_OPTIONS = 0x05,
+  OPCODE_SUPPORTED = 0x06,
+  OPCODE_QUERY = 0x07,
+  OPCODE_RESULT = 0x08,
+  OPCODE_PREPARE = 0x09,
+  OPCODE_EXECUTE = 0x0A,
+  OPCODE_REGISTER = 0x0B,
+  OPCODE_EVENT = 0x0C,
+  OPCODE_BATCH = 0x0D
+};
+
+enum ResultKind {
+  RESULT_VOID = 1,
+  RESULT_ROWS = 2,
+  RESULT_SET_KEYSPACE = 3,
+  RESULT_PREPARED = 4
+};
+
+enum ValueType {
+  TYPE_BOOLEAN = 0x0004,
+  TYPE_INT = 0x0009,
+  TYPE_UUID = 0x000C,
+  TYPE_VARCHAR = 0x000D,
+  TYPE_INET = 0x0010,
+  TYPE_SET = 0x0022
+};
+
+enum EventType {
+  EVENT_TOPOLOGY_CHANGE = 1,
+  EVENT_STATUS_CHANGE = 2,
+  EVENT_SCHEMA_CHANGE = 4
+};
+
+static const int RESULT_FLAG_GLOBAL_TABLESPEC = 0x0001;
+static const int RESULT_FLAG_NO_METADATA = 0x0004;
+
+static const int QUERY_FLAG_VALUES = 0x01;
+static const int QUERY_FLAG_PAGE_SIZE = 0x04;
+static const int QUERY_FLAG_PAGING_STATE = 0x08;
+static const int QUERY_FLAG_SERIAL_CONSISTENCY = 0x10;
+
+static const size_t HEADER_SIZE = 8;
+static const int32_t MAX_BODY_SIZE = 256 * 1024 * 1024;
+static const size_t READ_BUFFER_SIZE = 64 * 1024;
+
+static const char* RELEASE_VERSION = "2.0.14";
+static const char* PARTITIONER = "org.apache.cassandra.dht.Murmur3Partitioner";
+static const char* UTF8_TYPE = "org.apache.cassandra.db.marshal.UTF8Type";
+static const char SCHEMA_VERSION[] =
+    "\x59\x27\x4b\x2d\x44\x5c\x4b\x88\x8c\x3a\x1f\x1e\x5d\x52\x73\x6a";
+
+static void encode_byte(std::string* output, uint8_t value) {
+  output->push_back(static_cast<char>(value));
+}
+
+static void encode_uint16(std::string* output, uint16_t value) {
+  output->push_back(static_cast<char>(value >> 8));
+  output->push_back(static_cast<char>(value));
+}
+
+static void encode_int32(std::string* output, int32_t value) {
+  uint32_t v = static_cast<uint32_t>(value);
+  output->push_back(static_cast<char>(v >> 24));
+  output->push_back(static_cast<char>(v >> 16));
+  output->push_back(static_cast<char>(v >> 8));
+  output->push_back(static_cast<char>(v));
+}
+
+static void encode_string(std::string* output, const std::string& value) {
+  encode_uint16(output, static_cast<uint16_t>(value.size()));
+  output->append(value);
+}
+
+static void encode_bytes(std::string* output, const std::string& value) {
+  encode_int32(output, static_cast<int32_t>(value.size()));
+  output->append(value);
+}
+
+static std::string inet_value(const std::string& address) {
+  unsigned a = 0, b = 0, c = 0, d = 0;
+  sscanf(address.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d);
+  std::string value;
+  encode_byte(&value, a);
+  encode_byte(&value, b);
+  encode_byte(&value, c);
+  encode_byte(&value, d);
+  return value;
+}
+
+// A "set<text>" value using the collection format of protocol versions 1
+// and 2
+static std::string set_value(const std::string& element) {
+  std::string value;
+  encode_uint16(&value, 1);
+  encode_string(&value, element);
+  return value;
+}
+
+static std::string to_string(int64_t value) {
+  char buf[32];
+  sprintf(buf, "%lld", static_cast<long long>(value));
+  return buf;
+}
+
+static std::string to_lower(const std::string& str) {
+  std::string result(str);
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = static_cast<char>(tolower(result[i]));
+  }
+  return result;
+}
+
+static bool starts_with(const std::string& str, const std::string& prefix) {
+  return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Finds the string literal compared to "column" in a query's WHERE clause
+// e.g. "peer = '127.0.0.1'"
+static bool find_literal(const std::string& query, const std::string& column,
+                         std::string* value) {
+  size_t pos = query.find(column);
+  while (pos != std::string::npos) {
+    size_t i = pos + column.size();
+    while (i < query.size() && query[i] == ' ') ++i;
+    if (i < query.size() && query[i] == '=') {
+      ++i;
+      while (i < query.size() && query[i] == ' ') ++i;
+      if (i < query.size() && query[i] == '\'') {
+        size_t end = query.find('\'', i + 1);
+        if (end != std::string::npos) {
+          *value = query.substr(i + 1, end - i - 1);
+          return true;
+        }
+      }
+    }
+    pos = query.find(column, pos + 1);
+  }
+  return false;
+}
+
+// Prepared statement ids are derived from the query so that all nodes use
+// the same id for the same query
+static std::string prepared_id(const std::string& query) {
+  std::string id;
+  uint64_t seeds[] = { 14695981039346656037ULL, 1099511628211ULL };
+  for (size_t i = 0; i < 2; ++i) {
+    uint64_t hash = seeds[i];
+    for (size_t j = 0; j < query.size(); ++j) {
+      hash ^= static_cast<uint8_t>(query[j]);
+      hash *= 1099511628211ULL;
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      encode_byte(&id, static_cast<uint8_t>(hash >> shift));
+    }
+  }
+  return id;
+}
+
+static std::string encode_frame(int version, int8_t stream, uint8_t opcode,
+                                const std::string& body) {
+  std::string frame;
+  frame.reserve(HEADER_SIZE + body.size());
+  encode_byte(&frame, 0x80 | version);
+  encode_byte(&frame, 0);
+  encode_byte(&frame, static_cast<uint8_t>(stream));
+  encode_byte(&frame, opcode);
+  encode_bytes(&frame, body);
+  return frame;
+}
+
+static std::string encode_error(int code, const std::string& message,
+                                const std::string& id = std::string()) {
+  std::string body;
+  encode_int32(&body, code);
+  encode_string(&body, message.empty() ? "Injected error" : message);
+  switch (code) {
+    case ERROR_UNAVAILABLE:
+      encode_uint16(&body, 1); // Consistency
+      encode_int32(&body, 1); // Required
+      encode_int32(&body, 0); // Alive
+      break;
+    case ERROR_WRITE_TIMEOUT:
+      encode_uint16(&body, 1);
+      encode_int32(&body, 0); // Received
+      encode_int32(&body, 1); // Block for
+      encode_string(&body, "SIMPLE");
+      break;
+    case ERROR_READ_TIMEOUT:
+      encode_uint16(&body, 1);
+      encode_int32(&body, 0);
+      encode_int32(&body, 1);
+      encode_byte(&body, 0); // Data present
+      break;
+    case ERROR_ALREADY_EXISTS:
+      encode_string(&body, "");
+      encode_string(&body, "");
+      break;
+    case ERROR_UNPREPARED:
+      encode_string(&body, id);
+      break;
+  }
+  return body;
+}
+
+// Decodes the body of a request. Reading past the end of the body
+// invalidates the decoder instead of reading out of bounds.
+class Decoder {
+public:
+  Decoder(const char* data, size_t size)
+    : pos_(data)
+    , end_(data + size)
+    , is_valid_(true) {}
+
+  bool is_valid() const { return is_valid_; }
+
+  uint8_t byte() {
+    if (!has(1)) return 0;
+    return static_cast<uint8_t>(*pos_++);
+  }
+
+  uint16_t uint16() {
+    if (!has(2)) return 0;
+    uint16_t value = static_cast<uint16_t>((static_cast<uint8_t>(pos_[0]) << 8) |
+                                           static_cast<uint8_t>(pos_[1]));
+    pos_ += 2;
+    return value;
+  }
+
+  int32_t int32() {
+    if (!has(4)) return 0;
+    uint32_t value = (static_cast<uint32_t>(static_cast<uint8_t>(pos_[0])) << 24) |
+                     (static_cast<uint32_t>(static_cast<uint8_t>(pos_[1])) << 16) |
+                     (static_cast<uint32_t>(static_cast<uint8_t>(pos_[2])) << 8) |
+                     static_cast<uint32_t>(static_cast<uint8_t>(pos_[3]));
+    pos_ += 4;
+    return static_cast<int32_t>(value);
+  }
+
+  std::string string() {
+    return read(uint16());
+  }
+
+  std::string long_string() {
+    int32_t size = int32();
+    if (size < 0) return std::string();
+    return read(size);
+  }
+
+  void skip_bytes() {
+    int32_t size = int32();
+    if (size > 0) read(size);
+  }
+
+  void skip_values() {
+    uint16_t count = uint16();
+    for (uint16_t i = 0; i < count && is_valid_; ++i) {
+      skip_bytes();
+    }
+  }
+
+private:
+  bool has(size_t size) {
+    if (!is_valid_ || static_cast<size_t>(end_ - pos_) < size) {
+      is_valid_ = false;
+      return false;
+    }
+    return true;
+  }
+
+  std::string read(size_t size) {
+    if (!has(size)) return std::string();
+    std::string value(pos_, size);
+    pos_ += size;
+    return value;
+  }
+
+  const char* pos_;
+  const char* end_;
+  bool is_valid_;
+};
+
+// A rows result with a global table spec
+class Rows {
+public:
+  Rows(const std::string& keyspace, const std::string& table)
+    : keyspace_(keyspace)
+    , table_(table)
+    , column_count_(0)
+    , row_count_(0) {}
+
+  void add_column(const std::string& name, uint16_t type, uint16_t element_type = 0) {
+    encode_string(&columns_, name);
+    encode_uint16(&columns_, type);
+    if (type == TYPE_SET) {
+      encode_uint16(&columns_, element_type);
+    }
+    ++column_count_;
+  }
+
+  void add_value(const std::string& value) {
+    encode_bytes(&rows_, value);
+  }
+
+  void add_null() {
+    encode_int32(&rows_, -1);
+  }
+
+  void end_row() {
+    ++row_count_;
+  }
+
+  std::string encode() const {
+    std::string body;
+    encode_int32(&body, RESULT_ROWS);
+    encode_int32(&body, RESULT_FLAG_GLOBAL_TABLESPEC);
+    encode_int32(&body, column_count_);
+    encode_string(&body, keyspace_);
+    encode_string(&body, table_);
+    body.append(columns_);
+    encode_int32(&body, row_count_);
+    body.append(rows_);
+    return body;
+  }
+
+private:
+  std::string keyspace_;
+  std::string table_;
+  std::string columns_;
+  std::string rows_;
+  int32_t column_count_;
+  int32_t row_count_;
+};
+
+class Server::Node {
+public:
+  Node(Server* server, int id, const std::string& dc, int64_t token)
+    : server(server)
+    , id(id)
+    , dc(dc)
+    , token(token)
+    , is_up(false)
+    , is_removed(false)
+    , request_count(0)
+    , connection_count(0)
+    , listener_(NULL) {
+    char buf[32];
+    sprintf(buf, "127.0.0.%d", id);
+    address = buf;
+  }
+
+  bool start();
+  void stop();
+
+  void remove_connection(ClientConnection* connection) {
+    connections_.remove(connection);
+    uv_mutex_lock(&server->mutex_);
+    --connection_count;
+    uv_mutex_unlock(&server->mutex_);
+  }
+
+  const std::list<ClientConnection*>& connections() const { return connections_; }
+
+  Server* const server;
+  const int id;
+  std::string address;
+  const std::string dc;
+  const int64_t token;
+
+  // Protected by the server's mutex
+  bool is_up;
+  bool is_removed;
+  int request_count;
+  int connection_count;
+
+  // Only used on the loop thread
+  std::map<std::string, std::string> prepared;
+
+private:
+  static void on_connection(uv_stream_t* listener, int status);
+  static void on_close(uv_handle_t* handle);
+
+  uv_tcp_t* listener_;
+  std::list<ClientConnection*> connections_;
+};
+
+class Server::ClientConnection {
+public:
+  ClientConnection(Node* node)
+    : node_(node)
+    , server_(node->server)
+    , events_(0)
+    , is_closing_(false) {
+    tcp_.data = this;
+  }
+
+  bool accept(uv_stream_t* listener);
+  void close();
+
+  bool is_registered(int event_type) const {
+    return (events_ & event_type) != 0;
+  }
+
+  void write(const std::string& frame);
+
+private:
+  struct WriteRequest {
+    uv_write_t req;
+    std::string frame;
+  };
+
+  struct DelayedResponse {
+    uv_timer_t timer;
+    ClientConnection* connection;
+    std::string frame;
+  };
+
+  void write_delayed(const std::string& frame, unsigned delay_ms);
+  void consume(const char* data, size_t size);
+  void handle(int version, int8_t stream, uint8_t opcode, Decoder* decoder);
+  void handle_request(int version, int8_t stream, uint8_t opcode, Decoder* decoder);
+
+  bool find_rule(const std::vector<std::string>& queries, bool is_system, Rule* rule);
+
+  std::string query_result(const std::string& query, bool* is_system);
+  std::string prepared_result(int version, const std::string& query);
+  std::string local_rows();
+  std::string peers_rows(const std::string& query);
+  std::string keyspaces_rows(const std::string& query);
+  std::string tables_rows(const std::string& query);
+  std::string columns_rows(const std::string& query);
+  bool is_table_selected(const std::string& query, const Table& table);
+
+  static void on_write(uv_write_t* req, int status);
+  static void on_close(uv_handle_t* handle);
+#if UV_VERSION_MAJOR == 0
+  static uv_buf_t alloc_buffer(uv_handle_t* handle, size_t suggested_size);
+  static void on_read(uv_stream_t* stream, ssize_t nread, uv_buf_t buf);
+  static void on_delay(uv_timer_t* timer, int status);
+#else
+  static void alloc_buffer(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
+  static void on_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf);
+  static void on_delay(uv_timer_t* timer);
+#endif
+  static void on_delay_close(uv_handle_t* handle);
+
+  Node* node_;
+  Server* server_;
+  uv_tcp_t tcp_;
+  int events_;
+  bool is_closing_;
+  std::string buffer_;
+  std::list<DelayedResponse*> delayed_responses_;
+  char read_buffer_[READ_BUFFER_SIZE];
+};
+
+bool Server::Node::start() {
+  listener_ = new uv_tcp_t;
+  listener_->data = this;
+  uv_tcp_init(server->loop_, listener_);
+
+  int rc;
+#if UV_VERSION_MAJOR == 0
+  rc = uv_tcp_bind(listener_, uv_ip4_addr(address.c_str(), server->port_));
+#else
+  struct sockaddr_in addr;
+  uv_ip4_addr(address.c_str(), server->port_, &addr);
+  rc = uv_tcp_bind(listener_, reinterpret_cast<const struct sockaddr*>(&addr), 0);
+#endif
+  if (rc == 0) {
+    rc = uv_listen(reinterpret_cast<uv_stream_t*>(listener_), 128, on_connection);
+  }
+  if (rc != 0) {
+    fprintf(stderr, "Unable to listen on %s:%d\n", address.c_str(), server->port_);
+    uv_close(reinterpret_cast<uv_handle_t*>(listener_), on_close);
+    listener_ = NULL;
+    return false;
+  }
+
+  uv_mutex_lock(&server->mutex_);
+  is_up = true;
+  uv_mutex_unlock(&server->mutex_);
+  return true;
+}
+
+void Server::Node::stop() {
+  if (listener_ != NULL) {
+    uv_close(reinterpret_cast<uv_handle_t*>(listener_), on_close);
+    listener_ = NULL;
+  }
+
+  // Closing a connection removes it from the list
+  std::list<ClientConnection*> connections(connections_);
+  for (std::list<ClientConnection*>::iterator i = connections.begin(),
+       end = connections.end(); i != end; ++i) {
+    (*i)->close();
+  }
+
+  prepared.clear();
+
+  uv_mutex_lock(&server->mutex_);
+  is_up = false;
+  uv_mutex_unlock(&server->mutex_);
+}
+
+void Server::Node::on_connection(uv_stream_t* listener, int status) {
+  Node* node = static_cast<Node*>(listener->data);
+  if (status != 0) return;
+
+  ClientConnection* connection = new ClientConnection(node);
+  if (!connection->accept(listener)) return;
+
+  node->connections_.push_back(connection);
+  uv_mutex_lock(&node->server->mutex_);
+  ++node->connection_count;
+  uv_mutex_unlock(&node->server->mutex_);
+}
+
+void Server::Node::on_close(uv_handle_t* handle) {
+  delete reinterpret_cast<uv_tcp_t*>(handle);
+}
+
+bool Server::ClientConnection::accept(uv_stream_t* listener) {
+  uv_tcp_init(server_->loop_, &tcp_);
+  if (uv_accept(listener, reinterpret_cast<uv_stream_t*>(&tcp_)) != 0) {
+    is_closing_ = true;
+    uv_close(reinterpret_cast<uv_handle_t*>(&tcp_), on_close);
+    return false;
+  }
+  uv_tcp_nodelay(&tcp_, 1);
+  uv_read_start(reinterpret_cast<uv_stream_t*>(&tcp_), alloc_buffer, on_read);
+  return true;
+}
+
+void Server::ClientConnection::close() {
+  if (is_closing_) return;
+  is_closing_ = true;
+
+  for (std::list<DelayedResponse*>::iterator i = delayed_responses_.begin(),
+       end = delayed_responses_.end(); i != end; ++i) {
+    uv_timer_stop(&(*i)->timer);
+    uv_close(reinterpret_cast<uv_handle_t*>(&(*i)->timer), on_delay_close);
+  }
+  delayed_responses_.clear();
+
+  node_->remove_connection(this);
+  uv_close(reinterpret_cast<uv_handle_t*>(&tcp_), on_close);
+}
+
+void Server::ClientConnection::write(const std::string& frame) {
+  if (is_closing_) return;
+  WriteRequest* request = new WriteRequest();
+  request->req.data = request;
+  request->frame = frame;
+  uv_buf_t buf = uv_buf_init(&request->frame[0], request->frame.size());
+  if (uv_write(&request->req, reinterpret_cast<uv_stream_t*>(&tcp_), &buf, 1, on_write) != 0) {
+    delete request;
+    close();
+  }
+}
+
+void Server::ClientConnection::write_delayed(const std::string& frame, unsigned delay_ms) {
+  DelayedResponse* response = new DelayedResponse();
+  response->timer.data = response;
+  response->connection = this;
+  response->frame = frame;
+  uv_timer_init(server_->loop_, &response->timer);
+  uv_timer_start(&response->timer, on_delay, delay_ms, 0);
+  delayed_responses_.push_back(response);
+}
+
+void Server::ClientConnection::consume(const char* data, size_t size) {
+  buffer_.append(data, size);
+
+  size_t pos = 0;
+  while (buffer_.size() - pos >= HEADER_SIZE) {
+    Decoder header(buffer_.data() + pos, HEADER_SIZE);
+    uint8_t version = header.byte() & 0x7F;
+    header.byte(); // Flags
+    int8_t stream = static_cast<int8_t>(header.byte());
+    uint8_t opcode = header.byte();
+    int32_t length = header.int32();
+
+    if (length < 0 || length > MAX_BODY_SIZE) {
+      close();
+      return;
+    }
+
+    if (buffer_.size() - pos < HEADER_SIZE + length) break;
+
+    Decoder decoder(buffer_.data() + pos + HEADER_SIZE, length);
+    handle(version, stream, opcode, &decoder);
+    if (is_closing_) return;
+
+    pos += HEADER_SIZE + length;
+  }
+
+  buffer_.erase(0, pos);
+}
+
+void Server::ClientConnection::handle(int version, int8_t stream, uint8_t opcode,
+                                      Decoder* decoder) {
+  if (version != 1 && version != 2) {
+    write(encode_frame(std::min(std::max(version, 1), 2), stream, OPCODE_ERROR,
+                       encode_error(ERROR_PROTOCOL_ERROR, "Invalid or unsupported protocol version")));
+    return;
+  }
+
+  switch (opcode) {
+    case OPCODE_STARTUP:
+      write(encode_frame(version, stream, OPCODE_READY, std::string()));
+      break;
+
+    case OPCODE_OPTIONS: {
+      std::string body;
+      encode_uint16(&body, 2);
+      encode_string(&body, "CQL_VERSION");
+      encode_uint16(&body, 1);
+      encode_string(&body, "3.1.7");
+      encode_string(&body, "COMPRESSION");
+      encode_uint16(&body, 0);
+      write(encode_frame(version, stream, OPCODE_SUPPORTED, body));
+      break;
+    }
+
+    case OPCODE_REGISTER: {
+      uint16_t count = decoder->uint16();
+      for (uint16_t i = 0; i < count; ++i) {
+        std::string event(decoder->string());
+        if (event == "TOPOLOGY_CHANGE") {
+          events_ |= EVENT_TOPOLOGY_CHANGE;
+        } else if (event == "STATUS_CHANGE") {
+          events_ |= EVENT_STATUS_CHANGE;
+        } else if (event == "SCHEMA_CHANGE") {
+          events_ |= EVENT_SCHEMA_CHANGE;
+        }
+      }
+      write(encode_frame(version, stream, OPCODE_READY, std::string()));
+      break;
+    }
+
+    case OPCODE_QUERY:
+    case OPCODE_PREPARE:
+    case OPCODE_EXECUTE:
+    case OPCODE_BATCH:
+      handle_request(version, stream, opcode, decoder);
+      break;
+
+    default:
+      write(encode_frame(version, stream, OPCODE_ERROR,
+                         encode_error(ERROR_PROTOCOL_ERROR, "Unsupported opcode")));
+      break;
+  }
+}
+
+void Server::ClientConnection::handle_request(int version, int8_t stream, uint8_t opcode,
+                                              Decoder* decoder) {
+  uv_mutex_lock(&server_->mutex_);
+  ++node_->request_count;
+  uv_mutex_unlock(&server_->mutex_);
+
+  std::vector<std::string> queries;
+  std::string unprepared_id;
+
+  if (opcode == OPCODE_QUERY || opcode == OPCODE_PREPARE) {
+    queries.push_back(decoder->long_string());
+  } else if (opcode == OPCODE_EXECUTE) {
+    std::string id(decoder->string());
+    std::map<std::string, std::string>::const_iterator i = node_->prepared.find(id);
+    if (i != node_->prepared.end()) {
+      queries.push_back(i->second);
+    } else {
+      unprepared_id = id;
+    }
+  } else if (version > 1) {
+    decoder->byte(); // Type
+    uint16_t count = decoder->uint16();
+    for (uint16_t i = 0; i < count && decoder->is_valid(); ++i) {
+      uint8_t kind = decoder->byte();
+      if (kind == 0) {
+        queries.push_back(decoder->long_string());
+      } else {
+        std::string id(decoder->string());
+        std::map<std::string, std::string>::const_iterator j = node_->prepared.find(id);
+        if (j != node_->prepared.end()) {
+          queries.push_back(j->second);
+        } else if (unprepared_id.empty()) {
+          unprepared_id = id;
+        }
+      }
+      decoder->skip_values();
+    }
+  }
+
+  if (!decoder->is_valid() || (opcode == OPCODE_BATCH && version == 1)) {
+    write(encode_frame(version, stream, OPCODE_ERROR,
+                       encode_error(ERROR_PROTOCOL_ERROR, "Invalid request")));
+    return;
+  }
+
+  if (!unprepared_id.empty()) {
+    write(encode_frame(version, stream, OPCODE_ERROR,
+                       encode_error(ERROR_UNPREPARED, "Unknown prepared statement",
+                                    unprepared_id)));
+    return;
+  }
+
+  std::string body;
+  bool is_system = false;
+  uint8_t response_opcode = OPCODE_RESULT;
+  if (opcode == OPCODE_PREPARE) {
+    body = prepared_result(version, queries.front());
+  } else if (opcode == OPCODE_BATCH) {
+    encode_int32(&body, RESULT_VOID);
+  } else {
+    body = query_result(queries.front(), &is_system);
+  }
+
+  Rule rule;
+  if (find_rule(queries, is_system, &rule)) {
+    if (rule.is_dropped) return;
+    if (rule.error_code >= 0) {
+      response_opcode = OPCODE_ERROR;
+      body = encode_error(rule.error_code, rule.error_message);
+    }
+  }
+
+  if (opcode == OPCODE_PREPARE && response_opcode == OPCODE_RESULT) {
+    node_->prepared[prepared_id(queries.front())] = queries.front();
+  }
+
+  std::string frame(encode_frame(version, stream, response_opcode, body));
+  if (rule.latency_ms > 0) {
+    write_delayed(frame, rule.latency_ms);
+  } else {
+    write(frame);
+  }
+}
+
+bool Server::ClientConnection::find_rule(const std::vector<std::string>& queries,
+                                         bool is_system, Rule* rule) {
+  uv_mutex_lock(&server_->mutex_);
+  for (std::list<Rule>::iterator i = server_->rules_.begin(),
+       end = server_->rules_.end(); i != end; ++i) {
+    if ((i->node != 0 && i->node != node_->id) || i->count == 0) continue;
+
+    bool is_match = false;
+    if (i->query.empty()) {
+      is_match = !is_system;
+    } else {
+      for (size_t j = 0; j < queries.size() && !is_match; ++j) {
+        is_match = queries[j].find(i->query) != std::string::npos;
+      }
+    }
+
+    if (is_match) {
+      if (i->count > 0) --i->count;
+      *rule = *i;
+      uv_mutex_unlock(&server_->mutex_);
+      return true;
+    }
+  }
+  uv_mutex_unlock(&server_->mutex_);
+  return false;
+}
+
+std::string Server::ClientConnection::query_result(const std::string& query,
+                                                   bool* is_system) {
+  std::string lower(to_lower(query));
+  size_t start = lower.find_first_not_of(" \t\n");
+  if (start != std::string::npos) lower.erase(0, start);
+
+  *is_system = lower.find(" from system.") != std::string::npos;
+
+  if (*is_system) {
+    if (lower.find(" from system.local") != std::string::npos) {
+      return local_rows();
+    } else if (lower.find(" from system.peers") != std::string::npos) {
+      return peers_rows(query);
+    } else if (lower.find(" from system.schema_keyspaces") != std::string::npos) {
+      return keyspaces_rows(query);
+    } else if (lower.find(" from system.schema_columnfamilies") != std::string::npos) {
+      return tables_rows(query);
+    } else if (lower.find(" from system.schema_columns") != std::string::npos) {
+      return columns_rows(query);
+    }
+  }
+
+  std::string body;
+  if (starts_with(lower, "use ")) {
+    std::string keyspace(query.substr(query.find_first_not_of(" \t\n") + 4));
+    keyspace.erase(std::remove(keyspace.begin(), keyspace.end(), '"'), keyspace.end());
+    keyspace.erase(std::remove(keyspace.begin(), keyspace.end(), ' '), keyspace.end());
+    keyspace.erase(std::remove(keyspace.begin(), keyspace.end(), ';'), keyspace.end());
+    encode_int32(&body, RESULT_SET_KEYSPACE);
+    encode_string(&body, keyspace);
+  } else if (starts_with(lower, "select")) {
+    body = Rows("", "").encode();
+  } else {
+    encode_int32(&body, RESULT_VOID);
+  }
+  return body;
+}
+
+std::string Server::ClientConnection::prepared_result(int version, const std::string& query) {
+  int32_t count = static_cast<int32_t>(std::count(query.begin(), query.end(), '?'));
+
+  Table table;
+  uv_mutex_lock(&server_->mutex_);
+  for (std::vector<Table>::const_iterator i = server_->tables_.begin(),
+       end = server_->tables_.end(); i != end; ++i) {
+    if (query.find(i->keyspace + "." + i->table) != std::string::npos) {
+      table = *i;
+      break;
+    }
+  }
+  uv_mutex_unlock(&server_->mutex_);
+
+  std::string body;
+  encode_int32(&body, RESULT_PREPARED);
+  encode_string(&body, prepared_id(query));
+  encode_int32(&body, RESULT_FLAG_GLOBAL_TABLESPEC);
+  encode_int32(&body, count);
+  encode_string(&body, table.keyspace);
+  encode_string(&body, table.table);
+  for (int32_t i = 0; i < count; ++i) {
+    if (!table.table.empty() && i < 2) {
+      encode_string(&body, i == 0 ? "key" : "value");
+    } else {
+      encode_string(&body, "col" + to_string(i));
+    }
+    encode_uint16(&body, TYPE_VARCHAR);
+  }
+  if (version > 1) {
+    encode_int32(&body, RESULT_FLAG_NO_METADATA);
+    encode_int32(&body, 0);
+  }
+  return body;
+}
+
+std::string Server::ClientConnection::local_rows() {
+  Rows rows("system", "local");
+  rows.add_column("key", TYPE_VARCHAR);
+  rows.add_column("data_center", TYPE_VARCHAR);
+  rows.add_column("rack", TYPE_VARCHAR);
+  rows.add_column("release_version", TYPE_VARCHAR);
+  rows.add_column("partitioner", TYPE_VARCHAR);
+  rows.add_column("tokens", TYPE_SET, TYPE_VARCHAR);
+  rows.add_column("schema_version", TYPE_UUID);
+  rows.add_column("rpc_address", TYPE_INET);
+
+  rows.add_value("local");
+  rows.add_value(node_->dc);
+  rows.add_value("rack1");
+  rows.add_value(RELEASE_VERSION);
+  rows.add_value(PARTITIONER);
+  rows.add_value(set_value(to_string(node_->token)));
+  rows.add_value(std::string(SCHEMA_VERSION, 16));
+  rows.add_value(inet_value(node_->address));
+  rows.end_row();
+
+  return rows.encode();
+}
+
+std::string Server::ClientConnection::peers_rows(const std::string& query) {
+  Rows rows("system", "peers");
+  rows.add_column("peer", TYPE_INET);
+  rows.add_column("data_center", TYPE_VARCHAR);
+  rows.add_column("rack", TYPE_VARCHAR);
+  rows.add_column("release_version", TYPE_VARCHAR);
+  rows.add_column("rpc_address", TYPE_INET);
+  rows.add_column("tokens", TYPE_SET, TYPE_VARCHAR);
+  rows.add_column("schema_version", TYPE_UUID);
+
+  std::string peer;
+  bool has_peer = find_literal(query, "peer", &peer);
+
+  uv_mutex_lock(&server_->mutex_);
+  for (std::vector<Node*>::const_iterator i = server_->nodes_.begin(),
+       end = server_->nodes_.end(); i != end; ++i) {
+    const Node* node = *i;
+    if (node == node_ || node->is_removed) continue;
+    if (has_peer && node->address != peer) continue;
+    rows.add_value(inet_value(node->address));
+    rows.add_value(node->dc);
+    rows.add_value("rack1");
+    rows.add_value(RELEASE_VERSION);
+    rows.add_value(inet_value(node->address));
+    rows.add_value(set_value(to_string(node->token)));
+    rows.add_value(std::string(SCHEMA_VERSION, 16));
+    rows.end_row();
+  }
+  uv_mutex_unlock(&server_->mutex_);
+
+  return rows.encode();
+}
+
+std::string Server::ClientConnection::keyspaces_rows(const std::string& query) {
+  Rows rows("system", "schema_keyspaces");
+  rows.add_column("keyspace_name", TYPE_VARCHAR);
+  rows.add_column("durable_writes", TYPE_BOOLEAN);
+  rows.add_column("strategy_class", TYPE_VARCHAR);
+  rows.add_column("strategy_options", TYPE_VARCHAR);
+
+  std::string keyspace;
+  bool has_keyspace = find_literal(query, "keyspace_name", &keyspace);
+
+  if (!has_keyspace || keyspace == "system") {
+    rows.add_value("system");
+    rows.add_value(std::string(1, 1));
+    rows.add_value("org.apache.cassandra.locator.LocalStrategy");
+    rows.add_value("{}");
+    rows.end_row();
+  }
+
+  uv_mutex_lock(&server_->mutex_);
+  for (std::map<std::string, int>::const_iterator i = server_->keyspaces_.begin(),
+       end = server_->keyspaces_.end(); i != end; ++i) {
+    if (has_keyspace && i->first != keyspace) continue;
+    rows.add_value(i->first);
+    rows.add_value(std::string(1, 1));
+    rows.add_value("org.apache.cassandra.locator.SimpleStrategy");
+    rows.add_value("{\"replication_factor\":\"" + to_string(i->second) + "\"}");
+    rows.end_row();
+  }
+  uv_mutex_unlock(&server_->mutex_);
+
+  return rows.encode();
+}
+
+bool Server::ClientConnection::is_table_selected(const std::string& query,
+                                                 const Table& table) {
+  std::string value;
+  if (find_literal(query, "keyspace_name", &value) && value != table.keyspace) {
+    return false;
+  }
+  if (find_literal(query, "columnfamily_name", &value) && value != table.table) {
+    return false;
+  }
+  return true;
+}
+
+std::string Server::ClientConnection::tables_rows(const std::string& query) {
+  Rows rows("system", "schema_columnfamilies");
+  rows.add_column("keyspace_name", TYPE_VARCHAR);
+  rows.add_column("columnfamily_name", TYPE_VARCHAR);
+  rows.add_column("comparator", TYPE_VARCHAR);
+  rows.add_column("default_validator", TYPE_VARCHAR);
+  rows.add_column("key_aliases", TYPE_VARCHAR);
+  rows.add_column("key_validator", TYPE_VARCHAR);
+  rows.add_column("type", TYPE_VARCHAR);
+
+  uv_mutex_lock(&server_->mutex_);
+  for (std::vector<Table>::const_iterator i = server_->tables_.begin(),
+       end = server_->tables_.end(); i != end; ++i) {
+    if (!is_table_selected(query, *i)) continue;
+    rows.add_value(i->keyspace);
+    rows.add_value(i->table);
+    rows.add_value(UTF8_TYPE);
+    rows.add_value(UTF8_TYPE);
+    rows.add_value("[\"key\"]");
+    rows.add_value(UTF8_TYPE);
+    rows.add_value("Standard");
+    rows.end_row();
+  }
+  uv_mutex_unlock(&server_->mutex_);
+
+  return rows.encode();
+}
+
+std::string Server::ClientConnection::columns_rows(const std::string& query) {
+  Rows rows("system", "schema_columns");
+  rows.add_column("keyspace_name", TYPE_VARCHAR);
+  rows.add_column("columnfamily_name", TYPE_VARCHAR);
+  rows.add_column("column_name", TYPE_VARCHAR);
+  rows.add_column("component_index", TYPE_INT);
+  rows.add_column("type", TYPE_VARCHAR);
+  rows.add_column("validator", TYPE_VARCHAR);
+
+  uv_mutex_lock(&server_->mutex_);
+  for (std::vector<Table>::const_iterator i = server_->tables_.begin(),
+       end = server_->tables_.end(); i != end; ++i) {
+    if (!is_table_selected(query, *i)) continue;
+    const char* names[] = { "key", "value" };
+    const char* types[] = { "partition_key", "regular" };
+    for (size_t j = 0; j < 2; ++j) {
+      rows.add_value(i->keyspace);
+      rows.add_value(i->table);
+      rows.add_value(names[j]);
+      rows.add_null();
+      rows.add_value(types[j]);
+      rows.add_value(UTF8_TYPE);
+      rows.end_row();
+    }
+  }
+  uv_mutex_unlock(&server_->mutex_);
+
+  return rows.encode();
+}
+
+void Server::ClientConnection::on_write(uv_write_t* req, int status) {
+  delete static_cast<WriteRequest*>(req->data);
+}
+
+void Server::ClientConnection::on_close(uv_handle_t* handle) {
+  delete static_cast<ClientConnection*>(handle->data);
+}
+
+#if UV_VERSION_MAJOR == 0
+uv_buf_t Server::ClientConnection::alloc_buffer(uv_handle_t* handle, size_t suggested_size) {
+  ClientConnection* connection = static_cast<ClientConnection*>(handle->data);
+  return uv_buf_init(connection->read_buffer_, READ_BUFFER_SIZE);
+}
+
+void Server::ClientConnection::on_read(uv_stream_t* stream, ssize_t nread, uv_buf_t buf) {
+#else
+void Server::ClientConnection::alloc_buffer(uv_handle_t* handle, size_t suggested_size,
+                                            uv_buf_t* buf) {
+  ClientConnection* connection = static_cast<ClientConnection*>(handle->data);
+  *buf = uv_buf_init(connection->read_buffer_, READ_BUFFER_SIZE);
+}
+
+void Server::ClientConnection::on_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+#endif
+  ClientConnection* connection = static_cast<ClientConnection*>(stream->data);
+  if (nread < 0) {
+    connection->close();
+    return;
+  }
+  connection->consume(connection->read_buffer_, nread);
+}
+
+#if UV_VERSION_MAJOR == 0
+void Server::ClientConnection::on_delay(uv_timer_t* timer, int status) {
+#else
+void Server::ClientConnection::on_delay(uv_timer_t* timer) {
+#endif
+  DelayedResponse* response = static_cast<DelayedResponse*>(timer->data);
+  ClientConnection* connection = response->connection;
+  connection->delayed_responses_.remove(response);
+  connection->write(response->frame);
+  uv_close(reinterpret_cast<uv_handle_t*>(timer), on_delay_close);
+}
+
+void Server::ClientConnection::on_delay_close(uv_handle_t* handle) {
+  delete static_cast<DelayedResponse*>(handle->data);
+}
+
+Server::Server(int port)
+  : port_(port)
+  , is_running_(false)
+  , loop_(NULL) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+Server::~Server() {
+  stop();
+  for (std::vector<Node*>::iterator i = nodes_.begin(),
+       end = nodes_.end(); i != end; ++i) {
+    delete *i;
+  }
+  uv_cond_destroy(&cond_);
+  uv_mutex_destroy(&mutex_);
+}
+
+bool Server::start(int num_nodes, int num_nodes_dc2) {
+  if (is_running_) return false;
+
+#if UV_VERSION_MAJOR == 0
+  loop_ = uv_loop_new();
+#else
+  loop_ = new uv_loop_t;
+  uv_loop_init(loop_);
+#endif
+  uv_async_init(loop_, &async_, on_command);
+  async_.data = this;
+
+  // The nodes are started before the loop thread so they don't need to be
+  // started by commands
+  bool is_started = true;
+  for (int i = 0; i < num_nodes + num_nodes_dc2 && is_started; ++i) {
+    is_started = do_add_node(i < num_nodes ? "dc1" : "dc2") > 0;
+  }
+
+  if (!is_started) {
+    do_stop();
+    uv_run(loop_, UV_RUN_DEFAULT);
+#if UV_VERSION_MAJOR == 0
+    uv_loop_delete(loop_);
+#else
+    uv_loop_close(loop_);
+    delete loop_;
+#endif
+    loop_ = NULL;
+    return false;
+  }
+
+  uv_thread_create(&thread_, run_thread, this);
+  is_running_ = true;
+  return true;
+}
+
+void Server::stop() {
+  if (!is_running_) return;
+  run(COMMAND_STOP, 0);
+  uv_thread_join(&thread_);
+#if UV_VERSION_MAJOR == 0
+  uv_loop_delete(loop_);
+#else
+  uv_loop_close(loop_);
+  delete loop_;
+#endif
+  loop_ = NULL;
+  is_running_ = false;
+}
+
+void Server::add_keyspace(const std::string& keyspace, int replication_factor) {
+  uv_mutex_lock(&mutex_);
+  keyspaces_[keyspace] = replication_factor;
+  uv_mutex_unlock(&mutex_);
+}
+
+void Server::add_table(const std::string& keyspace, const std::string& table) {
+  Table t;
+  t.keyspace = keyspace;
+  t.table = table;
+  uv_mutex_lock(&mutex_);
+  tables_.push_back(t);
+  uv_mutex_unlock(&mutex_);
+}
+
+void Server::add_rule(const Rule& rule) {
+  uv_mutex_lock(&mutex_);
+  rules_.push_back(rule);
+  uv_mutex_unlock(&mutex_);
+}
+
+void Server::clear_rules() {
+  uv_mutex_lock(&mutex_);
+  rules_.clear();
+  uv_mutex_unlock(&mutex_);
+}
+
+int Server::add_node(const std::string& dc) {
+  if (!is_running_) return -1;
+  return run(COMMAND_ADD_NODE, 0, dc);
+}
+
+void Server::remove_node(int node) {
+  if (!is_running_) return;
+  run(COMMAND_REMOVE_NODE, node);
+}
+
+void Server::stop_node(int node) {
+  if (!is_running_) return;
+  run(COMMAND_STOP_NODE, node);
+}
+
+bool Server::start_node(int node) {
+  if (!is_running_) return false;
+  return run(COMMAND_START_NODE, node) != 0;
+}
+
+int Server::request_count(int node) const {
+  uv_mutex_lock(&mutex_);
+  Node* n = get_node(node);
+  int count = n != NULL ? n->request_count : 0;
+  uv_mutex_unlock(&mutex_);
+  return count;
+}
+
+int Server::connection_count(int node) const {
+  uv_mutex_lock(&mutex_);
+  Node* n = get_node(node);
+  int count = n != NULL ? n->connection_count : 0;
+  uv_mutex_unlock(&mutex_);
+  return count;
+}
+
+std::string Server::address(int node) const {
+  char buf[32];
+  sprintf(buf, "127.0.0.%d", node);
+  return buf;
+}
+
+int Server::run(CommandType type, int node, const std::string& dc) {
+  Command command;
+  command.type = type;
+  command.node = node;
+  command.dc = dc;
+  command.result = 0;
+  command.is_done = false;
+
+  uv_mutex_lock(&mutex_);
+  commands_.push_back(&command);
+  uv_async_send(&async_);
+  while (!command.is_done) {
+    uv_cond_wait(&cond_, &mutex_);
+  }
+  uv_mutex_unlock(&mutex_);
+
+  return command.result;
+}
+
+int Server::do_add_node(const std::string& dc) {
+  uv_mutex_lock(&mutex_);
+  Node* node = new Node(this, nodes_.size() + 1, dc, next_token());
+  nodes_.push_back(node);
+  uv_mutex_unlock(&mutex_);
+
+  if (!node->start()) {
+    uv_mutex_lock(&mutex_);
+    node->is_removed = true;
+    uv_mutex_unlock(&mutex_);
+    return -1;
+  }
+
+  send_event(EVENT_TOPOLOGY_CHANGE, "NEW_NODE", node, node);
+  return node->id;
+}
+
+void Server::do_remove_node(int id) {
+  Node* node = get_node(id);
+  if (node == NULL) return;
+  node->stop();
+  uv_mutex_lock(&mutex_);
+  node->is_removed = true;
+  uv_mutex_unlock(&mutex_);
+  send_event(EVENT_TOPOLOGY_CHANGE, "REMOVED_NODE", node, node);
+}
+
+void Server::do_stop_node(int id) {
+  Node* node = get_node(id);
+  if (node == NULL) return;
+  node->stop();
+  send_event(EVENT_STATUS_CHANGE, "DOWN", node, node);
+}
+
+bool Server::do_start_node(int id) {
+  Node* node = get_node(id);
+  if (node == NULL || node->is_removed) return false;
+  if (node->is_up) return true;
+  if (!node->start()) return false;
+  send_event(EVENT_STATUS_CHANGE, "UP", node, node);
+  return true;
+}
+
+void Server::do_stop() {
+  for (std::vector<Node*>::iterator i = nodes_.begin(),
+       end = nodes_.end(); i != end; ++i) {
+    (*i)->stop();
+  }
+  uv_close(reinterpret_cast<uv_handle_t*>(&async_), NULL);
+}
+
+Server::Node* Server::get_node(int node) const {
+  if (node < 1 || node > static_cast<int>(nodes_.size())) return NULL;
+  return nodes_[node - 1];
+}
+
+// Splits the largest range of the token ring. The first nodes end up evenly
+// spaced when the number of nodes is a power of two.
+int64_t Server::next_token() const {
+  if (nodes_.empty()) {
+    return std::numeric_limits<int64_t>::min();
+  }
+
+  std::vector<uint64_t> tokens;
+  for (std::vector<Node*>::const_iterator i = nodes_.begin(),
+       end = nodes_.end(); i != end; ++i) {
+    if (!(*i)->is_removed) {
+      tokens.push_back(static_cast<uint64_t>((*i)->token));
+    }
+  }
+  if (tokens.empty()) {
+    return std::numeric_limits<int64_t>::min();
+  }
+
+  // Offsets from the start of the ring so the unsigned order is the
+  // token order
+  const uint64_t ring_start = static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    tokens[i] -= ring_start;
+  }
+  std::sort(tokens.begin(), tokens.end());
+
+  if (tokens.size() == 1) {
+    return static_cast<int64_t>(tokens[0] + (1ULL << 63) + ring_start);
+  }
+
+  uint64_t best_start = tokens.back();
+  uint64_t best_size = tokens.front() - tokens.back(); // Wraps around
+  for (size_t i = 1; i < tokens.size(); ++i) {
+    uint64_t size = tokens[i] - tokens[i - 1];
+    if (size > best_size) {
+      best_start = tokens[i - 1];
+      best_size = size;
+    }
+  }
+
+  return static_cast<int64_t>(best_start + best_size / 2 + ring_start);
+}
+
+void Server::send_event(int event_type, const std::string& change,
+                        const Node* node, const Node* except) {
+  std::string body;
+  encode_string(&body, event_type == EVENT_TOPOLOGY_CHANGE ? "TOPOLOGY_CHANGE" : "STATUS_CHANGE");
+  encode_string(&body, change);
+  std::string address(inet_value(node->address));
+  encode_byte(&body, address.size());
+  body.append(address);
+  encode_int32(&body, port_);
+
+  for (std::vector<Node*>::const_iterator i = nodes_.begin(),
+       end = nodes_.end(); i != end; ++i) {
+    if (*i == except) continue;
+    const std::list<ClientConnection*>& connections = (*i)->connections();
+    for (std::list<ClientConnection*>::const_iterator j = connections.begin(),
+         end = connections.end(); j != end; ++j) {
+      if ((*j)->is_registered(event_type)) {
+        // The connection's protocol version isn't tracked. Event frames
+        // are the same for versions 1 and 2.
+        (*j)->write(encode_frame(2, -1, OPCODE_EVENT, body));
+      }
+    }
+  }
+}
+
+void Server::run_thread(void* data) {
+  Server* server = static_cast<Server*>(data);
+  uv_run(server->loop_, UV_RUN_DEFAULT);
+}
+
+#if UV_VERSION_MAJOR == 0
+void Server::on_command(uv_async_t* async, int status) {
+#else
+void Server::on_command(uv_async_t* async) {
+#endif
+  Server* server = static_cast<Server*>(async->data);
+
+  uv_mutex_lock(&server->mutex_);
+  std::list<Command*> commands;
+  commands.swap(server->commands_);
+  uv_mutex_unlock(&server->mutex_);
+
+  for (std::list<Command*>::iterator i = commands.begin(),
+       end = commands.end(); i != end; ++i) {
+    Command* command = *i;
+    switch (command->type) {
+      case COMMAND_ADD_NODE:
+        command->result = server->do_add_node(command->dc);
+        break;
+      case COMMAND_REMOVE_NODE:
+        server->do_remove_node(command->node);
+        break;
+      case COMMAND_STOP_NODE:
+        server->do_stop_node(command->node);
+        break;
+      case COMMAND_START_NODE:
+        command->result = server->do_start_node(command->node) ? 1 : 0;
+        break;
+      case COMMAND_STOP:
+        server->do_stop();
+        break;
+    }
+
+    uv_mutex_lock(&server->mutex_);
+    command->is_done = true;
+    uv_cond_broadcast(&server->cond_);
+    uv_mutex_unlock(&server->mutex_);
+  }
+}
+
+} // namespace mock
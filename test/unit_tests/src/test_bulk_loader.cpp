@@ -0,0 +1,163 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "bulk_loader.hpp"
+#include "query_request.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+cass::HostVec create_replicas(const char* first, const char* second) {
+  cass::HostVec replicas;
+  replicas.push_back(cass::SharedRefPtr<cass::Host>(
+                       new cass::Host(cass::Address(first, 9042), false)));
+  replicas.push_back(cass::SharedRefPtr<cass::Host>(
+                       new cass::Host(cass::Address(second, 9042), false)));
+  return replicas;
+}
+
+cass::Statement* create_insert(int32_t value) {
+  cass::QueryRequest* query = new cass::QueryRequest("INSERT INTO t (k) VALUES (?)", 1);
+  query->bind(0, value);
+  return query;
+}
+
+BOOST_AUTO_TEST_SUITE(bulk_loader)
+
+BOOST_AUTO_TEST_CASE(group_by_replicas)
+{
+  cass::BatchGrouper grouper(3, 1024 * 1024);
+  cass::HostVec a(create_replicas("127.0.0.1", "127.0.0.2"));
+  cass::HostVec b(create_replicas("127.0.0.2", "127.0.0.3"));
+  cass::HostVec none;
+
+  cass::SharedRefPtr<cass::Statement> statements[8];
+  for (int i = 0; i < 8; ++i) {
+    statements[i].reset(create_insert(i));
+  }
+
+  cass::BatchGrouper::BatchVec batches;
+  grouper.add(a, statements[0].get(), &batches);
+  grouper.add(b, statements[1].get(), &batches);
+  grouper.add(a, statements[2].get(), &batches);
+  grouper.add(none, statements[3].get(), &batches);
+  grouper.add(b, statements[4].get(), &batches);
+  BOOST_CHECK(batches.empty());
+
+  // The third statement for the same replicas fills the batch
+  grouper.add(a, statements[5].get(), &batches);
+  BOOST_REQUIRE(batches.size() == 1);
+  cass::SharedRefPtr<cass::BatchRequest> batch(batches[0]);
+  BOOST_CHECK(batch->type() == CASS_BATCH_TYPE_UNLOGGED);
+  BOOST_REQUIRE(batch->statements().size() == 3);
+  cass::BatchRequest::StatementList::const_iterator it = batch->statements().begin();
+  BOOST_CHECK(it->get() == statements[0].get()); ++it;
+  BOOST_CHECK(it->get() == statements[2].get()); ++it;
+  BOOST_CHECK(it->get() == statements[5].get());
+
+  // A new batch is started for the same replicas
+  batches.clear();
+  grouper.add(a, statements[6].get(), &batches);
+  BOOST_CHECK(batches.empty());
+
+  grouper.take_all(&batches);
+  BOOST_REQUIRE(batches.size() == 3);
+  size_t count = 0;
+  for (size_t i = 0; i < batches.size(); ++i) {
+    count += batches[i]->statements().size();
+  }
+  BOOST_CHECK(count == 4);
+
+  batches.clear();
+  grouper.take_all(&batches);
+  BOOST_CHECK(batches.empty());
+}
+
+BOOST_AUTO_TEST_CASE(group_by_keyspace)
+{
+  cass::BatchGrouper grouper(100, 1024 * 1024);
+  cass::HostVec replicas(create_replicas("127.0.0.1", "127.0.0.2"));
+
+  cass::SharedRefPtr<cass::Statement> ks1(create_insert(1));
+  ks1->set_keyspace("ks1");
+  cass::SharedRefPtr<cass::Statement> ks2(create_insert(2));
+  ks2->set_keyspace("ks2");
+
+  cass::BatchGrouper::BatchVec batches;
+  grouper.add(replicas, ks1.get(), &batches);
+  grouper.add(replicas, ks2.get(), &batches);
+  grouper.add(replicas, ks1.get(), &batches);
+  BOOST_CHECK(batches.empty());
+
+  grouper.take_all(&batches);
+  BOOST_REQUIRE(batches.size() == 2);
+  for (size_t i = 0; i < batches.size(); ++i) {
+    const cass::BatchRequest::StatementList& statements = batches[i]->statements();
+    BOOST_CHECK(batches[i]->keyspace() == statements.front()->keyspace());
+    BOOST_CHECK(statements.size() == (batches[i]->keyspace() == "ks1" ? 2u : 1u));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(max_size)
+{
+  cass::SharedRefPtr<cass::Statement> statement(create_insert(1));
+  // <kind><query><n><value>
+  size_t size = 1 + 4 + statement->query().size() + 2 + 4 + 4;
+
+  cass::BatchGrouper grouper(100, 3 * size);
+  cass::HostVec replicas(create_replicas("127.0.0.1", "127.0.0.2"));
+
+  cass::BatchGrouper::BatchVec batches;
+  grouper.add(replicas, statement.get(), &batches);
+  grouper.add(replicas, statement.get(), &batches);
+  BOOST_CHECK(batches.empty());
+  grouper.add(replicas, statement.get(), &batches);
+  BOOST_REQUIRE(batches.size() == 1);
+  BOOST_CHECK(batches[0]->statements().size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(max_size_exceeded)
+{
+  cass::SharedRefPtr<cass::Statement> statement(create_insert(1));
+  // <kind><query><n><value>
+  size_t size = 1 + 4 + statement->query().size() + 2 + 4 + 4;
+
+  cass::BatchGrouper grouper(100, 2 * size + size / 2);
+  cass::HostVec replicas(create_replicas("127.0.0.1", "127.0.0.2"));
+
+  // The batch is taken before the statement that would make it too large
+  cass::BatchGrouper::BatchVec batches;
+  grouper.add(replicas, statement.get(), &batches);
+  grouper.add(replicas, statement.get(), &batches);
+  BOOST_CHECK(batches.empty());
+  grouper.add(replicas, statement.get(), &batches);
+  BOOST_REQUIRE(batches.size() == 1);
+  BOOST_CHECK(batches[0]->statements().size() == 2);
+
+  // A statement that's larger than the maximum is in its own batch
+  cass::BatchGrouper small_grouper(100, size / 2);
+  batches.clear();
+  small_grouper.add(replicas, statement.get(), &batches);
+  small_grouper.add(replicas, statement.get(), &batches);
+  BOOST_REQUIRE(batches.size() == 2);
+  BOOST_CHECK(batches[0]->statements().size() == 1);
+  BOOST_CHECK(batches[1]->statements().size() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "fixed_width_decoder.hpp"
+#include "serialization.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+// Encodes the collection items ([short] size and the value) for the values
+// 1 through "count". The item sizes are all "width" except for "bad_index".
+std::vector<char> encode_items(int32_t count, size_t width, int32_t bad_index = -1) {
+  std::vector<char> items(count * (sizeof(uint16_t) + width));
+  char* pos = &items[0];
+  for (int32_t i = 0; i < count; ++i) {
+    cass::encode_uint16(pos, i == bad_index ? width + 1 : width);
+    pos += sizeof(uint16_t);
+    if (width == sizeof(int32_t)) {
+      cass::encode_int32(pos, i + 1);
+    } else {
+      cass::encode_int64(pos, static_cast<cass_int64_t>(i + 1) << 32 | (i + 1));
+    }
+    pos += width;
+  }
+  return items;
+}
+
+BOOST_AUTO_TEST_SUITE(fixed_width_decoder)
+
+// The counts cover the vector kernels and the scalar remainders
+BOOST_AUTO_TEST_CASE(int32)
+{
+  for (int32_t count = 0; count < 64; ++count) {
+    std::vector<char> items(encode_items(count, sizeof(int32_t)));
+    std::vector<int32_t> output(count + 1, -1);
+    BOOST_REQUIRE(cass::decode_fixed_width_collection(items.empty() ? NULL : &items[0], items.size(),
+                                                      count, sizeof(int32_t),
+                                                      reinterpret_cast<char*>(&output[0])));
+    for (int32_t i = 0; i < count; ++i) {
+      BOOST_CHECK_EQUAL(output[i], i + 1);
+    }
+    BOOST_CHECK_EQUAL(output[count], -1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(int64)
+{
+  for (int32_t count = 0; count < 64; ++count) {
+    std::vector<char> items(encode_items(count, sizeof(cass_int64_t)));
+    std::vector<cass_int64_t> output(count + 1, -1);
+    BOOST_REQUIRE(cass::decode_fixed_width_collection(items.empty() ? NULL : &items[0], items.size(),
+                                                      count, sizeof(cass_int64_t),
+                                                      reinterpret_cast<char*>(&output[0])));
+    for (int32_t i = 0; i < count; ++i) {
+      BOOST_CHECK_EQUAL(output[i], static_cast<cass_int64_t>(i + 1) << 32 | (i + 1));
+    }
+    BOOST_CHECK_EQUAL(output[count], -1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_item_size)
+{
+  const int32_t count = 37;
+  const size_t widths[] = { sizeof(int32_t), sizeof(cass_int64_t) };
+
+  for (size_t w = 0; w < 2; ++w) {
+    for (int32_t bad_index = 0; bad_index < count; ++bad_index) {
+      std::vector<char> items(encode_items(count, widths[w], bad_index));
+      std::vector<cass_int64_t> output(count);
+      BOOST_CHECK(!cass::decode_fixed_width_collection(&items[0], items.size(),
+                                                       count, widths[w],
+                                                       reinterpret_cast<char*>(&output[0])));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(invalid_input_size)
+{
+  std::vector<char> items(encode_items(10, sizeof(int32_t)));
+  int32_t output[11];
+  BOOST_CHECK(!cass::decode_fixed_width_collection(&items[0], items.size() - 1,
+                                                   10, sizeof(int32_t),
+                                                   reinterpret_cast<char*>(output)));
+  BOOST_CHECK(!cass::decode_fixed_width_collection(&items[0], items.size(),
+                                                   11, sizeof(int32_t),
+                                                   reinterpret_cast<char*>(output)));
+  BOOST_CHECK(!cass::decode_fixed_width_collection(&items[0], items.size(),
+                                                   10, 3,
+                                                   reinterpret_cast<char*>(output)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
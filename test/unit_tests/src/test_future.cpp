@@ -0,0 +1,85 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+void count_callbacks(CassFuture* future, void* data) {
+  ++(*static_cast<int*>(data));
+}
+
+BOOST_AUTO_TEST_SUITE(future)
+
+BOOST_AUTO_TEST_CASE(set_once)
+{
+  cass::ScopedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  int callback_count = 0;
+  BOOST_REQUIRE(future->set_callback(count_callbacks, &callback_count));
+
+  future->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
+  future->set_result(cass::Address(), new cass::ResultResponse());
+  future->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "No hosts available");
+
+  // Only the first error is kept and the callback is only run once
+  BOOST_CHECK(future->get_error()->code == CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+  BOOST_CHECK(callback_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(cancel)
+{
+  cass::ResponseFuture* future = new cass::ResponseFuture();
+  cass::ScopedRefPtr<cass::RequestHandler> handler(
+        new cass::RequestHandler(new cass::QueryRequest("SELECT * FROM t"), future));
+  int callback_count = 0;
+  BOOST_REQUIRE(future->set_callback(count_callbacks, &callback_count));
+
+  BOOST_CHECK(!handler->is_cancelled());
+  BOOST_CHECK(!handler->is_result_discarded());
+
+  BOOST_CHECK(cass_future_cancel(CassFuture::to(future)) == cass_true);
+  BOOST_CHECK(cass_future_cancel(CassFuture::to(future)) == cass_false);
+  BOOST_CHECK(callback_count == 1);
+  BOOST_CHECK(cass_future_error_code(CassFuture::to(future)) == CASS_ERROR_LIB_REQUEST_CANCELLED);
+
+  // The response of a request that's already written is discarded
+  BOOST_CHECK(handler->is_cancelled());
+  BOOST_CHECK(handler->is_result_discarded());
+
+  // A response that arrives later doesn't replace the error
+  future->set_result(cass::Address(), new cass::ResultResponse());
+  BOOST_CHECK(cass_future_get_result(CassFuture::to(future)) == NULL);
+  BOOST_CHECK(callback_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_already_set)
+{
+  cass::ScopedRefPtr<cass::ResponseFuture> future(new cass::ResponseFuture());
+  future->set_result(cass::Address(), new cass::ResultResponse());
+
+  BOOST_CHECK(cass_future_cancel(CassFuture::to(future.get())) == cass_false);
+  BOOST_CHECK(!future->is_cancelled());
+  BOOST_CHECK(cass_future_error_code(CassFuture::to(future.get())) == CASS_OK);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "io_thread_group.hpp"
+#include "timer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <uv.h>
+
+struct TimerTask {
+  cass::IOThread* thread;
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+  bool is_fired;
+};
+
+void on_timer(cass::Timer* timer) {
+  TimerTask* task = static_cast<TimerTask*>(timer->data());
+  uv_mutex_lock(&task->mutex);
+  task->is_fired = true;
+  uv_cond_signal(&task->cond);
+  uv_mutex_unlock(&task->mutex);
+}
+
+// Handles are initialized by tasks that run on the shared loop's thread
+int start_timer(void* data) {
+  TimerTask* task = static_cast<TimerTask*>(data);
+  cass::Timer::start(task->thread->loop(), 1, task, on_timer);
+  return 42;
+}
+
+BOOST_AUTO_TEST_SUITE(io_thread_group)
+
+BOOST_AUTO_TEST_CASE(run_task)
+{
+  cass::ScopedRefPtr<cass::IOThreadGroup> group(new cass::IOThreadGroup(2));
+  BOOST_REQUIRE(group->thread_count() == 2);
+  BOOST_REQUIRE(group->start() == 0);
+  BOOST_REQUIRE(group->start() == 0); // Only started once
+
+  for (unsigned i = 0; i < group->thread_count(); ++i) {
+    TimerTask task;
+    task.thread = group->thread(i);
+    task.is_fired = false;
+    uv_mutex_init(&task.mutex);
+    uv_cond_init(&task.cond);
+
+    BOOST_CHECK(task.thread->run_task(start_timer, &task) == 42);
+
+    // The loop keeps running the handles added by tasks
+    uv_mutex_lock(&task.mutex);
+    while (!task.is_fired) {
+      uv_cond_wait(&task.cond, &task.mutex);
+    }
+    uv_mutex_unlock(&task.mutex);
+
+    uv_cond_destroy(&task.cond);
+    uv_mutex_destroy(&task.mutex);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(not_started)
+{
+  // The threads are only created by the first session that uses the group
+  cass::ScopedRefPtr<cass::IOThreadGroup> group(new cass::IOThreadGroup(0));
+  BOOST_CHECK(group->thread_count() == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
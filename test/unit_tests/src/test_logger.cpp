@@ -0,0 +1,112 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "config.hpp"
+#include "logger.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <uv.h>
+
+struct LogCounter {
+  LogCounter()
+    : count(0)
+    , is_blocked(false) {
+    uv_sem_init(&sem, 0);
+  }
+
+  ~LogCounter() {
+    uv_sem_destroy(&sem);
+  }
+
+  int count;
+  bool is_blocked;
+  uv_sem_t sem;
+};
+
+void count_log(const CassLogMessage* message, void* data) {
+  LogCounter* counter = static_cast<LogCounter*>(data);
+  if (counter->is_blocked && counter->count == 0) {
+    // Holds up the background thread so that the queue fills up
+    uv_sem_wait(&counter->sem);
+  }
+  counter->count++;
+}
+
+void log_messages(int count) {
+  for (int i = 0; i < count; ++i) {
+    cass::Logger::log(CASS_LOG_ERROR, __FILE__, __LINE__, "", "message %d", i);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(logger)
+
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+  LogCounter counter;
+  cass::Logger::set_callback(count_log, &counter);
+  cass::Logger::set_rate_limit(2);
+  uint64_t rate_limited = cass::Logger::rate_limited_count();
+
+  // A second can pass during the loop so up to twice the limit is logged
+  log_messages(10);
+  BOOST_CHECK(counter.count >= 2 && counter.count <= 4);
+  BOOST_CHECK_EQUAL(cass::Logger::rate_limited_count() - rate_limited,
+                    static_cast<uint64_t>(10 - counter.count));
+
+  cass::Logger::set_rate_limit(0);
+  cass::Logger::set_callback(cass::stderr_log_callback, NULL);
+}
+
+BOOST_AUTO_TEST_CASE(async)
+{
+  LogCounter counter;
+  cass::Logger::set_callback(count_log, &counter);
+  BOOST_REQUIRE(cass::Logger::start_async(16) == 0);
+
+  log_messages(10);
+
+  // Stopping delivers the queued messages
+  cass::Logger::stop_async();
+  BOOST_CHECK_EQUAL(counter.count, 10);
+
+  cass::Logger::set_callback(cass::stderr_log_callback, NULL);
+}
+
+BOOST_AUTO_TEST_CASE(async_queue_full)
+{
+  LogCounter counter;
+  counter.is_blocked = true;
+  cass::Logger::set_callback(count_log, &counter);
+  BOOST_REQUIRE(cass::Logger::start_async(4) == 0);
+  uint64_t dropped = cass::Logger::dropped_count();
+
+  log_messages(20);
+  uv_sem_post(&counter.sem);
+  cass::Logger::stop_async();
+
+  BOOST_CHECK(cass::Logger::dropped_count() > dropped);
+  BOOST_CHECK_EQUAL(counter.count + static_cast<int>(cass::Logger::dropped_count() - dropped), 20);
+
+  cass::Logger::set_callback(cass::stderr_log_callback, NULL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
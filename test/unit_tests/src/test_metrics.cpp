@@ -18,7 +18,9 @@
 #   define BOOST_TEST_MODULE cassandra
 #endif
 
+#include "host_metrics_iterator.hpp"
 #include "metrics.hpp"
+#include "request_timeline.hpp"
 
 #include <boost/chrono.hpp>
 #include <boost/test/unit_test.hpp>
@@ -109,6 +111,63 @@ BOOST_AUTO_TEST_CASE(counter_threads)
   BOOST_CHECK(counter.sum() == static_cast<uint64_t>(NUM_THREADS * NUM_ITERATIONS));
 }
 
+BOOST_AUTO_TEST_CASE(thread_state_growth)
+{
+  const int num_threads = 8;
+  CounterThreadArgs args[num_threads];
+
+  // Storage for more threads is allocated as they record values
+  cass::Metrics::ThreadState thread_state(1);
+  cass::Metrics::Counter counter(&thread_state);
+
+  for (int i = 0; i < num_threads; ++i) {
+    args[i].counter = &counter;
+    uv_thread_create(&args[i].thread, counter_thread, &args[i]);
+  }
+
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+
+  BOOST_CHECK(counter.sum() == num_threads * NUM_ITERATIONS);
+  BOOST_CHECK(thread_state.slot_count() <= num_threads);
+  // Slots are released when threads exit
+  BOOST_CHECK(thread_state.thread_count() == 0);
+
+  counter.inc();
+  BOOST_CHECK(counter.sum() == num_threads * NUM_ITERATIONS + 1);
+  BOOST_CHECK(thread_state.thread_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(thread_state_slot_reuse)
+{
+  cass::Metrics::ThreadState thread_state(1);
+  cass::Metrics::Counter counter(&thread_state);
+  cass::Metrics::Histogram histogram(&thread_state);
+
+  for (int i = 0; i < 10; ++i) {
+    CounterThreadArgs counter_args;
+    counter_args.counter = &counter;
+    uv_thread_create(&counter_args.thread, counter_thread, &counter_args);
+    uv_thread_join(&counter_args.thread);
+
+    HistogramThreadArgs histogram_args;
+    histogram_args.histogram = &histogram;
+    histogram_args.id = 1;
+    uv_thread_create(&histogram_args.thread, histogram_thread, &histogram_args);
+    uv_thread_join(&histogram_args.thread);
+  }
+
+  // Each thread reused the slot of the previous thread and the values
+  // recorded by the exited threads are kept
+  BOOST_CHECK(thread_state.slot_count() == 1);
+  BOOST_CHECK(counter.sum() == 10 * NUM_ITERATIONS);
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+  histogram.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 10 * 100);
+}
+
 BOOST_AUTO_TEST_CASE(histogram)
 {
   cass::Metrics::ThreadState thread_state(1);
@@ -133,6 +192,85 @@ BOOST_AUTO_TEST_CASE(histogram)
   BOOST_CHECK(snapshot.stddev == 28);
 }
 
+BOOST_AUTO_TEST_CASE(histogram_range)
+{
+  cass::Metrics::ThreadState thread_state(1);
+  cass::Metrics::Histogram histogram(&thread_state, 1000, 2);
+
+  histogram.record_value(0);
+  histogram.record_value(10);
+  // Values past the range are recorded as the highest trackable value
+  histogram.record_value(5000);
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+  histogram.get_snapshot(&snapshot);
+
+  BOOST_CHECK(snapshot.count == 3);
+  BOOST_CHECK(snapshot.min == 0);
+  BOOST_CHECK(snapshot.median == 10);
+  // Two significant figures
+  BOOST_CHECK(snapshot.max >= 1000 && snapshot.max < 1010);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_repeated_snapshots)
+{
+  cass::Metrics::ThreadState thread_state(1);
+  cass::Metrics::Histogram histogram(&thread_state);
+
+  histogram.record_value(100);
+  histogram.record_value(200);
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+  histogram.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 2);
+
+  // Values are only collected from the recording threads once
+  histogram.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 2);
+
+  histogram.record_value(300);
+  histogram.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 3);
+  BOOST_CHECK(snapshot.max == 300);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_interval_snapshots)
+{
+  cass::Metrics::ThreadState thread_state(1);
+  cass::Metrics::Histogram histogram(&thread_state);
+
+  histogram.record_value(100);
+  histogram.record_value(200);
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+  histogram.get_interval_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 2);
+  BOOST_CHECK(snapshot.min == 100);
+  BOOST_CHECK(snapshot.max == 200);
+
+  // Taking the interval snapshot starts a new interval
+  histogram.get_interval_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 0);
+  BOOST_CHECK(snapshot.min == 0);
+  BOOST_CHECK(snapshot.max == 0);
+
+  histogram.record_value(1000);
+  // The cumulative snapshot doesn't reset the interval
+  histogram.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 3);
+  BOOST_CHECK(snapshot.min == 100);
+
+  histogram.get_interval_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 1);
+  BOOST_CHECK(snapshot.min == 1000);
+  BOOST_CHECK(snapshot.max == 1000);
+
+  // Interval snapshots don't reset the cumulative values
+  histogram.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 3);
+  BOOST_CHECK(snapshot.max == 1000);
+}
+
 BOOST_AUTO_TEST_CASE(histogram_threads)
 {
   HistogramThreadArgs args[NUM_THREADS];
@@ -205,4 +343,135 @@ BOOST_AUTO_TEST_CASE(meter_threads)
   BOOST_CHECK_CLOSE(meter.fifteen_minute_rate(), 10 * NUM_THREADS, 15.0);
 }
 
+BOOST_AUTO_TEST_CASE(priority_request_latencies)
+{
+  cass::Metrics metrics(1);
+
+  metrics.record_request(1000 * 1000, CASS_REQUEST_PRIORITY_NORMAL);
+  metrics.record_request(10 * 1000, CASS_REQUEST_PRIORITY_HIGH);
+
+  // Latencies are recorded for all requests and for the request's priority
+  cass::Metrics::Histogram::Snapshot snapshot;
+  metrics.request_latencies.get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.min == 10);
+  BOOST_CHECK(snapshot.max == 1000);
+
+  metrics.priority_request_latencies(CASS_REQUEST_PRIORITY_NORMAL).get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.min == 1000);
+  BOOST_CHECK(snapshot.max == 1000);
+
+  metrics.priority_request_latencies(CASS_REQUEST_PRIORITY_HIGH).get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.min == 10);
+  BOOST_CHECK(snapshot.max == 10);
+}
+
+BOOST_AUTO_TEST_CASE(host_metrics)
+{
+  cass::Metrics metrics(1);
+  metrics.enable_host_latencies();
+  cass::Address address1("127.0.0.1", 9042);
+  cass::Address address2("127.0.0.2", 9042);
+
+  // The metrics of a host are shared by everything that records them
+  cass::SharedRefPtr<cass::Metrics::HostMetrics> host_metrics1(
+        metrics.get_or_create_host_metrics(address1));
+  BOOST_CHECK(metrics.get_or_create_host_metrics(address1).get() == host_metrics1.get());
+
+  host_metrics1->latencies->record_value(100);
+  host_metrics1->in_flight_requests.inc();
+  host_metrics1->in_flight_requests.inc();
+  host_metrics1->in_flight_requests.dec();
+  host_metrics1->bytes_written.add(64);
+  host_metrics1->timeouts.inc();
+
+  cass::SharedRefPtr<cass::Metrics::HostMetrics> host_metrics2(
+        metrics.get_or_create_host_metrics(address2));
+  host_metrics2->bytes_read.add(128);
+
+  {
+    cass::HostMetricsIterator iterator(&metrics);
+
+    CassHostMetrics output;
+    BOOST_REQUIRE(iterator.next());
+    iterator.host_metrics(&output);
+    BOOST_CHECK(output.address.address_length == 4);
+    BOOST_CHECK(output.address.address[3] == 1);
+    BOOST_CHECK(output.port == 9042);
+    BOOST_CHECK(output.requests.min == 100);
+    BOOST_CHECK(output.requests.max == 100);
+    BOOST_CHECK(output.in_flight_requests == 1);
+    BOOST_CHECK(output.bytes_written == 64);
+    BOOST_CHECK(output.request_timeouts == 1);
+    BOOST_CHECK(output.bytes_read == 0);
+
+    BOOST_REQUIRE(iterator.next());
+    iterator.host_metrics(&output);
+    BOOST_CHECK(output.address.address[3] == 2);
+    BOOST_CHECK(output.bytes_read == 128);
+    BOOST_CHECK(output.requests.max == 0);
+
+    BOOST_CHECK(!iterator.next());
+  }
+
+  // Removed hosts are no longer reported
+  metrics.remove_host_metrics(address1);
+  cass::HostMetricsIterator iterator(&metrics);
+  BOOST_REQUIRE(iterator.next());
+  CassHostMetrics output;
+  iterator.host_metrics(&output);
+  BOOST_CHECK(output.address.address[3] == 2);
+  BOOST_CHECK(!iterator.next());
+}
+
+BOOST_AUTO_TEST_CASE(host_metrics_without_latencies)
+{
+  // The latency histograms aren't allocated unless they're enabled
+  cass::Metrics metrics(1);
+  cass::SharedRefPtr<cass::Metrics::HostMetrics> host_metrics(
+        metrics.get_or_create_host_metrics(cass::Address("127.0.0.1", 9042)));
+  BOOST_CHECK(!host_metrics->latencies);
+  host_metrics->bytes_written.add(64);
+
+  cass::HostMetricsIterator iterator(&metrics);
+  BOOST_REQUIRE(iterator.next());
+  CassHostMetrics output;
+  iterator.host_metrics(&output);
+  BOOST_CHECK(output.requests.max == 0);
+  BOOST_CHECK(output.requests.percentile_99th == 0);
+  BOOST_CHECK(output.bytes_written == 64);
+}
+
+BOOST_AUTO_TEST_CASE(request_stage_latencies)
+{
+  cass::Metrics metrics(1);
+  BOOST_CHECK(metrics.request_stage_latencies(CASS_REQUEST_STAGE_WRITTEN) == NULL);
+
+  metrics.enable_request_stage_latencies();
+  BOOST_CHECK(metrics.request_stage_latencies(CASS_REQUEST_STAGE_CREATED) == NULL);
+
+  cass::RequestTimeline timeline;
+  cass_uint64_t* timestamps = timeline.timeline.timestamps;
+  timestamps[CASS_REQUEST_STAGE_CREATED] = 1000 * 1000;
+  timestamps[CASS_REQUEST_STAGE_SESSION] = 1010 * 1000;
+  timestamps[CASS_REQUEST_STAGE_IO_WORKER] = 1030 * 1000;
+  timestamps[CASS_REQUEST_STAGE_CONNECTION] = 1060 * 1000;
+  // The request failed before it was written
+  timestamps[CASS_REQUEST_STAGE_COMPLETED] = 1160 * 1000;
+  metrics.record_request_timeline(timeline.timeline);
+
+  cass::Metrics::Histogram::Snapshot snapshot;
+  metrics.request_stage_latencies(CASS_REQUEST_STAGE_SESSION)->get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 1 && snapshot.max == 10);
+  metrics.request_stage_latencies(CASS_REQUEST_STAGE_IO_WORKER)->get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 1 && snapshot.max == 20);
+  metrics.request_stage_latencies(CASS_REQUEST_STAGE_CONNECTION)->get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 1 && snapshot.max == 30);
+
+  // Stages that weren't reached are skipped
+  metrics.request_stage_latencies(CASS_REQUEST_STAGE_WRITTEN)->get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 0);
+  metrics.request_stage_latencies(CASS_REQUEST_STAGE_COMPLETED)->get_snapshot(&snapshot);
+  BOOST_CHECK(snapshot.count == 1 && snapshot.max == 100);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "metrics_export.hpp"
+
+#include "third_party/rapidjson/rapidjson/document.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+// The metrics of a session with a single IO worker and host
+void record_metrics(cass::Metrics* metrics) {
+  metrics->record_request(150 * 1000, CASS_REQUEST_PRIORITY_NORMAL);
+  metrics->record_request(3 * 1000 * 1000, CASS_REQUEST_PRIORITY_HIGH);
+  metrics->request_timeouts.inc();
+
+  metrics->enable_host_latencies();
+  cass::SharedRefPtr<cass::Metrics::HostMetrics> host_metrics(
+        metrics->get_or_create_host_metrics(cass::Address("127.0.0.1", 9042)));
+  host_metrics->latencies->record_value(150);
+  host_metrics->bytes_written.add(64);
+}
+
+bool contains(const std::string& output, const std::string& line) {
+  return output.find(line + "\n") != std::string::npos;
+}
+
+BOOST_AUTO_TEST_SUITE(metrics_export)
+
+BOOST_AUTO_TEST_CASE(bucket_bounds)
+{
+  BOOST_CHECK_EQUAL(cass::Metrics::Histogram::bucket_bound(0), 100);
+  BOOST_CHECK_EQUAL(cass::Metrics::Histogram::bucket_bound(1), 200);
+  BOOST_CHECK_EQUAL(cass::Metrics::Histogram::bucket_bound(2), 500);
+  BOOST_CHECK_EQUAL(cass::Metrics::Histogram::bucket_bound(3), 1000);
+  BOOST_CHECK_EQUAL(cass::Metrics::Histogram::bucket_bound(cass::Metrics::Histogram::BUCKET_COUNT - 1),
+                    10 * 1000 * 1000);
+}
+
+BOOST_AUTO_TEST_CASE(prometheus)
+{
+  cass::Metrics metrics(1);
+  record_metrics(&metrics);
+
+  cass::IOWorkerStatsVec io_workers(1);
+  io_workers[0].request_queue_size = 3;
+
+  std::string output;
+  cass::export_metrics(&metrics, io_workers, CASS_METRICS_FORMAT_PROMETHEUS, &output);
+
+  BOOST_CHECK(contains(output, "# TYPE cassandra_driver_request_latency_microseconds histogram"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_latency_microseconds_bucket{le=\"100\"} 0"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_latency_microseconds_bucket{le=\"200\"} 1"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_latency_microseconds_bucket{le=\"2000\"} 1"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_latency_microseconds_bucket{le=\"5000\"} 2"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_latency_microseconds_bucket{le=\"+Inf\"} 2"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_latency_microseconds_count 2"));
+  BOOST_CHECK(contains(output, "cassandra_driver_priority_request_latency_microseconds_count{priority=\"high\"} 1"));
+  BOOST_CHECK(contains(output, "cassandra_driver_request_timeouts_total 1"));
+  BOOST_CHECK(contains(output, "cassandra_driver_host_request_latency_min_microseconds{host=\"127.0.0.1:9042\"} 150"));
+  BOOST_CHECK(contains(output, "cassandra_driver_host_written_bytes_total{host=\"127.0.0.1:9042\"} 64"));
+  BOOST_CHECK(contains(output, "cassandra_driver_io_worker_request_queue_size{io_worker=\"0\"} 3"));
+}
+
+BOOST_AUTO_TEST_CASE(io_worker_loop_metrics)
+{
+  cass::Metrics metrics(1);
+  cass::Metrics::IOWorkerMetrics loop_metrics;
+  loop_metrics.loop_lags.record_value(250);
+  loop_metrics.request_queue_depths.record_value(7);
+  loop_metrics.flush_sizes.record_value(512);
+  loop_metrics.flushes.inc();
+
+  cass::IOWorkerStatsVec io_workers(2);
+  io_workers[1].loop_metrics = &loop_metrics;
+
+  std::string output;
+  cass::export_metrics(&metrics, io_workers, CASS_METRICS_FORMAT_PROMETHEUS, &output);
+
+  BOOST_CHECK(contains(output, "# TYPE cassandra_driver_io_worker_loop_lag_microseconds summary"));
+  BOOST_CHECK(contains(output, "cassandra_driver_io_worker_loop_lag_microseconds{io_worker=\"1\",quantile=\"0.5\"} 250"));
+  BOOST_CHECK(contains(output, "cassandra_driver_io_worker_request_queue_depth_count{io_worker=\"1\"} 1"));
+  BOOST_CHECK(contains(output, "cassandra_driver_io_worker_flush_bytes_count{io_worker=\"1\"} 1"));
+  BOOST_CHECK(contains(output, "cassandra_driver_io_worker_flushes_total{io_worker=\"1\"} 1"));
+  // Workers without loop metrics only have their queue size
+  BOOST_CHECK(output.find("cassandra_driver_io_worker_flushes_total{io_worker=\"0\"}") == std::string::npos);
+
+  cass::export_metrics(&metrics, io_workers, CASS_METRICS_FORMAT_JSON, &output);
+
+  rapidjson::Document d;
+  d.Parse<0>(output.c_str());
+  BOOST_REQUIRE(!d.HasParseError());
+
+  const rapidjson::Value& io_worker = d["io_workers"][1u];
+  BOOST_CHECK_EQUAL(io_worker["loop_lags"]["max"].GetInt64(), 250);
+  BOOST_CHECK(!io_worker["loop_lags"].HasMember("buckets"));
+  BOOST_CHECK_EQUAL(io_worker["request_queue_depths"]["count"].GetInt64(), 1);
+  BOOST_CHECK_EQUAL(io_worker["flushes"].GetInt64(), 1);
+  BOOST_CHECK(!d["io_workers"][0u].HasMember("flushes"));
+}
+
+BOOST_AUTO_TEST_CASE(json)
+{
+  cass::Metrics metrics(1);
+  record_metrics(&metrics);
+
+  std::string output;
+  cass::export_metrics(&metrics, cass::IOWorkerStatsVec(2), CASS_METRICS_FORMAT_JSON, &output);
+
+  rapidjson::Document d;
+  d.Parse<0>(output.c_str());
+  BOOST_REQUIRE(!d.HasParseError());
+
+  const rapidjson::Value& latencies = d["requests"]["latencies"];
+  BOOST_CHECK_EQUAL(latencies["count"].GetInt64(), 2);
+  BOOST_CHECK_EQUAL(latencies["min"].GetInt64(), 150);
+  BOOST_REQUIRE(latencies["buckets"].Size() == cass::Metrics::Histogram::BUCKET_COUNT);
+  BOOST_CHECK_EQUAL(latencies["buckets"][1u]["le"].GetInt64(), 200);
+  BOOST_CHECK_EQUAL(latencies["buckets"][1u]["count"].GetInt64(), 1);
+
+  BOOST_CHECK_EQUAL(d["priority_requests"]["high"]["count"].GetInt64(), 1);
+  BOOST_CHECK_EQUAL(d["errors"]["request_timeouts"].GetInt64(), 1);
+
+  const rapidjson::Value& hosts = d["hosts"];
+  BOOST_REQUIRE(hosts.Size() == 1);
+  BOOST_CHECK(std::string(hosts[0u]["address"].GetString()) == "127.0.0.1");
+  BOOST_CHECK_EQUAL(hosts[0u]["port"].GetInt(), 9042);
+  BOOST_CHECK_EQUAL(hosts[0u]["bytes_written"].GetInt64(), 64);
+
+  BOOST_CHECK(d["io_workers"].Size() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
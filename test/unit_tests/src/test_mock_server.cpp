@@ -0,0 +1,279 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "cassandra.h"
+#include "mock_server.hpp"
+
+#include "third_party/rapidjson/rapidjson/document.h"
+
+#include <boost/chrono.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <string>
+#include <string.h>
+
+#define MOCK_PORT 19042
+
+struct MockCluster {
+  MockCluster(int num_nodes)
+    : server(MOCK_PORT)
+    , cluster(cass_cluster_new())
+    , session(cass_session_new()) {
+    server.add_keyspace("ks", 3);
+    server.add_table("ks", "kv");
+    BOOST_REQUIRE(server.start(num_nodes));
+
+    cass_cluster_set_contact_points(cluster, "127.0.0.1");
+    cass_cluster_set_port(cluster, MOCK_PORT);
+  }
+
+  ~MockCluster() {
+    cass_session_free(session);
+    cass_cluster_free(cluster);
+  }
+
+  CassError connect() {
+    CassFuture* future = cass_session_connect(session, cluster);
+    CassError rc = cass_future_error_code(future);
+    cass_future_free(future);
+    return rc;
+  }
+
+  CassError execute(const char* query) {
+    CassStatement* statement = cass_statement_new(query, 0);
+    CassFuture* future = cass_session_execute(session, statement);
+    CassError rc = cass_future_error_code(future);
+    cass_future_free(future);
+    cass_statement_free(statement);
+    return rc;
+  }
+
+  int total_request_count(int num_nodes) const {
+    int count = 0;
+    for (int i = 1; i <= num_nodes; ++i) {
+      count += server.request_count(i);
+    }
+    return count;
+  }
+
+  mock::Server server;
+  CassCluster* cluster;
+  CassSession* session;
+};
+
+BOOST_AUTO_TEST_SUITE(mock_server)
+
+BOOST_AUTO_TEST_CASE(connect_and_query)
+{
+  MockCluster mock(3);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  // The schema is built from the mock's schema tables
+  const CassSchema* schema = cass_session_get_schema(mock.session);
+  const CassSchemaMeta* keyspace = cass_schema_get_keyspace(schema, "ks");
+  BOOST_REQUIRE(keyspace != NULL);
+  BOOST_CHECK(cass_schema_meta_get_entry(keyspace, "kv") != NULL);
+  cass_schema_free(schema);
+
+  // The peers are discovered and the requests are spread across all nodes
+  int before = mock.total_request_count(3);
+  for (int i = 0; i < 30; ++i) {
+    BOOST_REQUIRE(mock.execute("SELECT * FROM ks.kv") == CASS_OK);
+  }
+  BOOST_CHECK_EQUAL(mock.total_request_count(3) - before, 30);
+  for (int i = 1; i <= 3; ++i) {
+    BOOST_CHECK(mock.server.connection_count(i) > 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(error_injection)
+{
+  MockCluster mock(1);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  mock::Rule rule;
+  rule.query = "INSERT";
+  rule.error_code = mock::ERROR_SYNTAX_ERROR;
+  rule.count = 1;
+  mock.server.add_rule(rule);
+
+  BOOST_CHECK(mock.execute("INSERT INTO ks.kv (key, value) VALUES ('a', 'b')") ==
+              CASS_ERROR_SERVER_SYNTAX_ERROR);
+  BOOST_CHECK(mock.execute("INSERT INTO ks.kv (key, value) VALUES ('a', 'b')") == CASS_OK);
+}
+
+BOOST_AUTO_TEST_CASE(latency_injection)
+{
+  MockCluster mock(1);
+  cass_cluster_set_request_timeout(mock.cluster, 200);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  mock::Rule rule;
+  rule.query = "SELECT * FROM ks.kv";
+  rule.latency_ms = 1000;
+  mock.server.add_rule(rule);
+
+  BOOST_CHECK(mock.execute("SELECT * FROM ks.kv") == CASS_ERROR_LIB_REQUEST_TIMED_OUT);
+
+  mock.server.clear_rules();
+  BOOST_CHECK(mock.execute("SELECT * FROM ks.kv") == CASS_OK);
+}
+
+BOOST_AUTO_TEST_CASE(prepare_and_execute)
+{
+  MockCluster mock(2);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  CassFuture* future = cass_session_prepare(mock.session,
+                                            "INSERT INTO ks.kv (key, value) VALUES (?, ?)");
+  BOOST_REQUIRE(cass_future_error_code(future) == CASS_OK);
+  const CassPrepared* prepared = cass_future_get_prepared(future);
+  cass_future_free(future);
+
+  for (int i = 0; i < 10; ++i) {
+    CassStatement* statement = cass_prepared_bind(prepared);
+    BOOST_REQUIRE(cass_statement_bind_string(statement, 0, "key") == CASS_OK);
+    BOOST_REQUIRE(cass_statement_bind_string(statement, 1, "value") == CASS_OK);
+    future = cass_session_execute(mock.session, statement);
+    BOOST_CHECK(cass_future_error_code(future) == CASS_OK);
+    cass_future_free(future);
+    cass_statement_free(statement);
+  }
+
+  cass_prepared_free(prepared);
+}
+
+BOOST_AUTO_TEST_CASE(prepare_cached)
+{
+  MockCluster mock(1);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  const char* query = "INSERT INTO ks.kv (key, value) VALUES (?, ?)";
+
+  CassFuture* future = cass_session_prepare(mock.session, query);
+  BOOST_REQUIRE(cass_future_error_code(future) == CASS_OK);
+  cass_prepared_free(cass_future_get_prepared(future));
+  cass_future_free(future);
+
+  // The second prepare of the same query is completed from the cache
+  int before = mock.total_request_count(1);
+  future = cass_session_prepare(mock.session, query);
+  BOOST_REQUIRE(cass_future_error_code(future) == CASS_OK);
+  const CassPrepared* prepared = cass_future_get_prepared(future);
+  cass_future_free(future);
+  BOOST_REQUIRE(prepared != NULL);
+  BOOST_CHECK_EQUAL(mock.total_request_count(1), before);
+
+  CassStatement* statement = cass_prepared_bind(prepared);
+  BOOST_REQUIRE(cass_statement_bind_string(statement, 0, "key") == CASS_OK);
+  BOOST_REQUIRE(cass_statement_bind_string(statement, 1, "value") == CASS_OK);
+  future = cass_session_execute(mock.session, statement);
+  BOOST_CHECK(cass_future_error_code(future) == CASS_OK);
+  cass_future_free(future);
+  cass_statement_free(statement);
+
+  cass_prepared_free(prepared);
+}
+
+BOOST_AUTO_TEST_CASE(topology_changes)
+{
+  MockCluster mock(1);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  // The new node is added to the driver's pools when its event arrives
+  int node = mock.server.add_node();
+  BOOST_REQUIRE_EQUAL(node, 2);
+  for (int i = 0; i < 100 && mock.server.connection_count(node) == 0; ++i) {
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+  }
+  BOOST_CHECK(mock.server.connection_count(node) > 0);
+
+  // The stopped node's connections are closed but requests keep succeeding
+  mock.server.stop_node(node);
+  BOOST_CHECK_EQUAL(mock.server.connection_count(node), 0);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK(mock.execute("SELECT * FROM ks.kv") == CASS_OK);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(extended_metrics)
+{
+  MockCluster mock(1);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  for (int i = 0; i < 5; ++i) {
+    CassStatement* statement =
+        cass_statement_new("INSERT INTO ks.kv (key, value) VALUES ('a', 'b')", 0);
+    BOOST_REQUIRE(cass_session_execute_discard(mock.session, statement, NULL, NULL) == CASS_OK);
+    cass_statement_free(statement);
+  }
+
+  CassExtendedMetrics metrics;
+  memset(&metrics, 0, sizeof(metrics));
+  for (int i = 0; i < 100 && metrics.discarded.results < 5; ++i) {
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    cass_session_get_extended_metrics(mock.session, &metrics, sizeof(metrics));
+  }
+  BOOST_CHECK_EQUAL(metrics.discarded.results, 5);
+  BOOST_CHECK_EQUAL(metrics.discarded.errors, 0);
+
+  // An older (smaller) struct only has the fields that fit written
+  memset(&metrics, 0xFF, sizeof(metrics));
+  cass_session_get_extended_metrics(mock.session, &metrics, sizeof(metrics.errors));
+  BOOST_CHECK_EQUAL(metrics.errors.expired_before_send, 0);
+  BOOST_CHECK(metrics.discarded.results == static_cast<cass_uint64_t>(-1));
+}
+
+BOOST_AUTO_TEST_CASE(io_worker_loop_metrics)
+{
+  MockCluster mock(1);
+  cass_cluster_set_num_threads_io(mock.cluster, 1);
+  BOOST_REQUIRE(mock.connect() == CASS_OK);
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_REQUIRE(mock.execute("SELECT * FROM ks.kv") == CASS_OK);
+  }
+  // The loop lag timer keeps firing every 100 ms
+  boost::this_thread::sleep_for(boost::chrono::milliseconds(450));
+
+  size_t size = 0;
+  BOOST_REQUIRE(cass_session_export_metrics(mock.session, CASS_METRICS_FORMAT_JSON,
+                                            NULL, &size) == CASS_ERROR_LIB_BUFFER_TOO_SMALL);
+  // Room for the metrics recorded between the two calls
+  std::string output(size + 4096, '\0');
+  size = output.size();
+  BOOST_REQUIRE(cass_session_export_metrics(mock.session, CASS_METRICS_FORMAT_JSON,
+                                            &output[0], &size) == CASS_OK);
+
+  rapidjson::Document d;
+  d.Parse<0>(output.c_str());
+  BOOST_REQUIRE(!d.HasParseError());
+
+  const rapidjson::Value& io_worker = d["io_workers"][0u];
+  BOOST_CHECK(io_worker["loop_lags"]["count"].GetInt64() >= 3);
+  // The socket reads and writes of the requests are counted along with
+  // the request queue wakeups
+  BOOST_CHECK(io_worker["callbacks_per_iteration"]["count"].GetInt64() > 0);
+  BOOST_CHECK(io_worker["callbacks_per_iteration"]["max"].GetInt64() >= 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
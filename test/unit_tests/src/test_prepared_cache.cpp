@@ -0,0 +1,185 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "prepared.hpp"
+#include "result_response.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+// A prepared statement for a query without bound values
+cass::SharedRefPtr<const cass::Prepared> create_prepared(const std::string& id,
+                                                         const std::string& query,
+                                                         const std::string& keyspace = "ks",
+                                                         const std::string& table = "t") {
+  cass::Buffer body(sizeof(int32_t) + // kind
+                    sizeof(uint16_t) + id.size() + // id
+                    2 * sizeof(int32_t) + // metadata (flags and column count)
+                    sizeof(uint16_t) + keyspace.size() + // global table spec
+                    sizeof(uint16_t) + table.size() +
+                    2 * sizeof(int32_t)); // result metadata
+  size_t pos = body.encode_int32(0, CASS_RESULT_KIND_PREPARED);
+  pos = body.encode_string(pos, id.data(), id.size());
+  pos = body.encode_int32(pos, CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  pos = body.encode_int32(pos, 0);
+  pos = body.encode_string(pos, keyspace.data(), keyspace.size());
+  pos = body.encode_string(pos, table.data(), table.size());
+  pos = body.encode_int32(pos, CASS_RESULT_FLAG_NO_METADATA);
+  body.encode_int32(pos, 0);
+
+  cass::ResultResponse* result = new cass::ResultResponse();
+  result->set_buffer(body.size());
+  memcpy(result->data(), body.data(), body.size());
+  BOOST_REQUIRE(result->decode(2, result->data(), body.size()));
+
+  return cass::SharedRefPtr<const cass::Prepared>(
+        new cass::Prepared(result, query, std::vector<std::string>()));
+}
+
+BOOST_AUTO_TEST_SUITE(prepared_cache)
+
+BOOST_AUTO_TEST_CASE(keyspace_and_query)
+{
+  cass::PreparedCache cache;
+  cache.add("ks1", create_prepared("1", "SELECT * FROM t"));
+  cache.add("ks1", create_prepared("2", "SELECT * FROM u"));
+  cache.add("ks2", create_prepared("3", "SELECT * FROM t"));
+
+  cass::SharedRefPtr<const cass::Prepared> prepared(cache.get("ks1", "SELECT * FROM t"));
+  BOOST_REQUIRE(prepared);
+  BOOST_CHECK(prepared->id() == "1");
+
+  prepared = cache.get("ks2", "SELECT * FROM t");
+  BOOST_REQUIRE(prepared);
+  BOOST_CHECK(prepared->id() == "3");
+
+  BOOST_CHECK(!cache.get("", "SELECT * FROM t"));
+  BOOST_CHECK(!cache.get("ks2", "SELECT * FROM u"));
+
+  // Preparing the query again replaces the previous statement
+  cache.add("ks2", create_prepared("4", "SELECT * FROM t"));
+  BOOST_CHECK(cache.get("ks2", "SELECT * FROM t")->id() == "4");
+
+  cass::PreparedCache::QueryVec queries;
+  cache.get_queries("ks1", &queries);
+  BOOST_REQUIRE(queries.size() == 2);
+  BOOST_CHECK(queries[0] == "SELECT * FROM t");
+  BOOST_CHECK(queries[1] == "SELECT * FROM u");
+
+  queries.clear();
+  cache.get_queries("ks", &queries);
+  BOOST_CHECK(queries.empty());
+
+  cache.clear();
+  BOOST_CHECK(!cache.get("ks1", "SELECT * FROM t"));
+}
+
+BOOST_AUTO_TEST_CASE(execution_counts)
+{
+  cass::PreparedCache cache;
+  BOOST_CHECK(!cache.record_execution("ks", "SELECT * FROM t", 3));
+  BOOST_CHECK(!cache.record_execution("ks", "SELECT * FROM t", 3));
+  BOOST_CHECK(!cache.record_execution("", "SELECT * FROM t", 3));
+  BOOST_CHECK(cache.record_execution("ks", "SELECT * FROM t", 3));
+
+  // Counted again from zero
+  BOOST_CHECK(!cache.record_execution("ks", "SELECT * FROM t", 3));
+
+  BOOST_CHECK(cache.record_execution("ks", "SELECT * FROM u", 1));
+}
+
+BOOST_AUTO_TEST_CASE(remove_table)
+{
+  cass::PreparedCache cache;
+  cache.add("ks1", create_prepared("1", "SELECT * FROM t", "ks1", "t"));
+  cache.add("ks1", create_prepared("2", "SELECT * FROM u", "ks1", "u"));
+  cache.add("ks2", create_prepared("3", "SELECT * FROM ks1.t", "ks1", "t"));
+  cache.add("ks2", create_prepared("4", "SELECT * FROM t", "ks2", "t"));
+
+  // By the statement's table, not the keyspace it was prepared with
+  cache.remove_table("ks1", "t");
+  BOOST_CHECK(!cache.get("ks1", "SELECT * FROM t"));
+  BOOST_CHECK(!cache.get("ks2", "SELECT * FROM ks1.t"));
+  BOOST_CHECK(cache.get("ks1", "SELECT * FROM u"));
+  BOOST_CHECK(cache.get("ks2", "SELECT * FROM t"));
+
+  // All of the keyspace's tables
+  cache.remove_table("ks2", std::string());
+  BOOST_CHECK(cache.get("ks1", "SELECT * FROM u"));
+  BOOST_CHECK(!cache.get("ks2", "SELECT * FROM t"));
+}
+
+BOOST_AUTO_TEST_CASE(remove_id)
+{
+  cass::PreparedCache cache;
+  cache.add("ks1", create_prepared("1", "SELECT * FROM t"));
+  cache.add("ks2", create_prepared("1", "SELECT * FROM t"));
+  cache.add("ks1", create_prepared("2", "SELECT * FROM u"));
+
+  cache.remove_id("1");
+  BOOST_CHECK(!cache.get("ks1", "SELECT * FROM t"));
+  BOOST_CHECK(!cache.get("ks2", "SELECT * FROM t"));
+  BOOST_CHECK(cache.get("ks1", "SELECT * FROM u"));
+}
+
+BOOST_AUTO_TEST_CASE(least_recently_used)
+{
+  cass::PreparedCache cache(3);
+  cache.add("ks", create_prepared("1", "SELECT * FROM t1"));
+  cache.add("ks", create_prepared("2", "SELECT * FROM t2"));
+  cache.add("ks", create_prepared("3", "SELECT * FROM t3"));
+
+  // Used, so the second statement is the least recently used
+  BOOST_CHECK(cache.get("ks", "SELECT * FROM t1"));
+
+  cache.add("ks", create_prepared("4", "SELECT * FROM t4"));
+  BOOST_CHECK(cache.size() == 3);
+  BOOST_CHECK(!cache.get("ks", "SELECT * FROM t2"));
+  BOOST_CHECK(cache.get("ks", "SELECT * FROM t1"));
+  BOOST_CHECK(cache.get("ks", "SELECT * FROM t3"));
+  BOOST_CHECK(cache.get("ks", "SELECT * FROM t4"));
+
+  // Replacing a statement doesn't add an entry
+  cache.add("ks", create_prepared("5", "SELECT * FROM t1"));
+  BOOST_CHECK(cache.size() == 3);
+
+  // t1 was replaced after t3 and t4 were used
+  cache.set_max_size(2);
+  BOOST_CHECK(cache.size() == 2);
+  BOOST_CHECK(!cache.get("ks", "SELECT * FROM t3"));
+  BOOST_CHECK(cache.get("ks", "SELECT * FROM t1")->id() == "5");
+
+  cache.remove_id("5");
+  BOOST_CHECK(cache.size() == 1);
+  cache.add("ks", create_prepared("6", "SELECT * FROM t6"));
+  cache.add("ks", create_prepared("7", "SELECT * FROM t7"));
+  BOOST_CHECK(cache.size() == 2);
+  BOOST_CHECK(!cache.get("ks", "SELECT * FROM t4"));
+
+  cache.set_max_size(0);
+  BOOST_CHECK(cache.size() == 0);
+  cache.add("ks", create_prepared("8", "SELECT * FROM t8"));
+  BOOST_CHECK(!cache.get("ks", "SELECT * FROM t8"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "cassandra.h"
+#include "io_worker.hpp"
+#include "pool.hpp"
+#include "spsc_queue.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+// Dequeues all the entries as a string of their names
+std::string dequeue_all(cass::SPSCQueue<char>& high,
+                        cass::SPSCQueue<char>& normal,
+                        unsigned weight) {
+  std::string order;
+  unsigned high_count = 0;
+  char entry;
+  while (cass::dequeue_by_priority(high, normal, weight, &high_count, entry)) {
+    order.push_back(entry);
+  }
+  return order;
+}
+
+void enqueue_all(cass::SPSCQueue<char>& queue, const std::string& entries) {
+  for (size_t i = 0; i < entries.size(); ++i) {
+    BOOST_REQUIRE(queue.enqueue(entries[i]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(request_priority)
+
+BOOST_AUTO_TEST_CASE(weighted_dequeue)
+{
+  cass::SPSCQueue<char> high(64);
+  cass::SPSCQueue<char> normal(64);
+
+  // Up to "weight" high priority entries for each normal priority entry
+  enqueue_all(high, "ABCDEFG");
+  enqueue_all(normal, "abc");
+  BOOST_CHECK_EQUAL(dequeue_all(high, normal, 3), "ABCaDEFbGc");
+
+  // Only one kind of entry
+  enqueue_all(high, "ABCDE");
+  BOOST_CHECK_EQUAL(dequeue_all(high, normal, 2), "ABCDE");
+  enqueue_all(normal, "abc");
+  BOOST_CHECK_EQUAL(dequeue_all(high, normal, 2), "abc");
+
+  // A weight of one alternates
+  enqueue_all(high, "ABC");
+  enqueue_all(normal, "abcde");
+  BOOST_CHECK_EQUAL(dequeue_all(high, normal, 1), "AaBbCcde");
+}
+
+BOOST_AUTO_TEST_CASE(weighted_dequeue_interrupted)
+{
+  cass::SPSCQueue<char> high(64);
+  cass::SPSCQueue<char> normal(64);
+  unsigned high_count = 0;
+  char entry;
+
+  // The count continues across calls so the weight holds when the entries
+  // are dequeued a few at a time
+  enqueue_all(high, "ABCD");
+  enqueue_all(normal, "ab");
+  std::string order;
+  for (int i = 0; i < 3; ++i) {
+    BOOST_REQUIRE(cass::dequeue_by_priority(high, normal, 2, &high_count, entry));
+    order.push_back(entry);
+  }
+  BOOST_CHECK_EQUAL(order, "ABa");
+
+  // Entries that arrive later
+  enqueue_all(high, "EF");
+  while (cass::dequeue_by_priority(high, normal, 2, &high_count, entry)) {
+    order.push_back(entry);
+  }
+  BOOST_CHECK_EQUAL(order, "ABaCDbEF");
+}
+
+BOOST_AUTO_TEST_CASE(reserved_streams)
+{
+  // Nothing reserved
+  BOOST_CHECK(cass::Pool::is_stream_available(1, 0, CASS_REQUEST_PRIORITY_NORMAL));
+  BOOST_CHECK(cass::Pool::is_stream_available(1, 0, CASS_REQUEST_PRIORITY_HIGH));
+
+  // The last 4 streams are only used by high priority requests
+  BOOST_CHECK(cass::Pool::is_stream_available(5, 4, CASS_REQUEST_PRIORITY_NORMAL));
+  BOOST_CHECK(!cass::Pool::is_stream_available(4, 4, CASS_REQUEST_PRIORITY_NORMAL));
+  BOOST_CHECK(!cass::Pool::is_stream_available(1, 4, CASS_REQUEST_PRIORITY_NORMAL));
+  BOOST_CHECK(cass::Pool::is_stream_available(4, 4, CASS_REQUEST_PRIORITY_HIGH));
+  BOOST_CHECK(cass::Pool::is_stream_available(1, 4, CASS_REQUEST_PRIORITY_HIGH));
+}
+
+BOOST_AUTO_TEST_CASE(reserved_streams_limit)
+{
+  CassCluster* cluster = cass_cluster_new();
+
+  BOOST_CHECK(cass_cluster_set_reserved_high_priority_streams(cluster, 0) == CASS_OK);
+  BOOST_CHECK(cass_cluster_set_reserved_high_priority_streams(cluster, 127) == CASS_OK);
+
+  // No streams would be left for normal priority requests
+  BOOST_CHECK(cass_cluster_set_reserved_high_priority_streams(cluster, 128) == CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cass_cluster_set_reserved_high_priority_streams(cluster, 1000) == CASS_ERROR_LIB_BAD_PARAMS);
+
+  cass_cluster_free(cluster);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
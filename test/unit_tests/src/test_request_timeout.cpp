@@ -0,0 +1,67 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "query_request.hpp"
+#include "request_handler.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <uv.h>
+
+BOOST_AUTO_TEST_SUITE(request_timeout)
+
+BOOST_AUTO_TEST_CASE(default_timeout)
+{
+  cass::QueryRequest* query = new cass::QueryRequest("SELECT * FROM t");
+  cass::ScopedRefPtr<cass::RequestHandler> handler(
+        new cass::RequestHandler(query, new cass::ResponseFuture()));
+
+  BOOST_CHECK(!handler->is_expired());
+  BOOST_CHECK(handler->request_timeout_ms(12000) == 12000);
+}
+
+BOOST_AUTO_TEST_CASE(statement_timeout)
+{
+  cass::QueryRequest* query = new cass::QueryRequest("SELECT * FROM t");
+  query->set_request_timeout_ms(60000);
+  cass::ScopedRefPtr<cass::RequestHandler> handler(
+        new cass::RequestHandler(query, new cass::ResponseFuture()));
+
+  // The remaining time is used instead of the cluster's timeout
+  BOOST_CHECK(!handler->is_expired());
+  uint64_t timeout_ms = handler->request_timeout_ms(12000);
+  BOOST_CHECK(timeout_ms > 12000 && timeout_ms <= 60000);
+}
+
+BOOST_AUTO_TEST_CASE(expired)
+{
+  cass::QueryRequest* query = new cass::QueryRequest("SELECT * FROM t");
+  query->set_request_timeout_ms(1);
+  cass::ScopedRefPtr<cass::RequestHandler> handler(
+        new cass::RequestHandler(query, new cass::ResponseFuture()));
+
+  uint64_t start = uv_hrtime();
+  while (uv_hrtime() - start < 2 * 1000 * 1000) {} // 2 ms
+
+  BOOST_CHECK(handler->is_expired());
+  BOOST_CHECK(handler->request_timeout_ms(12000) == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,243 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+#include "types.hpp"
+#include "value.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+// A rows result with a single "int" column named "value"
+cass::Buffer create_rows_body(int32_t flags, int32_t value) {
+  bool has_metadata = !(flags & CASS_RESULT_FLAG_NO_METADATA);
+
+  size_t size = sizeof(int32_t) + // kind
+                sizeof(int32_t) + // flags
+                sizeof(int32_t) + // column count
+                sizeof(int32_t) + // row count
+                sizeof(int32_t) + sizeof(int32_t); // value
+  if (has_metadata) {
+    size += sizeof(uint16_t) + 2 + // keyspace
+            sizeof(uint16_t) + 5 + // table
+            sizeof(uint16_t) + 5 + // column name
+            sizeof(uint16_t); // column type
+  }
+
+  cass::Buffer buf(size);
+  size_t pos = buf.encode_int32(0, CASS_RESULT_KIND_ROWS);
+  pos = buf.encode_int32(pos, flags | CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  pos = buf.encode_int32(pos, 1);
+  if (has_metadata) {
+    pos = buf.encode_string(pos, "ks", 2);
+    pos = buf.encode_string(pos, "table", 5);
+    pos = buf.encode_string(pos, "value", 5);
+    pos = buf.encode_uint16(pos, CASS_VALUE_TYPE_INT);
+  }
+  pos = buf.encode_int32(pos, 1);
+  pos = buf.encode_int32(pos, sizeof(int32_t));
+  buf.encode_int32(pos, value);
+
+  return buf;
+}
+
+void check_first_row(const cass::ResultResponse& result, int32_t expected) {
+  BOOST_REQUIRE(result.row_count() == 1);
+  BOOST_REQUIRE(result.column_count() == 1);
+
+  cass_int32_t value;
+  BOOST_REQUIRE(cass_value_get_int32(CassValue::to(&result.first_row().values[0]),
+                                     &value) == CASS_OK);
+  BOOST_CHECK(value == expected);
+}
+
+bool discard_results(void* data, int8_t stream, uint8_t opcode) {
+  return opcode == CQL_OPCODE_RESULT && stream == *static_cast<int8_t*>(data);
+}
+
+// A version 2 result frame followed by the start of the next frame
+std::string create_result_frame(int8_t stream, const cass::Buffer& body) {
+  cass::Buffer header(8);
+  size_t pos = header.encode_byte(0, 0x82);
+  pos = header.encode_byte(pos, 0);
+  pos = header.encode_byte(pos, stream);
+  pos = header.encode_byte(pos, CQL_OPCODE_RESULT);
+  header.encode_int32(pos, body.size());
+  return std::string(header.data(), header.size()) +
+         std::string(body.data(), body.size()) + std::string(4, 0x02);
+}
+
+cass::Buffer create_set_keyspace_body(const std::string& keyspace) {
+  cass::Buffer buf(sizeof(int32_t) + sizeof(uint16_t) + keyspace.size());
+  size_t pos = buf.encode_int32(0, CASS_RESULT_KIND_SET_KEYSPACE);
+  buf.encode_string(pos, keyspace.data(), keyspace.size());
+  return buf;
+}
+
+BOOST_AUTO_TEST_SUITE(result_response)
+
+BOOST_AUTO_TEST_CASE(rows)
+{
+  cass::Buffer body(create_rows_body(0, 42));
+
+  cass::ResultResponse result;
+  BOOST_REQUIRE(result.decode(2, body.data(), body.size()));
+  BOOST_CHECK(!result.no_metadata());
+  BOOST_CHECK(result.row_count() == 1);
+
+  result.decode_first_row();
+  check_first_row(result, 42);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_rows)
+{
+  cass::Buffer body(create_rows_body(0, 42));
+
+  cass::ResultResponse result(true);
+  BOOST_REQUIRE(result.decode(2, body.data(), body.size()));
+
+  // Nothing past the flags is decoded until the rows are consumed
+  BOOST_CHECK(!result.no_metadata());
+  BOOST_CHECK(result.row_count() == 0);
+  BOOST_CHECK(!result.metadata());
+
+  result.decode_first_row();
+  BOOST_CHECK(!result.no_metadata());
+  check_first_row(result, 42);
+}
+
+BOOST_AUTO_TEST_CASE(deferred_rows_no_metadata)
+{
+  cass::Buffer body(create_rows_body(CASS_RESULT_FLAG_NO_METADATA, 42));
+
+  cass::ResultResponse result(true);
+  BOOST_REQUIRE(result.decode(2, body.data(), body.size()));
+
+  // Results without metadata are decoded right away so that the
+  // metadata from the prepared statement can be used.
+  BOOST_CHECK(result.no_metadata());
+  BOOST_CHECK(result.row_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(shared_metadata)
+{
+  cass::SharedRefPtr<cass::ResultMetadata> metadata;
+
+  {
+    cass::ResultResponse* result = new cass::ResultResponse();
+    cass::Buffer body(create_rows_body(0, 1));
+    // The response owns a copy of the body like a response read from a connection
+    result->set_buffer(body.size());
+    memcpy(result->data(), body.data(), body.size());
+    BOOST_REQUIRE(result->decode(2, result->data(), body.size()));
+    metadata.reset(result->metadata().get());
+    // The metadata doesn't point into the response's buffer
+    memset(result->data(), 0, body.size());
+    delete result;
+  }
+
+  // The metadata has its own copy of the column specs
+  BOOST_REQUIRE(metadata->column_count() == 1);
+  const cass::ColumnDefinition& def = metadata->get(0);
+  BOOST_CHECK(std::string(def.name, def.name_size) == "value");
+
+  cass::Buffer body(create_rows_body(CASS_RESULT_FLAG_NO_METADATA, 2));
+  cass::ResultResponse result;
+  BOOST_REQUIRE(result.decode(2, body.data(), body.size()));
+  BOOST_REQUIRE(result.no_metadata());
+
+  result.set_metadata(metadata.get());
+  result.decode_first_row();
+  check_first_row(result, 2);
+}
+
+BOOST_AUTO_TEST_CASE(discarded_body)
+{
+  int8_t discarded_stream = 1;
+  std::string frame(create_result_frame(1, create_rows_body(0, 42)));
+
+  // Feed the frame in small chunks to cover partial headers and bodies
+  cass::ResponseMessage message(false, discard_results, &discarded_stream);
+  size_t pos = 0;
+  while (!message.is_body_ready()) {
+    size_t size = std::min(static_cast<size_t>(7), frame.size() - pos);
+    int consumed = message.decode(2, &frame[pos], size);
+    BOOST_REQUIRE(consumed > 0);
+    pos += consumed;
+  }
+
+  // Only the result frame is consumed
+  BOOST_CHECK(pos == frame.size() - 4);
+  BOOST_CHECK(message.is_body_discarded());
+  BOOST_CHECK(!message.response_body());
+
+  discarded_stream = 2;
+  cass::ResponseMessage other(false, discard_results, &discarded_stream);
+  BOOST_REQUIRE(other.decode(2, &frame[0], frame.size()) ==
+                static_cast<int>(frame.size() - 4));
+  BOOST_REQUIRE(other.is_body_ready());
+  BOOST_CHECK(!other.is_body_discarded());
+  cass::ResultResponse* result = static_cast<cass::ResultResponse*>(other.response_body().get());
+  result->decode_first_row();
+  check_first_row(*result, 42);
+}
+
+// Only "rows" and "void" results are skipped. Results with side effects
+// (e.g. "set keyspace") are decoded even if the filter discards the body.
+BOOST_AUTO_TEST_CASE(discarded_body_result_kind)
+{
+  int8_t discarded_stream = 1;
+
+  cass::Buffer void_body(sizeof(int32_t));
+  void_body.encode_int32(0, CASS_RESULT_KIND_VOID);
+  std::string void_frame(create_result_frame(1, void_body));
+  std::string keyspace_frame(create_result_frame(1, create_set_keyspace_body("ks")));
+
+  // Every chunk size splits the result kind differently
+  for (size_t chunk = 1; chunk <= 8; ++chunk) {
+    cass::ResponseMessage void_message(false, discard_results, &discarded_stream);
+    cass::ResponseMessage keyspace_message(false, discard_results, &discarded_stream);
+    cass::ResponseMessage* messages[] = { &void_message, &keyspace_message };
+    std::string* frames[] = { &void_frame, &keyspace_frame };
+
+    for (size_t i = 0; i < 2; ++i) {
+      size_t pos = 0;
+      while (!messages[i]->is_body_ready()) {
+        size_t size = std::min(chunk, frames[i]->size() - pos);
+        int consumed = messages[i]->decode(2, &(*frames[i])[pos], size);
+        BOOST_REQUIRE(consumed > 0);
+        pos += consumed;
+      }
+      BOOST_CHECK(pos == frames[i]->size() - 4);
+    }
+
+    BOOST_CHECK(void_message.is_body_discarded());
+
+    BOOST_REQUIRE(!keyspace_message.is_body_discarded());
+    cass::ResultResponse* result =
+        static_cast<cass::ResultResponse*>(keyspace_message.response_body().get());
+    BOOST_CHECK(result->kind() == CASS_RESULT_KIND_SET_KEYSPACE);
+    BOOST_CHECK(result->keyspace() == "ks");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "config.hpp"
+#include "metrics.hpp"
+#include "slow_request_log.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string.h>
+
+void count_slow_request(const CassSlowRequest* request, void* data) {
+  (*static_cast<int*>(data))++;
+}
+
+BOOST_AUTO_TEST_SUITE(slow_request_log)
+
+BOOST_AUTO_TEST_CASE(threshold)
+{
+  cass::Config config;
+  config.set_slow_request_threshold_ms(5);
+  cass::Metrics metrics(1);
+  cass::SlowRequestLog log(config, &metrics);
+
+  BOOST_CHECK(!log.is_slow(4999999));
+  BOOST_CHECK(log.is_slow(5000000));
+}
+
+BOOST_AUTO_TEST_CASE(sampling)
+{
+  cass::Config config;
+  config.set_slow_request_threshold_ms(1);
+  config.set_slow_request_sampling(4, 0);
+  cass::Metrics metrics(1);
+  cass::SlowRequestLog log(config, &metrics);
+
+  int reported = 0;
+  for (int i = 0; i < 10; ++i) {
+    if (log.is_reported()) reported++;
+  }
+
+  // The 1st, 5th and 9th slow requests
+  BOOST_CHECK_EQUAL(reported, 3);
+  BOOST_CHECK_EQUAL(metrics.slow_requests.sum(), 10);
+  BOOST_CHECK_EQUAL(metrics.suppressed_slow_requests.sum(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+  cass::Config config;
+  config.set_slow_request_threshold_ms(1);
+  config.set_slow_request_sampling(1, 3);
+  cass::Metrics metrics(1);
+  cass::SlowRequestLog log(config, &metrics);
+
+  // A second can pass during the loop so up to twice the limit is reported
+  int reported = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (log.is_reported()) reported++;
+  }
+
+  BOOST_CHECK(reported >= 3 && reported <= 6);
+  BOOST_CHECK_EQUAL(metrics.suppressed_slow_requests.sum(), 100 - reported);
+}
+
+BOOST_AUTO_TEST_CASE(callback)
+{
+  int count = 0;
+  cass::Config config;
+  config.set_slow_request_threshold_ms(1);
+  config.set_slow_request_callback(count_slow_request, &count);
+  cass::Metrics metrics(1);
+  cass::SlowRequestLog log(config, &metrics);
+
+  CassSlowRequest request;
+  memset(&request, 0, sizeof(request));
+  log.report(request);
+
+  BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,276 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifdef STAND_ALONE
+#   define BOOST_TEST_MODULE cassandra
+#endif
+
+#include "buffer_collection.hpp"
+#include "query_request.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+// Concatenates the encoded values
+std::string encode_values(const cass::Statement& statement, size_t* buffer_count = NULL) {
+  cass::BufferVec bufs;
+  int32_t size = statement.encode_values(2, &bufs);
+  std::string result;
+  for (cass::BufferVec::const_iterator it = bufs.begin(); it != bufs.end(); ++it) {
+    result.append(it->data(), it->size());
+  }
+  BOOST_CHECK(static_cast<size_t>(size) == result.size());
+  if (buffer_count != NULL) *buffer_count = bufs.size();
+  return result;
+}
+
+std::string encode_int32_value(int32_t value) {
+  char buf[8];
+  cass::encode_int32(buf, sizeof(int32_t));
+  cass::encode_int32(buf + 4, value);
+  return std::string(buf, sizeof(buf));
+}
+
+std::string encode_text_value(const std::string& value) {
+  char buf[4];
+  cass::encode_int32(buf, value.size());
+  return std::string(buf, sizeof(buf)) + value;
+}
+
+const std::string null_value("\xFF\xFF\xFF\xFF", 4);
+
+BOOST_AUTO_TEST_SUITE(statement)
+
+BOOST_AUTO_TEST_CASE(bound_in_order)
+{
+  cass::QueryRequest query(3);
+  query.bind(0, static_cast<int32_t>(1));
+  query.bind(1, "abc", 3);
+  query.bind(2, static_cast<int32_t>(2));
+
+  size_t buffer_count;
+  BOOST_CHECK(encode_values(query, &buffer_count) ==
+              encode_int32_value(1) + encode_text_value("abc") + encode_int32_value(2));
+  BOOST_CHECK(buffer_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(bound_out_of_order)
+{
+  cass::QueryRequest query(4);
+  query.bind(2, static_cast<int32_t>(2));
+  query.bind(0, "abc", 3);
+  query.bind(0, "abcdef", 6); // Different size
+  query.bind(2, static_cast<int32_t>(3)); // Same size
+
+  BOOST_CHECK(encode_values(query) ==
+              encode_text_value("abcdef") + null_value +
+              encode_int32_value(3) + null_value);
+}
+
+BOOST_AUTO_TEST_CASE(collection)
+{
+  cass::QueryRequest query(3);
+  cass::BufferCollection* collection = new cass::BufferCollection(false, 1);
+  collection->inc_ref();
+  collection->append_int32(42);
+
+  query.bind(0, static_cast<int32_t>(1));
+  query.bind(1, collection);
+  query.bind(2, cass::CassNull());
+  collection->dec_ref();
+
+  size_t buffer_count;
+  std::string values(encode_values(query, &buffer_count));
+  BOOST_CHECK(values.substr(0, 8) == encode_int32_value(1));
+  BOOST_CHECK(values.substr(values.size() - 4) == null_value);
+  BOOST_CHECK(buffer_count > 2);
+}
+
+BOOST_AUTO_TEST_CASE(collection_encoding)
+{
+  cass::BufferCollection* collection = new cass::BufferCollection(true, 4);
+  collection->inc_ref();
+  collection->append("a", 1);
+  collection->append_int32(1);
+  collection->append("", 0);
+  collection->append_int32(2);
+
+  // The items are encoded as they're appended
+  const std::string items("\x00\x01" "a" "\x00\x04" "\x00\x00\x00\x01"
+                          "\x00\x00" "\x00\x04" "\x00\x00\x00\x02", 17);
+  BOOST_CHECK(collection->item_count() == 4);
+  BOOST_CHECK(collection->calculate_size(2) == static_cast<int>(items.size()));
+
+  cass::QueryRequest query(1);
+  query.bind(0, collection);
+  collection->dec_ref();
+
+  // [bytes] containing the number of map entries and the items
+  BOOST_CHECK(encode_values(query) ==
+              encode_text_value(std::string("\x00\x02", 2) + items));
+}
+
+BOOST_AUTO_TEST_CASE(reset)
+{
+  cass::QueryRequest query(2);
+  query.bind(0, static_cast<int32_t>(1));
+  query.bind(1, static_cast<int32_t>(2));
+  query.add_key_index(0);
+
+  query.reset_values();
+  BOOST_CHECK(encode_values(query) == null_value + null_value);
+
+  std::string routing_key;
+  BOOST_CHECK(!query.get_routing_key(&routing_key));
+
+  query.bind(1, static_cast<int32_t>(4));
+  query.bind(0, static_cast<int32_t>(3));
+  BOOST_CHECK(encode_values(query) == encode_int32_value(3) + encode_int32_value(4));
+
+  BOOST_REQUIRE(query.get_routing_key(&routing_key));
+  BOOST_CHECK(routing_key == encode_int32_value(3).substr(4));
+}
+
+BOOST_AUTO_TEST_CASE(copy_values_and_settings)
+{
+  cass::QueryRequest query(2);
+  query.bind(0, static_cast<int32_t>(1));
+  query.bind(1, "abc", 3);
+  query.set_consistency(CASS_CONSISTENCY_QUORUM);
+  query.set_page_size(100);
+  query.set_request_timeout_ms(500);
+  query.set_priority(CASS_REQUEST_PRIORITY_HIGH);
+  query.add_key_index(0);
+
+  cass::QueryRequest copy(2);
+  copy.copy_values_and_settings(query);
+  BOOST_CHECK(encode_values(copy) == encode_int32_value(1) + encode_text_value("abc"));
+  BOOST_CHECK(copy.consistency() == CASS_CONSISTENCY_QUORUM);
+  BOOST_CHECK(copy.page_size() == 100);
+  BOOST_CHECK(copy.request_timeout_ms() == 500);
+  BOOST_CHECK(copy.priority() == CASS_REQUEST_PRIORITY_HIGH);
+
+  std::string routing_key;
+  BOOST_REQUIRE(copy.get_routing_key(&routing_key));
+  BOOST_CHECK(routing_key == encode_int32_value(1).substr(4));
+
+  // The copy doesn't share the original's values
+  query.bind(0, static_cast<int32_t>(2));
+  BOOST_CHECK(encode_values(copy) == encode_int32_value(1) + encode_text_value("abc"));
+}
+
+void on_release(void* data) {
+  ++*static_cast<int*>(data);
+}
+
+BOOST_AUTO_TEST_CASE(external_value)
+{
+  std::string value(1024, 'a');
+  int release_count = 0;
+
+  {
+    cass::BufferVec bufs;
+    {
+      cass::QueryRequest query(2);
+      query.bind(0, static_cast<int32_t>(1));
+      query.bind(1, new cass::ExternalBuffer(value.data(), value.size(),
+                                             on_release, &release_count));
+      query.encode_values(2, &bufs);
+
+      // The value's memory is referenced instead of copied
+      const cass::BufferVec& encoded = bufs;
+      BOOST_REQUIRE(encoded.size() == 3);
+      BOOST_CHECK(encoded[2].data() == value.data());
+      BOOST_CHECK(encode_values(query) == encode_int32_value(1) + encode_text_value(value));
+    }
+
+    // Still referenced by the encoded buffers
+    BOOST_CHECK(release_count == 0);
+  }
+
+  BOOST_CHECK(release_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(external_value_empty)
+{
+  int release_count = 0;
+  {
+    cass::QueryRequest query(2);
+    query.bind(0, new cass::ExternalBuffer("", 0, on_release, &release_count));
+    query.bind(1, static_cast<int32_t>(1));
+
+    // The empty value is encoded inline, only its size is written
+    cass::BufferVec bufs;
+    query.encode_values(2, &bufs);
+    for (cass::BufferVec::const_iterator it = bufs.begin(); it != bufs.end(); ++it) {
+      BOOST_CHECK(it->size() > 0);
+    }
+    BOOST_CHECK(encode_values(query) == encode_text_value("") + encode_int32_value(1));
+  }
+  BOOST_CHECK(release_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(external_value_too_large)
+{
+  CassStatement* statement = cass_statement_new("INSERT INTO t (k) VALUES (?)", 1);
+  int release_count = 0;
+
+  // The value isn't read so its size can be larger than the memory
+  const char* value = "a";
+  BOOST_CHECK(cass_statement_bind_string_no_copy(statement, 0, value,
+                                                 static_cast<size_t>(std::numeric_limits<int32_t>::max()) + 1,
+                                                 on_release, &release_count) == CASS_ERROR_LIB_BAD_PARAMS);
+  BOOST_CHECK(cass_statement_bind_string_no_copy(statement, 0, value, 1,
+                                                 on_release, &release_count) == CASS_OK);
+
+  cass_statement_free(statement);
+  BOOST_CHECK(release_count == 1);
+}
+
+BOOST_AUTO_TEST_CASE(rebind_varying_sizes)
+{
+  cass::QueryRequest query(3);
+  query.bind(0, static_cast<int32_t>(1));
+  query.bind(2, static_cast<int32_t>(2));
+
+  std::string text;
+  size_t max_size = 0;
+  for (int i = 0; i < 1000; ++i) {
+    // Sizes go up and down so that the regions are both reused and abandoned
+    text.assign((i * 7919) % 512, 'a' + i % 26);
+    query.bind(1, text.data(), text.size());
+    BOOST_REQUIRE(encode_values(query) ==
+                  encode_int32_value(1) + encode_text_value(text) + encode_int32_value(2));
+    max_size = std::max(max_size, query.arena_size());
+  }
+
+  // Two int32 values and a text value of at most 511 bytes, with less than
+  // half of the arena abandoned
+  BOOST_CHECK(max_size <= 2 * (3 * sizeof(int32_t) + 2 * sizeof(int32_t) + 511));
+
+  // The value is overwritten in place when it fits in its region
+  query.bind(1, "abc", 3);
+  size_t arena_size = query.arena_size();
+  query.bind(1, "ab", 2);
+  BOOST_CHECK(query.arena_size() == arena_size);
+  BOOST_CHECK(encode_values(query) ==
+              encode_int32_value(1) + encode_text_value("ab") + encode_int32_value(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -265,4 +265,35 @@ BOOST_AUTO_TEST_CASE(drop_keyspace)
 
 
 
+BOOST_AUTO_TEST_CASE(int64_token)
+{
+  int64_t token;
+
+  {
+    // The partitioner isn't known yet
+    cass::TokenMap token_map;
+    BOOST_CHECK(!token_map.get_int64_token("abc", &token));
+  }
+
+  {
+    cass::TokenMap token_map;
+    token_map.set_partitioner(cass::Murmur3Partitioner::PARTITIONER_CLASS);
+    BOOST_REQUIRE(token_map.get_int64_token("abc", &token));
+    BOOST_CHECK(token == murmur3_hash("abc"));
+  }
+
+  // Their tokens don't fit in 64 bits
+  {
+    cass::TokenMap token_map;
+    token_map.set_partitioner(cass::RandomPartitioner::PARTITIONER_CLASS);
+    BOOST_CHECK(!token_map.get_int64_token("abc", &token));
+  }
+
+  {
+    cass::TokenMap token_map;
+    token_map.set_partitioner(cass::ByteOrderedPartitioner::PARTITIONER_CLASS);
+    BOOST_CHECK(!token_map.get_int64_token("abc", &token));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()